@@ -9,10 +9,27 @@
 
 #include "OutlineDrawPass.h"
 #include "OutlineMaskPass.h"
+#include "ConstantBufferEx.h"
+#include "BindableCodex.h"
+#include "FrameCapture.h"
+#include "Profiler.h"
 
 #include <memory>
 #include <algorithm>
 
+namespace
+{
+	// shown beside a model's checkbox while it streams in
+	void ShowLoadProgress( const Model& model )
+	{
+		if ( !model.IsReady() )
+		{
+			ImGui::SameLine();
+			ImGui::ProgressBar( model.GetLoadProgress(), { 120.0f, 0.0f } );
+		}
+	}
+}
+
 App::App( const std::string& commandLine ) :
 	wnd( 1920, 1080, "DirectX 11 Engine Window" ),
 	light( wnd.Gfx(), { 10.0f, 5.0f, 2.0f } ),
@@ -28,26 +45,10 @@ App::App( const std::string& commandLine ) :
 	
 	cube.SetPos( { 10.0f, 5.0f, 6.0f } );
 	cube2.SetPos( { 10.0f, 5.0f, 14.0f } );
-	nanosuit.SetRootTransform(
-		DirectX::XMMatrixRotationY( PI / 2.0f ) *
-		DirectX::XMMatrixTranslation( 27.0f, -0.56f, 1.7f )
-	);
-	goblin.SetRootTransform(
-		DirectX::XMMatrixRotationY( -PI / 2.0f ) *
-		DirectX::XMMatrixTranslation( -8.0f, 10.0f, 0.0f )
-	);
-	backpack.SetRootTransform(
-		DirectX::XMMatrixRotationY( PI / 1.0f ) *
-		DirectX::XMMatrixTranslation( 10.0f, 5.0f, -8.0f )
-	);
-
 	cube.LinkTechniques( rg );
 	cube2.LinkTechniques( rg );
 	light.LinkTechniques( rg );
-	sponza.LinkTechniques( rg );
-	nanosuit.LinkTechniques( rg );
-	goblin.LinkTechniques( rg );
-	backpack.LinkTechniques( rg );
+	pSponza->LinkTechniques( rg );
 	cameras.LinkTechniques( rg );
 	
 	light1.LinkTechniques( rg );
@@ -56,6 +57,7 @@ App::App( const std::string& commandLine ) :
 	light4.LinkTechniques( rg );
 
 	rg.BindShadowCamera( *light.ShareCamera() );
+	rg.BindLight( light );
 }
 
 int App::Init()
@@ -67,8 +69,12 @@ int App::Init()
 			return *ecode;
 
 		const auto dt = timer.Mark();
-		HandleInput( dt );
-		DoFrame( dt );
+		{
+			PROFILE_SCOPE( "Frame" );
+			HandleInput( dt );
+			DoFrame( dt );
+		}
+		Profiler::EndFrame();
 	}
 }
 
@@ -108,6 +114,9 @@ void App::HandleInput( float dt )
 		case VK_NUMPAD1:
 			saveDepth = true;
 			break;
+		case VK_NUMPAD2:
+			capturePending = true;
+			break;
 		}
 	}
 
@@ -139,33 +148,56 @@ void App::HandleInput( float dt )
 void App::DoFrame( float dt )
 {
 	// setup
+	// models turned off last frame are released here, after every job pointing at them was dropped
+	SyncModel( pNanosuit, loadNanosuit, "res\\models\\nanosuit\\nanosuit.obj", 2.0f,
+		DirectX::XMMatrixRotationY( PI / 2.0f ) * DirectX::XMMatrixTranslation( 27.0f, -0.56f, 1.7f ) );
+	SyncModel( pGoblin, loadGoblin, "res\\models\\goblin\\GoblinX.obj", 4.0f,
+		DirectX::XMMatrixRotationY( -PI / 2.0f ) * DirectX::XMMatrixTranslation( -8.0f, 10.0f, 0.0f ) );
+	SyncModel( pBackpack, loadBackpack, "res\\models\\backpack\\backpack.obj", 4.0f,
+		DirectX::XMMatrixRotationY( PI / 1.0f ) * DirectX::XMMatrixTranslation( 10.0f, 5.0f, -8.0f ) );
+	// models whose loads finished since the last frame create their gpu resources here, ahead of any capture
+	for ( auto pModel : { pSponza.get(), pNanosuit.get(), pGoblin.get(), pBackpack.get() } )
+	{
+		if ( pModel )
+		{
+			pModel->Poll( wnd.Gfx() );
+		}
+	}
+	// the log has to be on before the frame begins, so a capture asked for during the last frame starts here
+	captureFrame = capturePending;
+	capturePending = false;
+	if ( captureFrame )
+	{
+		wnd.Gfx().EnableCommandLog();
+	}
 	wnd.Gfx().BeginFrame( 0.07f, 0.0f, 0.12f );
-	light.Bind( wnd.Gfx(), cameras->GetMatrix() );
 	rg.BindMainCamera( cameras.GetActiveCamera() );
+	// recorded passes start out from this view - the outline and wireframe passes draw with it as is
+	cameras.GetActiveCamera().BindToGraphics( wnd.Gfx() );
 
-	// objects
-	light.Submit( Channel::main );
-	sponza.Submit( Channel::main );
-	cameras.Submit( Channel::main );
-	if ( loadLight1 )	light1.Submit( Channel::main );
-	if ( loadLight2 )	light2.Submit( Channel::main );
-	if ( loadLight3 )	light3.Submit( Channel::main );
-	if ( loadLight4 )	light4.Submit( Channel::main );
-	if ( loadNanosuit ) nanosuit.Submit( Channel::main );
-	if ( loadGoblin )	goblin.Submit( Channel::main );
-	if ( loadBackpack ) backpack.Submit( Channel::main );
-	if ( loadCube1 )	cube.Submit( Channel::main );
-	if ( loadCube2 )	cube2.Submit( Channel::main );
-
-	light.Submit( Channel::shadow );
-	sponza.Submit( Channel::shadow );
-	if ( loadNanosuit ) nanosuit.Submit( Channel::shadow );
-	if ( loadGoblin )	goblin.Submit( Channel::shadow );
-	if ( loadBackpack ) backpack.Submit( Channel::shadow );
-	if ( loadCube1 )	cube.Submit( Channel::shadow );
-	if ( loadCube2 )	cube2.Submit( Channel::shadow );
-
-	rg.Execute( wnd.Gfx() );
+	// objects - traversals run in parallel, so each submits every channel of its own drawables at once
+	// queues receive the jobs in the order the traversals are added here
+	const Timer submitTimer;
+	{
+		PROFILE_SCOPE( "Submit" );
+		constexpr auto allChannels = Channel::main | Channel::shadow;
+		submitter.Add( [this] { light.Submit( allChannels ); } );
+		pSponza->Submit( allChannels, submitter );
+		submitter.Add( [this] { cameras.Submit( Channel::main ); } );
+		if ( loadLight1 )	submitter.Add( [this] { light1.Submit( Channel::main ); } );
+		if ( loadLight2 )	submitter.Add( [this] { light2.Submit( Channel::main ); } );
+		if ( loadLight3 )	submitter.Add( [this] { light3.Submit( Channel::main ); } );
+		if ( loadLight4 )	submitter.Add( [this] { light4.Submit( Channel::main ); } );
+		if ( pNanosuit )	pNanosuit->Submit( allChannels, submitter );
+		if ( pGoblin )		pGoblin->Submit( allChannels, submitter );
+		if ( pBackpack )	pBackpack->Submit( allChannels, submitter );
+		if ( loadCube1 )	submitter.Add( [this] { cube.Submit( allChannels ); } );
+		if ( loadCube2 )	submitter.Add( [this] { cube2.Submit( allChannels ); } );
+		submitter.Flush();
+	}
+	submitTime = submitTimer.Peek();
+
+	rg.Execute( wnd.Gfx(), threadPool );
 
 	if ( saveDepth )
 	{
@@ -189,16 +221,21 @@ void App::DoFrame( float dt )
 				ImGui::PushStyleColor(ImGuiCol_Text, { 1.0f, 1.0f, 1.0f, 1.0f });
 
 				ImGui::Checkbox( "Sponza", &loadSponza );
-				if ( loadSponza ) sponzaProbe.SpawnWindow( sponza, "Sponza" );
+				ShowLoadProgress( *pSponza );
+				if ( loadSponza && pSponza->IsReady() ) sponzaProbe.SpawnWindow( *pSponza, "Sponza" );
 
-				ImGui::Checkbox( "Nanosuit", &loadNanosuit );
-				if ( loadNanosuit ) nanosuitProbe.SpawnWindow( nanosuit, "Nanosuit" );
+				// a probe must not keep the selected node of a model that is about to be released
+				if ( ImGui::Checkbox( "Nanosuit", &loadNanosuit ) && !loadNanosuit ) nanosuitProbe = {};
+				if ( pNanosuit ) ShowLoadProgress( *pNanosuit );
+				if ( loadNanosuit && pNanosuit && pNanosuit->IsReady() ) nanosuitProbe.SpawnWindow( *pNanosuit, "Nanosuit" );
 
-				ImGui::Checkbox( "Goblin", &loadGoblin );
-				if ( loadGoblin ) goblinProbe.SpawnWindow( goblin, "Goblin" );
+				if ( ImGui::Checkbox( "Goblin", &loadGoblin ) && !loadGoblin ) goblinProbe = {};
+				if ( pGoblin ) ShowLoadProgress( *pGoblin );
+				if ( loadGoblin && pGoblin && pGoblin->IsReady() ) goblinProbe.SpawnWindow( *pGoblin, "Goblin" );
 
-				ImGui::Checkbox( "Backpack", &loadBackpack );
-				if ( loadBackpack ) backpackProbe.SpawnWindow( backpack, "Backpack" );
+				if ( ImGui::Checkbox( "Backpack", &loadBackpack ) && !loadBackpack ) backpackProbe = {};
+				if ( pBackpack ) ShowLoadProgress( *pBackpack );
+				if ( loadBackpack && pBackpack && pBackpack->IsReady() ) backpackProbe.SpawnWindow( *pBackpack, "Backpack" );
 
 				ImGui::PopStyleColor();
 				ImGui::TreePop();
@@ -260,6 +297,12 @@ void App::DoFrame( float dt )
 				ImGui::Checkbox( "Raw Input", &loadRaw );
 				if ( loadRaw ) ShowRawInputWindow();
 
+				ImGui::Checkbox( "Statistics", &loadStats );
+				if ( loadStats ) ShowStatisticsWindow();
+
+				ImGui::Checkbox( "Profiler", &loadProfiler );
+				if ( loadProfiler ) Profiler::ShowWindow();
+
 				ImGui::PopStyleColor();
 				ImGui::TreePop();
 			}
@@ -269,7 +312,36 @@ void App::DoFrame( float dt )
 	}
 	
 	wnd.Gfx().EndFrame();
+	if ( captureFrame )
+	{
+		if ( const auto pLog = wnd.Gfx().GetLog() )
+		{
+			FrameCapture{ wnd.Gfx(), *pLog }.Save( "res\\captures\\frame.capture" );
+		}
+		wnd.Gfx().DisableCommandLog();
+		captureFrame = false;
+	}
 	rg.Reset();
+	Bind::ConstantBufferEx::ResetStatistics();
+	Rgph::RenderQueuePass::ResetStatistics();
+	Bind::Codex::Trim();
+}
+
+void App::SyncModel( std::unique_ptr<Model>& pModel, bool load, const std::string& path, float scale, DirectX::FXMMATRIX rootTransform )
+{
+	if ( load == ( pModel != nullptr ) )
+	{
+		return;
+	}
+	if ( !load )
+	{
+		// waits out a load still under way - bindables no other model shares leave the codex at the next trim
+		pModel.reset();
+		return;
+	}
+	pModel = Model::LoadAsync( path, scale, loaderPool );
+	pModel->SetRootTransform( rootTransform );
+	pModel->LinkTechniques( rg );
 }
 
 void App::ShowRawInputWindow()
@@ -285,4 +357,51 @@ void App::ShowRawInputWindow()
 		ImGui::Text( "Cursor: %s", wnd.CursorEnabled() ? "Enabled" : "Disabled" );
 	}
 	ImGui::End();
+}
+
+void App::ShowStatisticsWindow()
+{
+	if ( ImGui::Begin( "Statistics" ) )
+	{
+		const auto& cbuf = Bind::ConstantBufferEx::GetStatistics();
+		ImGui::TextColored( { 0.4f, 1.0f, 0.6f, 1.0f }, "Constant Buffers" );
+		ImGui::Text( "Uploads: %zu (%zu bytes, %zu dirty)", cbuf.uploads, cbuf.bytesUploaded, cbuf.bytesDirty );
+		ImGui::Text( "Skipped: %zu (%zu bytes)", cbuf.skips, cbuf.bytesSkipped );
+
+		const auto codex = Bind::Codex::GetStatistics();
+		ImGui::TextColored( { 0.4f, 1.0f, 0.6f, 1.0f }, "Bindable Codex" );
+		ImGui::Text( "Entries: %zu (%zu unreferenced)", codex.entries, codex.unreferenced );
+		ImGui::Text( "Resident: %.1f MB (%.1f MB unreferenced)", codex.bytesResident / 1048576.0f, codex.bytesUnreferenced / 1048576.0f );
+		ImGui::Text( "Hits: %zu  Misses: %zu", codex.hits, codex.misses );
+		ImGui::Text( "Evictions: %zu (%.1f MB)", codex.evictions, codex.bytesEvicted / 1048576.0f );
+		int budgetMB = int( codex.budget / 1048576u );
+		if ( ImGui::SliderInt( "Budget (MB)", &budgetMB, 16, 2048 ) )
+		{
+			Bind::Codex::SetBudget( size_t( budgetMB ) * 1048576u );
+		}
+
+		const auto& queue = Rgph::RenderQueuePass::GetStatistics();
+		ImGui::TextColored( { 0.4f, 1.0f, 0.6f, 1.0f }, "Render Queues" );
+		ImGui::Checkbox( "Parallel Submit", &Rgph::ParallelSubmitter::Enabled() );
+		ImGui::Text( "Submit: %.3f ms (%zu workers)", submitTime * 1000.0f, threadPool.GetWorkerCount() );
+		ImGui::Checkbox( "Sort Jobs", &Rgph::RenderQueuePass::SortingEnabled() );
+		ImGui::Checkbox( "Instancing", &Rgph::RenderQueuePass::InstancingEnabled() );
+		ImGui::Text( "Jobs: %zu  Draws: %zu", queue.jobs, queue.draws );
+		ImGui::Text( "Instanced: %zu jobs in %zu draws", queue.instances, queue.instancedDraws );
+		ImGui::Text( "Step binds: %zu (%zu redundant)", queue.stepBinds, queue.redundantBinds );
+
+		const auto& binds = wnd.Gfx().GetBindStatistics();
+		ImGui::TextColored( { 0.4f, 1.0f, 0.6f, 1.0f }, "Pipeline State" );
+		ImGui::Text( "Binds issued: %zu  Skipped: %zu", binds.issued, binds.skipped );
+
+		ImGui::TextColored( { 0.4f, 1.0f, 0.6f, 1.0f }, "Render Graph" );
+		ImGui::Checkbox( "Record Passes", &Rgph::RenderGraph::RecordingEnabled() );
+		if ( ImGui::Button( "Capture Frame" ) )
+		{
+			capturePending = true;
+		}
+		ImGui::TextUnformatted( rg.GetFinalizeReport().c_str() );
+		ImGui::TextUnformatted( rg.GetArenaReport().c_str() );
+	}
+	ImGui::End();
 }
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include "NormalCube.h"
 #include "BlurOutlineRG.h"
 #include "ScriptCommander.h"
+#include "ThreadPool.h"
+#include "ParallelSubmitter.h"
 
 class App
 {
@@ -20,6 +22,9 @@ private:
 	void DoFrame( float dt );
 	void HandleInput( float dt );
 	void ShowRawInputWindow();
+	void ShowStatisticsWindow();
+	// streams a switchable model in when it is turned on and releases it when it is turned off
+	void SyncModel( std::unique_ptr<Model>& pModel, bool load, const std::string& path, float scale, DirectX::FXMMATRIX rootTransform );
 private:
 	ImGuiManager imgui;
 	ScriptCommander scriptCommander;
@@ -32,17 +37,27 @@ private:
 	PointLight light3;
 	PointLight light4;
 	Rgph::BlurOutlineRG rg{ wnd.Gfx() };
+	ThreadPool threadPool;
+	Rgph::ParallelSubmitter submitter{ threadPool };
+	// loads run on their own workers, so they never hold up the frame's submit and record waits
+	ThreadPool loaderPool{ std::max( std::thread::hardware_concurrency() / 2u, 1u ) };
 
-	Model sponza{ wnd.Gfx(), "res\\models\\sponza\\sponza.obj", 1.0f / 20.0f };
-	Model nanosuit{ wnd.Gfx(), "res\\models\\nanosuit\\nanosuit.obj", 2.0f };
-	Model goblin{ wnd.Gfx(), "res\\models\\goblin\\GoblinX.obj", 4.0f };
-	Model backpack{ wnd.Gfx(), "res\\models\\backpack\\backpack.obj", 4.0f };
+	// streamed in on the pool - each draws nothing until DoFrame() has polled it ready
+	std::unique_ptr<Model> pSponza = Model::LoadAsync( "res\\models\\sponza\\sponza.obj", 1.0f / 20.0f, loaderPool );
+	// only loaded while turned on in the models window
+	std::unique_ptr<Model> pNanosuit;
+	std::unique_ptr<Model> pGoblin;
+	std::unique_ptr<Model> pBackpack;
 	NormalCube cube{ wnd.Gfx(), 4.0f };
 	NormalCube cube2{ wnd.Gfx(), 4.0f };
 
 	std::string commandLine;
 	int x = 0, y = 0;
+	float submitTime = 0.0f;
 	bool saveDepth = false;
+	// requested at any point of a frame, captured over the whole of the next one
+	bool capturePending = false;
+	bool captureFrame = false;
 
 	bool loadSponza = false;
 	bool loadNanosuit = false;
@@ -62,4 +77,6 @@ private:
 	bool loadShadow = false;
 	bool loadBlur = false;
 	bool loadRaw = false;
+	bool loadStats = false;
+	bool loadProfiler = false;
 };
\ No newline at end of file
@@ -51,7 +51,7 @@ namespace Bind
 			}
 
 			// load model indices
-			std::vector<unsigned short> indices;
+			std::vector<unsigned int> indices;
 			indices.reserve( pMesh->mNumFaces );
 			for ( unsigned int i = 0; i < pMesh->mNumFaces; i++ )
 			{
@@ -0,0 +1,1084 @@
+#include "Benchmark.h"
+#include "DynamicConstant.h"
+#include "LayoutCodex.h"
+#include "Timer.h"
+#include "Math.h"
+#include "Graphics.h"
+#include "CommandLog.h"
+#include "BlurOutlineRG.h"
+#include "ParallelSubmitter.h"
+#include "RenderQueuePass.h"
+#include "ConstantBufferEx.h"
+#include "Camera.h"
+#include "PointLight.h"
+#include "Model.h"
+#include "Channels.h"
+#include "FrameCapture.h"
+#include "ThreadPool.h"
+#include "RenderGraph.h"
+#include "Pass.h"
+#include "Sink.h"
+#include "Source.h"
+#include "RenderTarget.h"
+#include "TransientPlanner.h"
+#include "BindableCodex.h"
+#include "ModelBaker.h"
+#include "Material.h"
+#include "IndexBuffer.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "MeshOptimizer.h"
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+std::string Benchmark::DynamicConstantAccess( size_t iterations )
+{
+	// same layout as the fully featured phong material cbuffer
+	Dcb::RawLayout layout;
+	layout.Add<Dcb::Float3>( "materialColor" );
+	layout.Add<Dcb::Bool>( "useGlossAlpha" );
+	layout.Add<Dcb::Bool>( "useSpecularMap" );
+	layout.Add<Dcb::Float3>( "specularColor" );
+	layout.Add<Dcb::Float>( "specularWeight" );
+	layout.Add<Dcb::Float>( "specularGloss" );
+	layout.Add<Dcb::Bool>( "useNormalMap" );
+	layout.Add<Dcb::Float>( "normalMapWeight" );
+	Dcb::Buffer buf{ std::move( layout ) };
+
+	// read back through the buffer every iteration so the writes cannot be discarded
+	// reads go through the const buffer, the way code that only reads is meant to
+	float checksum = 0.0f;
+	Timer timer;
+
+	// string path
+	timer.Mark();
+	for ( size_t i = 0; i < iterations; i++ )
+	{
+		const auto f = float( i );
+		buf["materialColor"] = DirectX::XMFLOAT3{ f, f, f };
+		buf["useSpecularMap"] = ( i & 1u ) != 0u;
+		buf["specularColor"] = DirectX::XMFLOAT3{ f, f, f };
+		buf["specularWeight"] = f;
+		buf["specularGloss"] = f;
+		buf["normalMapWeight"] = f;
+		checksum += static_cast<const float&>( std::as_const( buf )["specularGloss"] );
+	}
+	const auto stringTime = timer.Mark();
+
+	// handle path
+	const Dcb::FieldHandle<DirectX::XMFLOAT3> materialColor{ buf, "materialColor" };
+	const Dcb::FieldHandle<bool> useSpecularMap{ buf, "useSpecularMap" };
+	const Dcb::FieldHandle<DirectX::XMFLOAT3> specularColor{ buf, "specularColor" };
+	const Dcb::FieldHandle<float> specularWeight{ buf, "specularWeight" };
+	const Dcb::FieldHandle<float> specularGloss{ buf, "specularGloss" };
+	const Dcb::FieldHandle<float> normalMapWeight{ buf, "normalMapWeight" };
+	timer.Mark();
+	for ( size_t i = 0; i < iterations; i++ )
+	{
+		const auto f = float( i );
+		buf[materialColor] = DirectX::XMFLOAT3{ f, f, f };
+		buf[useSpecularMap] = ( i & 1u ) != 0u;
+		buf[specularColor] = DirectX::XMFLOAT3{ f, f, f };
+		buf[specularWeight] = f;
+		buf[specularGloss] = f;
+		buf[normalMapWeight] = f;
+		checksum -= std::as_const( buf )[specularGloss];
+	}
+	const auto handleTime = timer.Mark();
+
+	std::ostringstream oss;
+	oss << "[Dcb Access] " << iterations << " iterations x 7 accesses" << std::endl
+		<< "  string keys:   " << stringTime * 1000.0f << " ms" << std::endl
+		<< "  field handles: " << handleTime * 1000.0f << " ms" << std::endl
+		<< "  speedup:       " << ( handleTime > 0.0f ? stringTime / handleTime : 0.0f ) << "x" << std::endl
+		<< "  checksum:      " << checksum << std::endl;
+	return oss.str();
+}
+
+std::string Benchmark::LayoutCodexStress( size_t threads, size_t layouts )
+{
+	// layouts are generated from a seed so every thread can build its own copy of the same layout
+	// seeds are drawn from a pool smaller than the layout count, forcing threads to race on identical layouts
+	const auto nSeeds = std::max( layouts / 8u, size_t( 1u ) );
+	const auto generate = []( uint32_t seed )
+	{
+		static constexpr Dcb::Type leaves[] = { Dcb::Float, Dcb::Float2, Dcb::Float3, Dcb::Float4, Dcb::Matrix, Dcb::Bool, Dcb::Integer };
+		std::mt19937 rng{ seed };
+		std::uniform_int_distribution<size_t> leafDist{ 0u, std::size( leaves ) - 1u };
+		std::uniform_int_distribution<size_t> countDist{ 1u, 6u };
+		std::uniform_int_distribution<int> kindDist{ 0, 7 };
+		Dcb::RawLayout layout;
+		const auto nMembers = countDist( rng );
+		for ( size_t i = 0; i < nMembers; i++ )
+		{
+			const auto name = "m" + std::to_string( i );
+			switch ( kindDist( rng ) )
+			{
+			case 0:
+				layout.Add<Dcb::Array>( name );
+				layout[name].Set( leaves[leafDist( rng )], countDist( rng ) );
+				break;
+			case 1:
+			{
+				layout.Add<Dcb::Struct>( name );
+				const auto nInner = countDist( rng );
+				for ( size_t j = 0; j < nInner; j++ )
+				{
+					layout[name].Add( leaves[leafDist( rng )], "n" + std::to_string( j ) );
+				}
+				break;
+			}
+			default:
+				layout.Add( leaves[leafDist( rng )], name );
+				break;
+			}
+		}
+		return layout;
+	};
+
+	// every thread records the root it was handed for each resolve
+	std::vector<std::vector<std::pair<uint32_t, const Dcb::LayoutElement*>>> results( threads );
+	std::vector<std::thread> workers;
+	Timer timer;
+	timer.Mark();
+	for ( size_t t = 0; t < threads; t++ )
+	{
+		workers.emplace_back( [&, t]()
+		{
+			std::mt19937 rng{ uint32_t( t ) };
+			std::uniform_int_distribution<uint32_t> seedDist{ 0u, uint32_t( nSeeds - 1u ) };
+			auto& out = results[t];
+			out.reserve( layouts );
+			for ( size_t i = 0; i < layouts; i++ )
+			{
+				const auto seed = seedDist( rng );
+				const auto layout = Dcb::LayoutCodex::Resolve( generate( seed ) );
+				out.emplace_back( seed, layout.ShareRoot().get() );
+			}
+		} );
+	}
+	for ( auto& w : workers )
+	{
+		w.join();
+	}
+	const auto time = timer.Mark();
+
+	// same seed must always give the same root, and a root must only be shared by layouts with the same signature
+	// seeds that happen to generate the same signature must resolve to the same root as well
+	size_t mismatches = 0u;
+	size_t splits = 0u;
+	std::unordered_map<uint32_t, const Dcb::LayoutElement*> rootBySeed;
+	std::unordered_map<const Dcb::LayoutElement*, std::string> signatureByRoot;
+	std::unordered_map<std::string, const Dcb::LayoutElement*> rootBySignature;
+	for ( const auto& out : results )
+	{
+		for ( const auto& [seed, pRoot] : out )
+		{
+			const auto [i, inserted] = rootBySeed.emplace( seed, pRoot );
+			if ( !inserted && i->second != pRoot )
+			{
+				mismatches++;
+			}
+		}
+	}
+	for ( const auto& [seed, pRoot] : rootBySeed )
+	{
+		const auto signature = generate( seed ).GetSignature();
+		const auto [i, inserted] = signatureByRoot.emplace( pRoot, signature );
+		if ( !inserted && i->second != signature )
+		{
+			mismatches++;
+		}
+		const auto [j, added] = rootBySignature.emplace( signature, pRoot );
+		if ( !added && j->second != pRoot )
+		{
+			splits++;
+		}
+	}
+
+	std::ostringstream oss;
+	oss << "[Layout Codex] " << threads << " threads x " << layouts << " resolves, " << rootBySeed.size() << " seeds" << std::endl
+		<< "  time:            " << time * 1000.0f << " ms" << std::endl
+		<< "  distinct roots:  " << signatureByRoot.size() << std::endl
+		<< "  signatures:      " << rootBySignature.size() << std::endl
+		<< "  codex layouts:   " << Dcb::LayoutCodex::GetLayoutCount() << std::endl
+		<< "  root mismatches: " << mismatches << std::endl
+		<< "  split roots:     " << splits << std::endl
+		<< "  errors: " << mismatches + splits << std::endl;
+	return oss.str();
+}
+
+namespace
+{
+	// pass of a synthetic graph - draws nothing, it only has the links and transients it is given
+	class SyntheticPass : public Rgph::Pass
+	{
+	public:
+		// names of executed passes are appended to the list when one is given
+		SyntheticPass( std::string name, std::vector<std::string>* pExecuted = nullptr )
+			:
+			Pass( std::move( name ) ),
+			pExecuted( pExecuted )
+		{}
+		void Execute( Graphics& ) const noexcept(!IS_DEBUG) override
+		{
+			if ( pExecuted )
+			{
+				pExecuted->push_back( GetName() );
+			}
+		}
+		// links a sink to a render target another pass exposes, exposing it again under the same name when forwarded
+		void Read( const std::string& name, const std::string& target, bool forward = false )
+		{
+			auto& slot = targets.emplace_back();
+			RegisterSink( Rgph::DirectBufferSink<Bind::RenderTarget>::Make( name, slot ) );
+			SetSinkLinkage( name, target );
+			if ( forward )
+			{
+				RegisterSource( Rgph::DirectBufferSource<Bind::RenderTarget>::Make( name, slot ) );
+			}
+		}
+		// requests a transient render target exposed under the name - holds the target once the graph is finalized
+		const std::shared_ptr<Bind::RenderTarget>& Write( const std::string& name, unsigned int size )
+		{
+			auto& slot = targets.emplace_back();
+			RequestTransient( slot, size, size, 0u, name );
+			RegisterSource( Rgph::DirectBufferSource<Bind::RenderTarget>::Make( name, slot ) );
+			return slot;
+		}
+	private:
+		// members the sinks and sources are bound to, so they must not move
+		std::deque<std::shared_ptr<Bind::RenderTarget>> targets;
+		std::vector<std::string>* pExecuted;
+	};
+
+	// graph of synthetic passes, finalized as soon as it is built
+	class SyntheticGraph : public Rgph::RenderGraph
+	{
+	public:
+		SyntheticGraph( Graphics& gfx, std::vector<std::unique_ptr<SyntheticPass>> passes, const std::string& output )
+			:
+			RenderGraph( gfx )
+		{
+			for ( auto& p : passes )
+			{
+				AppendPass( std::move( p ) );
+			}
+			SetSinkTarget( "backbuffer", output );
+			Finalize( gfx );
+		}
+	};
+}
+
+std::string Benchmark::HeadlessFrames( size_t frames, const std::string& modelPath, float scale )
+{
+	Graphics gfx{ 1280, 720 };
+	Rgph::BlurOutlineRG rg{ gfx };
+	ThreadPool pool;
+	Rgph::ParallelSubmitter submitter{ pool };
+	Camera camera{ gfx, "Bench", { -13.5f, 6.0f, 3.5f }, 0.0f, PI / 2.0f };
+	PointLight light{ gfx, { 10.0f, 5.0f, 0.0f } };
+	Model model{ gfx, modelPath, scale };
+	light.LinkTechniques( rg );
+	model.LinkTechniques( rg );
+	rg.BindMainCamera( camera );
+	rg.BindShadowCamera( *light.ShareCamera() );
+	rg.BindLight( light );
+
+	std::vector<float> times;
+	std::vector<uint64_t> fingerprints;
+	Timer timer;
+	for ( size_t i = 0; i < frames; i++ )
+	{
+		timer.Mark();
+		gfx.BeginFrame( 0.07f, 0.0f, 0.12f );
+		camera.BindToGraphics( gfx );
+		constexpr auto allChannels = Channel::main | Channel::shadow;
+		submitter.Add( [&light] { light.Submit( allChannels ); } );
+		model.Submit( allChannels, submitter );
+		submitter.Flush();
+		rg.Execute( gfx, pool );
+		gfx.EndFrame();
+		rg.Reset();
+		times.push_back( timer.Mark() );
+		fingerprints.push_back( gfx.GetLog()->GetFingerprint() );
+		Bind::ConstantBufferEx::ResetStatistics();
+		Rgph::RenderQueuePass::ResetStatistics();
+	}
+
+	std::ostringstream oss;
+	oss << "[Headless Frames] " << frames << " frames of " << modelPath << std::endl;
+	if ( frames == 0u )
+	{
+		return oss.str();
+	}
+	const auto [minTime, maxTime] = std::minmax_element( times.begin(), times.end() );
+	float total = 0.0f;
+	for ( auto t : times )
+	{
+		total += t;
+	}
+	const auto& log = *gfx.GetLog();
+	const bool stable = std::all_of( fingerprints.begin() + 1, fingerprints.end(),
+		[&fingerprints]( uint64_t f ) { return f == fingerprints.back(); } );
+	oss << "  frame avg:     " << total / float( frames ) * 1000.0f << " ms" << std::endl
+		<< "  frame min/max: " << *minTime * 1000.0f << " / " << *maxTime * 1000.0f << " ms" << std::endl
+		<< "  last frame:    " << log.Count( CommandLog::Type::Bind ) << " binds, "
+		<< log.Count( CommandLog::Type::Upload ) << " uploads, "
+		<< log.Count( CommandLog::Type::Clear ) << " clears, "
+		<< log.Count( CommandLog::Type::Draw ) << " draws, "
+		<< log.Count( CommandLog::Type::Create ) << " creations" << std::endl
+		<< "  fingerprint:   " << std::hex << fingerprints.back() << std::dec << std::endl
+		<< "  stable:        " << ( stable ? "yes" : "no" ) << std::endl;
+	return oss.str();
+}
+
+std::string Benchmark::JobSorting( size_t frames, const std::string& modelPath, float scale )
+{
+	Graphics gfx{ 1280, 720 };
+	Rgph::BlurOutlineRG rg{ gfx };
+	ThreadPool pool;
+	Rgph::ParallelSubmitter submitter{ pool };
+	Camera camera{ gfx, "Bench", { -13.5f, 6.0f, 3.5f }, 0.0f, PI / 2.0f };
+	PointLight light{ gfx, { 10.0f, 5.0f, 0.0f } };
+	Model model{ gfx, modelPath, scale };
+	light.LinkTechniques( rg );
+	model.LinkTechniques( rg );
+	rg.BindMainCamera( camera );
+	rg.BindShadowCamera( *light.ShareCamera() );
+	rg.BindLight( light );
+
+	std::ostringstream oss;
+	oss << "[Job Sorting] " << frames << " frames of " << modelPath << " per mode, last frame of each" << std::endl;
+	const auto sortingWas = Rgph::RenderQueuePass::SortingEnabled();
+	for ( const bool sorting : { false, true } )
+	{
+		Rgph::RenderQueuePass::SortingEnabled() = sorting;
+		Rgph::RenderQueuePass::Statistics queue;
+		float total = 0.0f;
+		Timer timer;
+		for ( size_t i = 0; i < frames; i++ )
+		{
+			Rgph::RenderQueuePass::ResetStatistics();
+			timer.Mark();
+			gfx.BeginFrame( 0.07f, 0.0f, 0.12f );
+			camera.BindToGraphics( gfx );
+			constexpr auto allChannels = Channel::main | Channel::shadow;
+			submitter.Add( [&light] { light.Submit( allChannels ); } );
+			model.Submit( allChannels, submitter );
+			submitter.Flush();
+			rg.Execute( gfx, pool );
+			gfx.EndFrame();
+			queue = Rgph::RenderQueuePass::GetStatistics();
+			rg.Reset();
+			total += timer.Mark();
+			Bind::ConstantBufferEx::ResetStatistics();
+		}
+		const auto& log = *gfx.GetLog();
+		oss << "  " << ( sorting ? "sorted:   " : "unsorted: " )
+			<< log.Count( CommandLog::Type::Bind ) << " binds issued, "
+			<< log.Count( CommandLog::Type::Draw ) << " draws, "
+			<< queue.instances << " jobs in " << queue.instancedDraws << " instanced draws, "
+			<< queue.redundantBinds << "/" << queue.stepBinds << " step binds repeated, "
+			<< ( frames > 0u ? total / float( frames ) * 1000.0f : 0.0f ) << " ms/frame" << std::endl;
+	}
+	Rgph::RenderQueuePass::SortingEnabled() = sortingWas;
+	return oss.str();
+}
+
+std::string Benchmark::CleanUploads( size_t frames, const std::string& modelPath, float scale )
+{
+	size_t errors = 0u;
+	std::ostringstream oss;
+	oss << "[Clean Uploads] " << frames << " unchanged frames of " << modelPath << std::endl;
+
+	// reads through the const paths must leave a clean buffer clean, writes must dirty it
+	{
+		Dcb::RawLayout layout;
+		layout.Add<Dcb::Float3>( "materialColor" );
+		layout.Add<Dcb::Float>( "specularGloss" );
+		Dcb::Buffer buf{ std::move( layout ) };
+		const Dcb::FieldHandle<float> specularGloss{ buf, "specularGloss" };
+		buf.ClearDirty();
+		float sum = static_cast<const float&>( std::as_const( buf )["specularGloss"] );
+		sum += std::as_const( buf )[specularGloss];
+		sum += static_cast<const float&>( buf["specularGloss"] );
+		const bool readsClean = !buf.IsDirty();
+		buf["specularGloss"] = sum;
+		const bool writeDirty = buf.IsDirty();
+		errors += ( readsClean ? 0u : 1u ) + ( writeDirty ? 0u : 1u );
+		oss << "  const reads:   " << ( readsClean ? "clean" : "dirty" ) << std::endl
+			<< "  write:         " << ( writeDirty ? "dirty" : "clean" ) << std::endl;
+	}
+
+	Graphics gfx{ 1280, 720 };
+	Rgph::BlurOutlineRG rg{ gfx };
+	ThreadPool pool;
+	Rgph::ParallelSubmitter submitter{ pool };
+	Camera camera{ gfx, "Bench", { -13.5f, 6.0f, 3.5f }, 0.0f, PI / 2.0f };
+	PointLight light{ gfx, { 10.0f, 5.0f, 0.0f } };
+	Model model{ gfx, modelPath, scale };
+	light.LinkTechniques( rg );
+	model.LinkTechniques( rg );
+	rg.BindMainCamera( camera );
+	rg.BindShadowCamera( *light.ShareCamera() );
+	rg.BindLight( light );
+
+	// buffers created without contents upload on their first frame, after that nothing changes,
+	// so every later frame has to upload exactly as much as the second one
+	std::vector<size_t> uploads;
+	for ( size_t i = 0; i < frames; i++ )
+	{
+		Bind::ConstantBufferEx::ResetStatistics();
+		gfx.BeginFrame( 0.07f, 0.0f, 0.12f );
+		camera.BindToGraphics( gfx );
+		constexpr auto allChannels = Channel::main | Channel::shadow;
+		submitter.Add( [&light] { light.Submit( allChannels ); } );
+		model.Submit( allChannels, submitter );
+		submitter.Flush();
+		rg.Execute( gfx, pool );
+		gfx.EndFrame();
+		rg.Reset();
+		uploads.push_back( Bind::ConstantBufferEx::GetStatistics().uploads );
+	}
+	Bind::ConstantBufferEx::ResetStatistics();
+	Rgph::RenderQueuePass::ResetStatistics();
+
+	oss << "  uploads:      ";
+	for ( size_t i = 0; i < uploads.size(); i++ )
+	{
+		oss << " " << uploads[i];
+		if ( i > 1u && uploads[i] != uploads[1] )
+		{
+			errors++;
+		}
+	}
+	oss << std::endl << "  errors: " << errors << std::endl;
+	return oss.str();
+}
+
+std::string Benchmark::ReplayCapture( size_t frames, const std::string& capturePath )
+{
+	FrameCapture capture{ capturePath };
+	Graphics gfx{ int( capture.GetWidth() ), int( capture.GetHeight() ) };
+	capture.Prepare( gfx );
+
+	std::vector<float> times;
+	size_t mismatches = 0u;
+	Timer timer;
+	for ( size_t i = 0; i < frames; i++ )
+	{
+		gfx.GetLog()->Clear();
+		timer.Mark();
+		capture.Replay( gfx );
+		times.push_back( timer.Mark() );
+		if ( gfx.GetLog()->GetFingerprint() != capture.GetFingerprint() )
+		{
+			mismatches++;
+		}
+	}
+
+	std::ostringstream oss;
+	oss << "[Capture Replay] " << frames << " replays of " << capturePath << std::endl
+		<< "  note:           times cover the recorded d3d calls only, not engine submission or execution" << std::endl
+		<< "                  (queue sorting, state cache, dcb uploads, graph traversal) - see bench-headless" << std::endl
+		<< "  frame:          " << capture.GetCommandCount() << " commands, " << capture.GetObjectCount() << " objects" << std::endl;
+	if ( frames == 0u )
+	{
+		return oss.str();
+	}
+	const auto [minTime, maxTime] = std::minmax_element( times.begin(), times.end() );
+	float total = 0.0f;
+	for ( auto t : times )
+	{
+		total += t;
+	}
+	oss << "  replay avg:     " << total / float( frames ) * 1000.0f << " ms" << std::endl
+		<< "  replay min/max: " << *minTime * 1000.0f << " / " << *maxTime * 1000.0f << " ms" << std::endl
+		<< "  fingerprint:    " << std::hex << capture.GetFingerprint() << std::dec << std::endl
+		<< "  mismatches:     " << mismatches << std::endl;
+	return oss.str();
+}
+
+std::string Benchmark::TransformUpdate( size_t iterations, const std::string& modelPath, float scale )
+{
+	namespace dx = DirectX;
+	Graphics gfx{ 1280, 720 };
+	const Model model{ gfx, modelPath, scale };
+	// a copy, so the model itself is left as loaded
+	auto transforms = model.GetTransforms();
+	const auto count = transforms.GetCount();
+
+	// recursive reference - what the nodes computed for themselves every frame before the hierarchy was flattened
+	std::vector<std::vector<size_t>> children( count );
+	for ( size_t i = 1; i < count; i++ )
+	{
+		children[transforms.GetParent( i )].push_back( i );
+	}
+	std::vector<dx::XMFLOAT4X4> reference( count );
+	const std::function<void( size_t, dx::FXMMATRIX )> traverse = [&]( size_t i, dx::FXMMATRIX accumulated )
+	{
+		const auto built =
+			dx::XMLoadFloat4x4( &transforms.GetBase( i ) ) *
+			dx::XMLoadFloat4x4( &transforms.GetApplied( i ) ) *
+			accumulated;
+		dx::XMStoreFloat4x4( &reference[i], built );
+		for ( const auto c : children[i] )
+		{
+			traverse( c, built );
+		}
+	};
+
+	Timer timer;
+	for ( size_t i = 0; i < iterations; i++ )
+	{
+		transforms.SetApplied( 0u, dx::XMMatrixRotationY( float( i ) * 0.001f ) );
+		traverse( 0u, dx::XMMatrixIdentity() );
+	}
+	const auto recursiveTime = timer.Mark();
+
+	// moving the root dirties the whole hierarchy every iteration
+	for ( size_t i = 0; i < iterations; i++ )
+	{
+		transforms.SetApplied( 0u, dx::XMMatrixRotationY( float( i ) * 0.001f ) );
+		transforms.Update();
+	}
+	const auto fullTime = timer.Mark();
+	const auto fullUpdated = transforms.GetStatistics().updated;
+
+	// the flattened result has to match the recursive one for the same root transform
+	float deviation = 0.0f;
+	for ( size_t i = 0; i < count; i++ )
+	{
+		const auto& a = reference[i];
+		const auto& b = transforms.GetWorld( i );
+		for ( int r = 0; r < 4; r++ )
+		{
+			for ( int c = 0; c < 4; c++ )
+			{
+				deviation = std::max( deviation, std::abs( a.m[r][c] - b.m[r][c] ) );
+			}
+		}
+	}
+
+	// a single leaf, like one node dragged in the model window
+	const auto leaf = count - 1u;
+	for ( size_t i = 0; i < iterations; i++ )
+	{
+		transforms.SetApplied( leaf, dx::XMMatrixRotationY( float( i ) * 0.001f ) );
+		transforms.Update();
+	}
+	const auto leafTime = timer.Mark();
+	const auto leafUpdated = transforms.GetStatistics().updated;
+
+	// nothing moved - the common case for static scenery
+	for ( size_t i = 0; i < iterations; i++ )
+	{
+		transforms.Update();
+	}
+	const auto cleanTime = timer.Mark();
+
+	const auto perUpdate = [iterations]( float t ) { return iterations ? t / float( iterations ) * 1000000.0f : 0.0f; };
+	std::ostringstream oss;
+	oss << "[Transform Update] " << iterations << " updates of " << modelPath << " (" << count << " nodes)" << std::endl
+		<< "  recursive:      " << perUpdate( recursiveTime ) << " us" << std::endl
+		<< "  flat, root:     " << perUpdate( fullTime ) << " us (" << fullUpdated << " nodes)" << std::endl
+		<< "  flat, leaf:     " << perUpdate( leafTime ) << " us (" << leafUpdated << " nodes)" << std::endl
+		<< "  flat, clean:    " << perUpdate( cleanTime ) << " us" << std::endl
+		<< "  max deviation:  " << deviation << std::endl;
+	return oss.str();
+}
+
+namespace
+{
+	// drops every bindable nothing references, so the next load creates everything again
+	void FlushCodex()
+	{
+		const auto budget = Bind::Codex::GetStatistics().budget;
+		Bind::Codex::SetBudget( 0u );
+		Bind::Codex::Trim();
+		Bind::Codex::SetBudget( budget );
+	}
+}
+
+std::string Benchmark::ModelLoad( size_t runs, const std::vector<std::pair<std::string, float>>& models )
+{
+	Graphics gfx{ 1280, 720 };
+	ThreadPool pool;
+
+	std::ostringstream oss;
+	oss << "[Model Load] " << runs << " runs of " << models.size() << " models" << std::endl;
+	for ( const auto pPool : { static_cast<ThreadPool*>( nullptr ), &pool } )
+	{
+		Model::LoadStatistics total;
+		float wall = 0.0f;
+		for ( size_t r = 0; r < runs; r++ )
+		{
+			FlushCodex();
+			Timer timer;
+			std::vector<std::unique_ptr<Model>> loaded;
+			for ( const auto& [path, scale] : models )
+			{
+				loaded.push_back( std::make_unique<Model>( gfx, path, scale, pPool ) );
+			}
+			wall += timer.Peek();
+			for ( const auto& pModel : loaded )
+			{
+				const auto& s = pModel->GetLoadStatistics();
+				total.parse += s.parse;
+				total.decode += s.decode;
+				total.materials += s.materials;
+				total.extract += s.extract;
+				total.upload += s.upload;
+				total.textures += s.textures;
+				total.meshes += s.meshes;
+			}
+		}
+		const auto perRun = [runs]( float t ) { return runs ? t / float( runs ) * 1000.0f : 0.0f; };
+		oss << ( pPool ? "  thread pool (" + std::to_string( pool.GetWorkerCount() ) + " workers + caller)" : std::string( "  single thread" ) ) << std::endl
+			<< "    total:     " << perRun( wall ) << " ms" << std::endl
+			<< "    parse:     " << perRun( total.parse ) << " ms" << std::endl
+			<< "    decode:    " << perRun( total.decode ) << " ms (" << total.textures / std::max( runs, size_t( 1u ) ) << " images)" << std::endl
+			<< "    materials: " << perRun( total.materials ) << " ms" << std::endl
+			<< "    extract:   " << perRun( total.extract ) << " ms (" << total.meshes / std::max( runs, size_t( 1u ) ) << " meshes)" << std::endl
+			<< "    upload:    " << perRun( total.upload ) << " ms" << std::endl;
+	}
+
+	// streamed loads return at once, so a first frame only waits for that - ready is when the last model has been polled in
+	float returned = 0.0f;
+	float ready = 0.0f;
+	for ( size_t r = 0; r < runs; r++ )
+	{
+		FlushCodex();
+		Timer timer;
+		std::vector<std::unique_ptr<Model>> loaded;
+		for ( const auto& [path, scale] : models )
+		{
+			loaded.push_back( Model::LoadAsync( path, scale, pool ) );
+		}
+		returned += timer.Peek();
+		size_t nReady = 0u;
+		while ( nReady < loaded.size() )
+		{
+			std::this_thread::yield();
+			nReady = 0u;
+			for ( const auto& pModel : loaded )
+			{
+				nReady += pModel->Poll( gfx ) ? 1u : 0u;
+			}
+		}
+		ready += timer.Peek();
+	}
+	const auto perRun = [runs]( float t ) { return runs ? t / float( runs ) * 1000.0f : 0.0f; };
+	oss << "  streamed on the thread pool" << std::endl
+		<< "    first frame: " << perRun( returned ) << " ms" << std::endl
+		<< "    all ready:   " << perRun( ready ) << " ms" << std::endl;
+	FlushCodex();
+	return oss.str();
+}
+
+std::string Benchmark::BakedLoad( size_t runs, const std::string& modelPath, float scale )
+{
+	Graphics gfx{ 1280, 720 };
+	ThreadPool pool;
+
+	Timer timer;
+	const auto bakedPath = ModelBaker::MakeBakedPath( modelPath );
+	ModelBaker::Bake( modelPath, bakedPath, scale );
+	const auto bakeTime = timer.Mark();
+
+	std::ostringstream oss;
+	oss << "[Baked Load] " << runs << " runs of " << modelPath << std::endl
+		<< "  bake:             " << bakeTime * 1000.0f << " ms -> " << bakedPath
+		<< " (" << std::filesystem::file_size( bakedPath ) / 1024u << " KB)" << std::endl;
+	for ( const auto& path : { modelPath, bakedPath } )
+	{
+		// cold loads start from an empty codex, warm loads find every bindable already resident
+		for ( const bool warm : { false, true } )
+		{
+			FlushCodex();
+			std::unique_ptr<Model> pResident;
+			if ( warm )
+			{
+				pResident = std::make_unique<Model>( gfx, path, scale, &pool );
+			}
+			float total = 0.0f;
+			Model::LoadStatistics stages;
+			for ( size_t r = 0; r < runs; r++ )
+			{
+				if ( !warm )
+				{
+					FlushCodex();
+				}
+				timer.Mark();
+				const Model model{ gfx, path, scale, &pool };
+				total += timer.Peek();
+				const auto& s = model.GetLoadStatistics();
+				stages.parse += s.parse;
+				stages.extract += s.extract;
+				stages.upload += s.upload;
+				stages.decode += s.decode + s.materials;
+			}
+			const auto perRun = [runs]( float t ) { return runs ? t / float( runs ) * 1000.0f : 0.0f; };
+			oss << "  " << ( path == bakedPath ? "baked " : "assimp" ) << ( warm ? " warm:      " : " cold:      " )
+				<< perRun( total ) << " ms (parse " << perRun( stages.parse )
+				<< ", materials " << perRun( stages.decode )
+				<< ", extract " << perRun( stages.extract )
+				<< ", upload " << perRun( stages.upload ) << ")" << std::endl;
+		}
+	}
+	FlushCodex();
+	return oss.str();
+}
+
+std::string Benchmark::IndexWidth( const std::vector<size_t>& vertexCounts )
+{
+	Graphics gfx{ 1280, 720 };
+
+	std::ostringstream oss;
+	oss << "[Index Width] " << vertexCounts.size() << " synthetic meshes" << std::endl;
+	size_t errors = 0u;
+	const auto check = [&]( const std::string& name, size_t nVertices, const std::vector<unsigned int>& indices )
+	{
+		const Bind::IndexBuffer ib{ gfx, indices };
+		// 16 bit holds every index up to 65535, so one more vertex than that needs 32
+		const bool wide = nVertices > size_t( std::numeric_limits<unsigned short>::max() ) + 1u;
+		const auto stride = wide ? sizeof( unsigned int ) : sizeof( unsigned short );
+		const auto maxIndex = indices.empty() ? 0u : *std::max_element( indices.begin(), indices.end() );
+		const bool ok = maxIndex == nVertices - 1u &&
+			( ib.GetFormat() == DXGI_FORMAT_R32_UINT ) == wide &&
+			ib.GetCount() == indices.size() &&
+			ib.GetSizeInBytes() == indices.size() * stride;
+		errors += ok ? 0u : 1u;
+		oss << "  " << name << ": " << nVertices << " vertices, " << ( ib.GetFormat() == DXGI_FORMAT_R32_UINT ? 32 : 16 ) << " bit, "
+			<< ib.GetSizeInBytes() << " bytes" << ( ok ? "" : " - wrong" ) << std::endl;
+	};
+	for ( const auto nVertices : vertexCounts )
+	{
+		if ( nVertices < 3u )
+		{
+			continue;
+		}
+		// a strip of triangles over every vertex, so the highest index is the last vertex
+		aiMesh mesh;
+		mesh.mNumVertices = unsigned( nVertices );
+		mesh.mNumFaces = unsigned( nVertices - 2u );
+		mesh.mFaces = new aiFace[mesh.mNumFaces];
+		for ( unsigned int f = 0; f < mesh.mNumFaces; f++ )
+		{
+			mesh.mFaces[f].mNumIndices = 3u;
+			mesh.mFaces[f].mIndices = new unsigned int[3]{ f, f + 1u, f + 2u };
+		}
+		check( "strip", nVertices, Material::ExtractIndices( mesh ) );
+	}
+	// the primitives go through the same buffers, above and below the limit
+	for ( const int divisions : { 16, 300 } )
+	{
+		const auto plane = Plane::MakeTesselatedTextured( VertexMeta::VertexLayout{}
+			.Append( VertexMeta::VertexLayout::Position3D )
+			.Append( VertexMeta::VertexLayout::Normal )
+			.Append( VertexMeta::VertexLayout::Texture2D ), divisions, divisions );
+		check( "plane", plane.vertices.Size(), plane.indices );
+	}
+	// the poles are the last two vertices, so the south pole carries the highest index
+	for ( const auto& [latDiv, longDiv] : { std::pair{ 12, 24 }, std::pair{ 200, 400 } } )
+	{
+		const auto sphere = Sphere::MakeTesselated( VertexMeta::VertexLayout{}
+			.Append( VertexMeta::VertexLayout::Position3D ), latDiv, longDiv );
+		check( "sphere", sphere.vertices.Size(), sphere.indices );
+	}
+	oss << "  errors: " << errors << std::endl;
+	return oss.str();
+}
+
+std::string Benchmark::GraphOrder()
+{
+	// appended out of dependency order, with a pass nothing reads from
+	Graphics gfx{ 1280, 720 };
+	std::vector<std::string> executed;
+	std::vector<std::unique_ptr<SyntheticPass>> passes;
+	for ( const auto name : { "blur", "unused", "scene", "output" } )
+	{
+		passes.push_back( std::make_unique<SyntheticPass>( name, &executed ) );
+	}
+	passes[0]->Read( "color", "scene.color" );
+	passes[0]->Write( "blurred", 256u );
+	passes[1]->Write( "junk", 256u );
+	passes[2]->Write( "color", 256u );
+	passes[3]->Read( "blurred", "blur.blurred" );
+	passes[3]->Read( "backbuffer", "$.backbuffer", true );
+	SyntheticGraph graph{ gfx, std::move( passes ), "output.backbuffer" };
+	graph.Execute( gfx );
+
+	const std::vector<std::string> expected{ "scene", "blur", "output" };
+	// the dead pass must never run and must be reported culled by the graph itself
+	const bool culled = std::find( executed.begin(), executed.end(), "unused" ) == executed.end() &&
+		graph.GetFinalizeReport().find( "Culled passes:\n  unused\n" ) != std::string::npos;
+	const bool ordered = executed == expected;
+	const size_t errors = ( culled ? 0u : 1u ) + ( ordered ? 0u : 1u );
+
+	std::ostringstream oss;
+	oss << "[Graph Order] synthetic graph of 4 passes" << std::endl
+		<< "  executed:";
+	for ( const auto& name : executed )
+	{
+		oss << " " << name;
+	}
+	oss << std::endl
+		<< "  dead pass:  " << ( culled ? "culled" : "not culled" ) << std::endl
+		<< "  order:      " << ( ordered ? "dependencies first" : "wrong" ) << std::endl
+		<< "  errors: " << errors << std::endl;
+	return oss.str();
+}
+
+std::string Benchmark::TransientAliasing( size_t trials )
+{
+	std::ostringstream oss;
+	oss << "[Transient Aliasing] " << trials << " random plans and a synthetic graph" << std::endl;
+	size_t errors = 0u;
+
+	// every request sharing a resource with another must match its description and be out of use before the other starts
+	const auto checkPlan = []( const std::vector<Rgph::TransientPlanner::Request>& requests, const Rgph::TransientPlanner::Plan& plan )
+	{
+		size_t overlaps = 0u;
+		for ( size_t a = 0; a < requests.size(); a++ )
+		{
+			for ( size_t b = a + 1u; b < requests.size(); b++ )
+			{
+				if ( plan.assignment[a] != plan.assignment[b] )
+				{
+					continue;
+				}
+				const bool apart = requests[a].lastUse < requests[b].firstUse || requests[b].lastUse < requests[a].firstUse;
+				overlaps += apart && requests[a].desc == requests[b].desc ? 0u : 1u;
+			}
+		}
+		return overlaps;
+	};
+	std::mt19937 rng{ 0x7a11u };
+	size_t requested = 0u;
+	size_t allocated = 0u;
+	for ( size_t t = 0; t < trials; t++ )
+	{
+		std::vector<Rgph::TransientPlanner::Request> requests( 16u );
+		for ( auto& r : requests )
+		{
+			const unsigned int size = rng() % 2u ? 256u : 512u;
+			r.desc = { Rgph::TransientDesc::Type::RenderTarget, size, size };
+			r.firstUse = rng() % 12u;
+			r.lastUse = r.firstUse + rng() % 4u;
+		}
+		const auto plan = Rgph::TransientPlanner::Build( requests );
+		errors += checkPlan( requests, plan );
+		requested += requests.size();
+		allocated += plan.resources.size();
+	}
+	oss << "  random plans:    " << requested << " requests in " << allocated << " resources" << std::endl;
+
+	// t is handed on by b, so it lives until c reads it, while c already writes u - the two must not share
+	// v is only written after t is done with, so it can take over t's target
+	Graphics gfx{ 1280, 720 };
+	std::vector<std::unique_ptr<SyntheticPass>> passes;
+	for ( const auto name : { "a", "b", "c", "d", "output" } )
+	{
+		passes.push_back( std::make_unique<SyntheticPass>( name ) );
+	}
+	const auto& t = passes[0]->Write( "t", 256u );
+	passes[1]->Read( "t", "a.t", true );
+	passes[2]->Read( "t", "b.t" );
+	const auto& u = passes[2]->Write( "u", 256u );
+	passes[3]->Read( "u", "c.u" );
+	const auto& v = passes[3]->Write( "v", 256u );
+	passes[4]->Read( "v", "d.v" );
+	passes[4]->Read( "backbuffer", "$.backbuffer", true );
+	const SyntheticGraph graph{ gfx, std::move( passes ), "output.backbuffer" };
+	const bool apart = t != u && u != v;
+	const bool reused = t == v;
+	errors += ( apart ? 0u : 1u ) + ( reused ? 0u : 1u );
+	oss << "  synthetic graph: overlapping targets " << ( apart ? "apart" : "aliased" )
+		<< ", later target " << ( reused ? "reused" : "not reused" ) << std::endl
+		<< "  errors: " << errors << std::endl;
+	return oss.str();
+}
+
+std::string Benchmark::MeshOptimization( const std::string& modelPath, size_t cacheSize )
+{
+	Assimp::Importer importer;
+	const auto& scene = Model::Import( importer, modelPath );
+
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision( 3 )
+		<< "[Mesh Optimization] " << scene.mNumMeshes << " meshes of " << modelPath << ", " << cacheSize << " entry fifo cache" << std::endl
+		<< "  acmr / atvr:   assimp order -> vertex cache -> overdraw" << std::endl;
+	// totals are weighted by triangles for the acmr and by vertices for the atvr
+	MeshOptimizer::CacheStatistics totals[3];
+	size_t triangles = 0u;
+	size_t vertices = 0u;
+	float cacheTime = 0.0f;
+	float overdrawTime = 0.0f;
+	float fetchTime = 0.0f;
+	for ( unsigned int m = 0; m < scene.mNumMeshes; m++ )
+	{
+		const auto& mesh = *scene.mMeshes[m];
+		VertexMeta::VertexBuffer vbuf{ Material::MakeLayout( *scene.mMaterials[mesh.mMaterialIndex] ), mesh };
+		MeshOptimizer::Vertices raw{ vbuf.GetData(), vbuf.Size(), vbuf.GetLayout().Size(),
+			vbuf.GetLayout().Resolve<VertexMeta::VertexLayout::Position3D>().GetOffset() };
+		auto indices = Material::ExtractIndices( mesh );
+		const auto nTriangles = indices.size() / 3u;
+
+		MeshOptimizer::CacheStatistics stats[3];
+		stats[0] = MeshOptimizer::AnalyzeVertexCache( indices, vbuf.Size(), cacheSize );
+		Timer timer;
+		MeshOptimizer::OptimizeVertexCache( indices, vbuf.Size() );
+		cacheTime += timer.Mark();
+		stats[1] = MeshOptimizer::AnalyzeVertexCache( indices, vbuf.Size(), cacheSize );
+		timer.Mark();
+		MeshOptimizer::OptimizeOverdraw( indices, raw );
+		overdrawTime += timer.Mark();
+		stats[2] = MeshOptimizer::AnalyzeVertexCache( indices, vbuf.Size(), cacheSize );
+		timer.Mark();
+		MeshOptimizer::OptimizeVertexFetch( raw, indices );
+		fetchTime += timer.Mark();
+		vbuf.Resize( raw.count );
+
+		for ( size_t s = 0; s < 3u; s++ )
+		{
+			totals[s].acmr += stats[s].acmr * float( nTriangles );
+			totals[s].atvr += stats[s].atvr * float( vbuf.Size() );
+		}
+		triangles += nTriangles;
+		vertices += vbuf.Size();
+		oss << "  " << mesh.mName.C_Str() << " (" << nTriangles << " triangles): "
+			<< stats[0].acmr << " / " << stats[0].atvr << " -> "
+			<< stats[1].acmr << " / " << stats[1].atvr << " -> "
+			<< stats[2].acmr << " / " << stats[2].atvr << std::endl;
+	}
+	oss << "  total (" << triangles << " triangles, " << vertices << " vertices): ";
+	for ( size_t s = 0; s < 3u; s++ )
+	{
+		oss << ( s ? " -> " : "" ) << ( triangles ? totals[s].acmr / float( triangles ) : 0.0f )
+			<< " / " << ( vertices ? totals[s].atvr / float( vertices ) : 0.0f );
+	}
+	oss << std::endl
+		<< "  vertex cache:  " << cacheTime * 1000.0f << " ms" << std::endl
+		<< "  overdraw:      " << overdrawTime * 1000.0f << " ms" << std::endl
+		<< "  vertex fetch:  " << fetchTime * 1000.0f << " ms" << std::endl;
+	return oss.str();
+}
+
+std::string Benchmark::CommandOrder( size_t frames, const std::string& modelPath, float scale )
+{
+	Graphics gfx{ 1280, 720 };
+	Rgph::BlurOutlineRG rg{ gfx };
+	ThreadPool pool;
+	Rgph::ParallelSubmitter submitter{ pool };
+	Camera camera{ gfx, "Bench", { -13.5f, 6.0f, 3.5f }, 0.0f, PI / 2.0f };
+	PointLight light{ gfx, { 10.0f, 5.0f, 0.0f } };
+	Model model{ gfx, modelPath, scale };
+	light.LinkTechniques( rg );
+	model.LinkTechniques( rg );
+	rg.BindMainCamera( camera );
+	rg.BindShadowCamera( *light.ShareCamera() );
+	rg.BindLight( light );
+
+	// recorded lists start from default state and their caches drop fewer binds, so the logs differ in the binds issued
+	// what has to match is every clear and draw, in order, with the shaders, buffers and targets it actually used
+	const auto drawOrder = []( const CommandLog& log )
+	{
+		const auto entries = log.GetEntries();
+		const auto data = log.GetData();
+		std::unordered_map<std::string, std::string> bound;
+		std::vector<std::string> order;
+		for ( const auto& e : entries )
+		{
+			std::ostringstream oss;
+			oss << e.name << " " << e.slot << " " << e.count << " " << e.pObject;
+			if ( e.type == CommandLog::Type::Bind )
+			{
+				const std::string call = e.name;
+				if ( call == "OMSetRenderTargets" )
+				{
+					// every view and the depth view are in the arguments
+					for ( size_t b = 0; b < e.dataSize; b += sizeof( const void* ) )
+					{
+						const void* pView;
+						memcpy( &pView, data.data() + e.dataOffset + b, sizeof( pView ) );
+						oss << " " << pView;
+					}
+				}
+				if ( call == "VSSetShader" || call == "PSSetShader" || call == "IASetInputLayout" ||
+					call == "IASetIndexBuffer" || call == "OMSetRenderTargets" )
+				{
+					bound[call] = oss.str();
+				}
+			}
+			else if ( e.type == CommandLog::Type::Draw )
+			{
+				for ( const auto& call : { "VSSetShader", "PSSetShader", "IASetInputLayout", "IASetIndexBuffer", "OMSetRenderTargets" } )
+				{
+					oss << " | " << bound[call];
+				}
+				order.push_back( oss.str() );
+			}
+			else if ( e.type == CommandLog::Type::Clear )
+			{
+				order.push_back( oss.str() );
+			}
+		}
+		return order;
+	};
+
+	std::ostringstream oss;
+	oss << "[Command Order] " << frames << " frames of " << modelPath << ", passes executed in order and recorded on the pool" << std::endl;
+	const auto recordingWas = Rgph::RenderGraph::RecordingEnabled();
+	size_t errors = 0u;
+	size_t draws = 0u;
+	float times[2] = {};
+	Timer timer;
+	for ( size_t i = 0; i < frames; i++ )
+	{
+		std::vector<std::string> orders[2];
+		for ( const bool recording : { false, true } )
+		{
+			Rgph::RenderGraph::RecordingEnabled() = recording;
+			gfx.BeginFrame( 0.07f, 0.0f, 0.12f );
+			camera.BindToGraphics( gfx );
+			constexpr auto allChannels = Channel::main | Channel::shadow;
+			submitter.Add( [&light] { light.Submit( allChannels ); } );
+			model.Submit( allChannels, submitter );
+			submitter.Flush();
+			timer.Mark();
+			rg.Execute( gfx, pool );
+			times[recording] += timer.Mark();
+			orders[recording] = drawOrder( *gfx.GetLog() );
+			gfx.EndFrame();
+			rg.Reset();
+		}
+		draws = gfx.GetLog()->Count( CommandLog::Type::Draw );
+		errors += orders[0] == orders[1] ? 0u : 1u;
+	}
+	Rgph::RenderGraph::RecordingEnabled() = recordingWas;
+	Bind::ConstantBufferEx::ResetStatistics();
+	Rgph::RenderQueuePass::ResetStatistics();
+
+	const auto perFrame = [frames]( float t ) { return frames > 0u ? t / float( frames ) * 1000.0f : 0.0f; };
+	oss << "  draws:      " << draws << " per frame" << std::endl
+		<< "  in order:   " << perFrame( times[0] ) << " ms/frame" << std::endl
+		<< "  recorded:   " << perFrame( times[1] ) << " ms/frame" << std::endl
+		<< "  errors: " << errors << std::endl;
+	return oss.str();
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+// offline timing runs that can be launched through the ScriptCommander
+// each returns a human readable report of the measurements
+class Benchmark
+{
+public:
+	// compare string-keyed Dcb::Buffer access against precompiled Dcb::FieldHandle access
+	static std::string DynamicConstantAccess( size_t iterations );
+	// resolve randomly generated layouts from many threads at once and verify that
+	// structurally identical layouts always come back as the same shared layout - reports an error for every
+	// seed resolved to more than one root, root shared by different signatures and signature split over roots
+	static std::string LayoutCodexStress( size_t threads, size_t layouts );
+	// render frames of a model on headless graphics, reporting frame times and the work each frame issued
+	// frames after the first should issue identical work, so their fingerprints are compared as well
+	static std::string HeadlessFrames( size_t frames, const std::string& modelPath, float scale );
+	// render frames of a model on headless graphics with job sorting off and on, reporting the binds issued,
+	// draws and instanced draws of each so the sort policies of the passes can be compared
+	static std::string JobSorting( size_t frames, const std::string& modelPath, float scale );
+	// check that reads through the const paths of a Dcb::Buffer leave it clean, then render unchanged frames
+	// of a model on headless graphics and check that every frame after the first uploads as many constant buffers
+	static std::string CleanUploads( size_t frames, const std::string& modelPath, float scale );
+	// replay a captured frame on headless graphics, reporting replay times and whether each replay
+	// issued the same work as the frame that was captured - the times are of the d3d calls alone
+	static std::string ReplayCapture( size_t frames, const std::string& capturePath );
+	// update the flattened transform hierarchy of a model after moving its root, a single leaf or nothing,
+	// against the recursive traversal it replaced
+	static std::string TransformUpdate( size_t iterations, const std::string& modelPath, float scale );
+	// load a set of models on headless graphics, one thread against the staged loader on a thread pool,
+	// reporting the time of each load stage summed over the models
+	// the codex is emptied before every run, so each run decodes and creates everything again
+	// streamed loads are timed until they return, which is all a first frame waits for, and until every model is ready
+	static std::string ModelLoad( size_t runs, const std::vector<std::pair<std::string, float>>& models );
+	// bake a model next to its source, then time loading it through assimp against loading the baked file
+	// cold loads start from an empty codex, warm loads keep a loaded copy around so every bindable is resident
+	static std::string BakedLoad( size_t runs, const std::string& modelPath, float scale );
+	// build index buffers for synthetic meshes and primitives around the 16 bit limit, checking that no index is truncated
+	// and that each buffer is 16 bit exactly when every index fits
+	static std::string IndexWidth( const std::vector<size_t>& vertexCounts );
+	// finalize and execute a synthetic graph appended out of dependency order on headless graphics,
+	// checking that a pass nothing reads from is culled and that every pass runs after the passes it reads from
+	static std::string GraphOrder();
+	// plan random transient lifetimes and finalize a synthetic graph that hands a transient on through a second pass,
+	// checking that no targets with overlapping lifetimes are aliased and that a later target reuses a finished one
+	static std::string TransientAliasing( size_t trials );
+	// reorder every mesh of a model for the vertex cache, then for overdraw, reporting the acmr and atvr a simulated
+	// fifo cache gives each mesh in assimp's order and after each stage, and the time the stages took
+	static std::string MeshOptimization( const std::string& modelPath, size_t cacheSize );
+	// execute the render graph of a model on headless graphics pass by pass, then with the passes recorded on a thread pool,
+	// checking that both clear and draw the same things in the same order with the same shaders, buffers and targets
+	static std::string CommandOrder( size_t frames, const std::string& modelPath, float scale );
+};
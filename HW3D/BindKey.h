@@ -0,0 +1,141 @@
+#pragma once
+#include <typeinfo>
+#include <type_traits>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cassert>
+
+namespace Bind
+{
+	// compact codex key - type of the bindable plus two independent 64-bit hashes of its construction parameters
+	// parameters are folded into the hashes as they are added, so building a key allocates nothing
+	// lookups go by the first hash and equality needs both, so two parameter sets would have to collide in 128 bits
+	// debug builds also keep the old readable uid text for display and to catch collisions
+	class BindKey
+	{
+	public:
+		BindKey( const std::type_info& type ) noexcept(!IS_DEBUG)
+			:
+			pType( &type ),
+			hash( Combine( 14695981039346656037ull, uint64_t( type.hash_code() ) ) ),
+			check( CombineCheck( 0x243f6a8885a308d3ull, uint64_t( type.hash_code() ) ) )
+#ifndef NDEBUG
+			, name( type.name() )
+#endif
+		{}
+		template<class T, typename...Params>
+		static BindKey Make( const Params&...params ) noexcept(!IS_DEBUG)
+		{
+			BindKey key{ typeid( T ) };
+			( key.Add( params ), ... );
+			return key;
+		}
+		// strings, integral and enum values and other keys can be folded in
+		template<typename P>
+		BindKey& Add( const P& param ) noexcept(!IS_DEBUG)
+		{
+			if constexpr ( std::is_same_v<P, BindKey> )
+			{
+				hash = Combine( hash, param.hash );
+				check = CombineCheck( check, param.check );
+#ifndef NDEBUG
+				name += "#" + param.name;
+#endif
+			}
+			else if constexpr ( std::is_convertible_v<const P&, std::string_view> )
+			{
+				const std::string_view str = param;
+				hash = Combine( hash, HashString( str ) );
+				check = CombineCheck( check, CheckString( str ) );
+#ifndef NDEBUG
+				name += "#";
+				name += str;
+#endif
+			}
+			else
+			{
+				static_assert( std::is_integral_v<P> || std::is_enum_v<P>, "Unsupported bind key parameter type!" );
+				hash = Combine( hash, uint64_t( param ) );
+				check = CombineCheck( check, uint64_t( param ) );
+#ifndef NDEBUG
+				name += "#" + std::to_string( uint64_t( param ) );
+#endif
+			}
+			return *this;
+		}
+		uint64_t GetHash() const noexcept
+		{
+			return hash;
+		}
+		// readable form of the key - parameters are only listed in debug builds
+		std::string GetName() const noexcept
+		{
+#ifndef NDEBUG
+			return name;
+#else
+			return pType->name();
+#endif
+		}
+		bool operator==( const BindKey& rhs ) const noexcept(!IS_DEBUG)
+		{
+			const bool equal = hash == rhs.hash && check == rhs.check && *pType == *rhs.pType;
+			assert( "Bind key hash collision!" && ( !equal || name == rhs.name ) );
+			return equal;
+		}
+		struct Hasher
+		{
+			size_t operator()( const BindKey& key ) const noexcept
+			{
+				return size_t( key.hash );
+			}
+		};
+	private:
+		static uint64_t Combine( uint64_t hash, uint64_t value ) noexcept
+		{
+			// splitmix64 finalizer spreads small values (slots, flags) over all bits before mixing
+			value += 0x9e3779b97f4a7c15ull;
+			value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+			value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebull;
+			value ^= value >> 31;
+			return hash ^ ( value + 0x9e3779b97f4a7c15ull + ( hash << 6 ) + ( hash >> 2 ) );
+		}
+		static uint64_t CombineCheck( uint64_t check, uint64_t value ) noexcept
+		{
+			// murmur3 finalizer and a rotate-multiply step - different constants and structure from Combine
+			value ^= 0xc2b2ae3d27d4eb4full;
+			value = ( value ^ ( value >> 33 ) ) * 0xff51afd7ed558ccdull;
+			value = ( value ^ ( value >> 33 ) ) * 0xc4ceb9fe1a85ec53ull;
+			value ^= value >> 33;
+			return ( ( check << 27 | check >> 37 ) ^ value ) * 0x9ddfea08eb382d69ull;
+		}
+		static uint64_t HashString( std::string_view str ) noexcept
+		{
+			// 64-bit FNV-1a
+			uint64_t h = 14695981039346656037ull;
+			for ( const auto c : str )
+			{
+				h ^= uint64_t( (unsigned char)c );
+				h *= 1099511628211ull;
+			}
+			return h;
+		}
+		static uint64_t CheckString( std::string_view str ) noexcept
+		{
+			// multiply-add polynomial over the bytes, seeded with the length
+			uint64_t h = uint64_t( str.size() ) * 0x9e3779b97f4a7c15ull;
+			for ( const auto c : str )
+			{
+				h = ( h + uint64_t( (unsigned char)c ) + 1u ) * 0xd6e8feb86659fd93ull;
+			}
+			return h;
+		}
+	private:
+		const std::type_info* pType;
+		uint64_t hash;
+		uint64_t check;
+#ifndef NDEBUG
+		std::string name;
+#endif
+	};
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "GraphicsResource.h"
+#include "BindKey.h"
 
 class Drawable;
 class TechniqueProbe;
@@ -13,10 +14,21 @@ namespace Bind
 		virtual void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) = 0;
 		virtual void InitializeParentReference( const Drawable& ) noexcept {};
 		virtual void Accept( TechniqueProbe& ) { }
-		virtual std::string GetUID() const noexcept
+		virtual BindKey GetKey() const noexcept(!IS_DEBUG)
 		{
 			assert( false );
-			return "";
+			return { typeid( *this ) };
+		}
+		// approximate bytes of device memory owned - counted against the codex budget
+		virtual size_t GetSizeInBytes() const noexcept
+		{
+			return 0u;
+		}
+		// true if binding other instead of this would leave the pipeline in the same state
+		// lets the render queue merge the draws of separate drawables
+		virtual bool BindsSameStateAs( const Bindable& other ) const noexcept
+		{
+			return this == &other;
 		}
 		virtual ~Bindable() = default;
 	};
@@ -0,0 +1,149 @@
+#include "BindableCodex.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace Bind
+{
+	void Codex::Trim() noexcept(!IS_DEBUG)
+	{
+		auto& codex = Get();
+		codex.tick++;
+		const auto budget = codex.budget.load();
+		const auto resident = codex.bytesResident.load();
+		if ( resident <= budget )
+		{
+			return;
+		}
+
+		// an entry is unreferenced when the codex holds the only share on its bindable
+		// candidates keep their entry so it can be told apart from one resolved again under the same key
+		struct Candidate
+		{
+			size_t shard;
+			std::shared_ptr<const Entry> pEntry;
+			const BindKey* pKey;
+			uint64_t lastUse;
+		};
+		std::array<std::shared_ptr<const Map>, nShards> snapshots;
+		std::vector<Candidate> candidates;
+		for ( size_t s = 0; s < nShards; s++ )
+		{
+			snapshots[s] = codex.shards[s].snapshot.load();
+			for ( const auto& [key, pEntry] : *snapshots[s] )
+			{
+				if ( pEntry->pBind.use_count() == 1 )
+				{
+					candidates.push_back( { s, pEntry, &key, pEntry->lastUse.load( std::memory_order_relaxed ) } );
+				}
+			}
+		}
+
+		// least recently used first, until enough bytes are selected to get back under budget
+		std::sort( candidates.begin(), candidates.end(), []( const Candidate& lhs, const Candidate& rhs )
+		{
+			return lhs.lastUse < rhs.lastUse;
+		} );
+		std::array<std::vector<Candidate*>, nShards> victims;
+		size_t selected = 0u;
+		for ( auto& c : candidates )
+		{
+			if ( resident - selected <= budget )
+			{
+				break;
+			}
+			victims[c.shard].push_back( &c );
+			selected += c.pEntry->sizeInBytes;
+		}
+
+		for ( size_t s = 0; s < nShards; s++ )
+		{
+			if ( victims[s].empty() )
+			{
+				continue;
+			}
+			// misses take the writer lock before constructing, so holding it until every victim is settled
+			// means nothing can build a duplicate of a bindable that turns out to be re-acquired
+			auto& shard = codex.shards[s];
+			std::lock_guard lock{ shard.mutex };
+			auto next = std::make_shared<Map>( *shard.snapshot.load() );
+			std::vector<std::pair<BindKey, std::shared_ptr<const Entry>>> removed;
+			for ( const auto pVictim : victims[s] )
+			{
+				const auto i = next->find( *pVictim->pKey );
+				if ( i == next->end() || i->second != pVictim->pEntry || i->second->pBind.use_count() != 1 )
+				{
+					continue;
+				}
+				removed.emplace_back( i->first, std::move( pVictim->pEntry ) );
+				next->erase( i );
+			}
+			shard.snapshot.store( std::move( next ) );
+
+			// lookups still reading an older snapshot can pick a removed entry up until they let go of it
+			// so wait for every map holding the entries to be released before trusting the use count
+			// (the candidates of this shard have handed their shares over to removed above)
+			snapshots[s].reset();
+			for ( const auto& [key, pEntry] : removed )
+			{
+				while ( pEntry.use_count() > 1 )
+				{
+					std::this_thread::yield();
+				}
+			}
+			std::vector<std::pair<BindKey, std::shared_ptr<const Entry>>> reacquired;
+			for ( auto& [key, pEntry] : removed )
+			{
+				if ( pEntry->pBind.use_count() == 1 )
+				{
+					codex.bytesResident -= pEntry->sizeInBytes;
+					codex.bytesEvicted += pEntry->sizeInBytes;
+					codex.evictions++;
+				}
+				else
+				{
+					reacquired.emplace_back( std::move( key ), std::move( pEntry ) );
+				}
+			}
+			if ( !reacquired.empty() )
+			{
+				auto restored = std::make_shared<Map>( *shard.snapshot.load() );
+				for ( auto& [key, pEntry] : reacquired )
+				{
+					restored->emplace( std::move( key ), std::move( pEntry ) );
+				}
+				shard.snapshot.store( std::move( restored ) );
+			}
+		}
+	}
+
+	void Codex::SetBudget( size_t bytes ) noexcept
+	{
+		Get().budget = bytes;
+	}
+
+	Codex::Statistics Codex::GetStatistics() noexcept
+	{
+		auto& codex = Get();
+		Statistics stats;
+		for ( const auto& shard : codex.shards )
+		{
+			for ( const auto& [key, pEntry] : *shard.snapshot.load() )
+			{
+				stats.entries++;
+				if ( pEntry->pBind.use_count() == 1 )
+				{
+					stats.unreferenced++;
+					stats.bytesUnreferenced += pEntry->sizeInBytes;
+				}
+			}
+		}
+		stats.bytesResident = codex.bytesResident;
+		stats.budget = codex.budget;
+		stats.hits = codex.hits;
+		stats.misses = codex.misses;
+		stats.evictions = codex.evictions;
+		stats.bytesEvicted = codex.bytesEvicted;
+		return stats;
+	}
+}
\ No newline at end of file
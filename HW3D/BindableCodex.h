@@ -3,34 +3,134 @@
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <array>
+#include <typeinfo>
 
 namespace Bind
 {
+	// thread-safe registry of shared bindables
+	// hits read an immutable snapshot of one shard and never take a lock
+	// concurrent misses on the same key construct the bindable once - the other threads wait on its future
+	// entries nothing else references are kept as a cache and evicted least recently used first once over budget
 	class Codex
 	{
+	public:
+		struct Statistics
+		{
+			size_t entries = 0u;
+			size_t unreferenced = 0u;
+			size_t bytesResident = 0u;
+			size_t bytesUnreferenced = 0u;
+			size_t budget = 0u;
+			size_t hits = 0u;
+			size_t misses = 0u;
+			size_t evictions = 0u;
+			size_t bytesEvicted = 0u;
+		};
 	public:
 		template<class T, typename...Params>
-		static std::shared_ptr<T> Resolve( Graphics& gfx, Params&&...p ) noexcept(IS_DEBUG)
+		static std::shared_ptr<T> Resolve( Graphics& gfx, Params&&...p ) noexcept(!IS_DEBUG)
 		{
 			static_assert( std::is_base_of<Bindable, T>::value, "Can only resolve classes derived from Bindable!" );
 			return Get().Resolve_<T>( gfx, std::forward<Params>( p )... );
 		}
+		// evict unreferenced entries until the resident bytes fit the budget - call once per frame
+		static void Trim() noexcept(!IS_DEBUG);
+		static void SetBudget( size_t bytes ) noexcept;
+		static Statistics GetStatistics() noexcept;
+	private:
+		struct Entry
+		{
+			std::shared_ptr<Bindable> pBind;
+			size_t sizeInBytes;
+			// trim tick of the most recent resolve
+			mutable std::atomic<uint64_t> lastUse;
+		};
+		using Map = std::unordered_map<BindKey, std::shared_ptr<const Entry>, BindKey::Hasher>;
+		struct Shard
+		{
+			// readers load the current snapshot, writers copy it, modify and publish the copy
+			std::atomic<std::shared_ptr<const Map>> snapshot{ std::make_shared<const Map>() };
+			// serializes writers and guards the constructions in flight
+			std::mutex mutex;
+			std::unordered_map<BindKey, std::shared_future<std::shared_ptr<Bindable>>, BindKey::Hasher> pending;
+		};
+		// every insert copies its shard's map, so enough shards keep each copy a small slice of the codex
+		static constexpr size_t nShards = 64u;
+		static constexpr size_t defaultBudget = 256u * 1024u * 1024u;
 	private:
 		template<class T, typename...Params>
 		std::shared_ptr<T> Resolve_( Graphics& gfx, Params&&...p ) noexcept(!IS_DEBUG)
 		{
-			const auto key = T::GenerateUID( std::forward<Params>( p )... );
-			const auto i = binds.find( key );
-			if ( i == binds.end() )
+			const auto key = T::GenerateKey( std::forward<Params>( p )... );
+			// low bits select the bucket inside the shard map so shard on the high bits
+			auto& shard = shards[( key.GetHash() >> 58 ) % nShards];
+			if ( auto bind = Find( shard, key ) )
 			{
-				auto bind = std::make_shared<T>( gfx, std::forward<Params>( p )... );
-				binds[key] = bind;
-				return bind;
+				return std::static_pointer_cast<T>( bind );
 			}
-			else
+
+			std::promise<std::shared_ptr<Bindable>> promise;
+			{
+				std::unique_lock lock{ shard.mutex };
+				// may have been published between loading the snapshot and taking the lock
+				if ( auto bind = Find( shard, key ) )
+				{
+					return std::static_pointer_cast<T>( bind );
+				}
+				// another thread is already constructing this bindable
+				if ( const auto i = shard.pending.find( key ); i != shard.pending.end() )
+				{
+					auto future = i->second;
+					lock.unlock();
+					hits++;
+					return std::static_pointer_cast<T>( future.get() );
+				}
+				shard.pending.emplace( key, promise.get_future().share() );
+			}
+
+			// construct outside of the lock so misses on other keys in this shard are not held up
+			std::shared_ptr<T> bind;
+			try
+			{
+				bind = std::make_shared<T>( gfx, std::forward<Params>( p )... );
+			}
+			catch ( ... )
+			{
+				std::lock_guard lock{ shard.mutex };
+				shard.pending.erase( key );
+				promise.set_exception( std::current_exception() );
+				throw;
+			}
+			const auto sizeInBytes = bind->GetSizeInBytes();
+			{
+				std::lock_guard lock{ shard.mutex };
+				auto next = std::make_shared<Map>( *shard.snapshot.load() );
+				next->emplace( key, std::make_shared<const Entry>( bind, sizeInBytes, tick.load( std::memory_order_relaxed ) ) );
+				shard.snapshot.store( std::move( next ) );
+				shard.pending.erase( key );
+			}
+			misses++;
+			bytesResident += sizeInBytes;
+			if ( const auto pLog = gfx.GetLog() )
+				pLog->Add( CommandLog::Type::Create, typeid( T ).name(), 0u, sizeInBytes, bind.get() );
+			promise.set_value( bind );
+			return bind;
+		}
+		std::shared_ptr<Bindable> Find( const Shard& shard, const BindKey& key ) noexcept(!IS_DEBUG)
+		{
+			const auto pMap = shard.snapshot.load();
+			const auto i = pMap->find( key );
+			if ( i == pMap->end() )
 			{
-				return std::static_pointer_cast<T>( i->second );
+				return nullptr;
 			}
+			i->second->lastUse.store( tick.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+			hits++;
+			return i->second->pBind;
 		}
 		static Codex& Get()
 		{
@@ -38,6 +138,13 @@ namespace Bind
 			return codex;
 		}
 	private:
-		std::unordered_map<std::string, std::shared_ptr<Bindable>> binds;
+		std::array<Shard, nShards> shards;
+		std::atomic<uint64_t> tick = 0u;
+		std::atomic<size_t> budget = defaultBudget;
+		std::atomic<size_t> bytesResident = 0u;
+		std::atomic<size_t> hits = 0u;
+		std::atomic<size_t> misses = 0u;
+		std::atomic<size_t> evictions = 0u;
+		std::atomic<size_t> bytesEvicted = 0u;
 	};
 }
\ No newline at end of file
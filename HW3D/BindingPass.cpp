@@ -24,6 +24,11 @@ namespace Rgph
 		}
 	}
 
+	const std::vector<std::shared_ptr<Bind::Bindable>>& BindingPass::GetBinds() const noexcept
+	{
+		return binds;
+	}
+
 	void BindingPass::Finalize()
 	{
 		Pass::Finalize();
@@ -15,6 +15,7 @@ namespace Rgph
 		BindingPass(std::string name, std::vector<std::shared_ptr<Bind::Bindable>> binds = {});
 		void AddBind(std::shared_ptr<Bind::Bindable> bind) noexcept;
 		void BindAll(Graphics& gfx) const noexcept(!IS_DEBUG);
+		const std::vector<std::shared_ptr<Bind::Bindable>>& GetBinds() const noexcept;
 		void Finalize() override;
 	protected:
 		template<class T>
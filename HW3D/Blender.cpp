@@ -26,7 +26,7 @@ namespace Bind
 
 	void Blender::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->OMSetBlendState( pBlender.Get(), nullptr, 0xFFFFFFFFu ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).OMSetBlendState( pBlender.Get() ) );
 	}
 
 	std::shared_ptr<Blender> Blender::Resolve( Graphics& gfx, bool blending )
@@ -34,14 +34,13 @@ namespace Bind
 		return Codex::Resolve<Blender>( gfx, blending );
 	}
 
-	std::string Blender::GenerateUID( bool blending )
+	BindKey Blender::GenerateKey( bool blending )
 	{
-		using namespace std::string_literals;
-		return typeid( Blender ).name() + "#"s + ( blending ? "b" : "n" );
+		return BindKey::Make<Blender>( blending );
 	}
 
-	std::string Blender::GetUID() const noexcept
+	BindKey Blender::GetKey() const noexcept(!IS_DEBUG)
 	{
-		return GenerateUID( blending );
+		return GenerateKey( blending );
 	}
 }
\ No newline at end of file
@@ -10,8 +10,8 @@ namespace Bind
 		Blender( Graphics& gfx, bool blending );
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		static std::shared_ptr<Blender> Resolve( Graphics& gfx, bool blending );
-		static std::string GenerateUID( bool blending );
-		std::string GetUID() const noexcept override;
+		static BindKey GenerateKey( bool blending );
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
 	private:
 		Microsoft::WRL::ComPtr<ID3D11BlendState> pBlender;
 		bool blending;
@@ -18,9 +18,9 @@ namespace Rgph
 	{
 	public:
 		BlurOutlineDrawPass(Graphics& gfx, std::string name, unsigned int width, unsigned int height) :
-			RenderQueuePass(std::move(name))
+			RenderQueuePass(std::move(name), {}, SortPolicy::State)
 		{
-			renderTarget = std::make_unique<Bind::ShaderInputRenderTarget>(gfx, width / 2, height / 2, 0);
+			RequestTransient(renderTarget, width / 2, height / 2, 0, "scratchOut");
 			AddBind(Bind::VertexShader::Resolve(gfx, "SolidVS.cso"));
 			AddBind(Bind::PixelShader::Resolve(gfx, "SolidPS.cso"));
 			AddBind(Bind::Stencil::Resolve(gfx, Bind::Stencil::Mode::Mask));
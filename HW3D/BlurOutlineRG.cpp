@@ -61,21 +61,25 @@ namespace Rgph
 		// setup blur constant buffers
 		{
 			{
-				Dcb::RawLayout layout;
-				layout.Add<Dcb::Integer>("nTaps");
-				layout.Add<Dcb::Array>("coefficients");
-				layout["coefficients"].Set<Dcb::Float>(maxRadius * 2 + 1);
-				Dcb::Buffer buf{ std::move(layout) };
+				Dcb::Buffer buf{ KernelLayout::Get() };
+				kernelTaps = KernelLayout::Handle<"nTaps">();
+				kernelCoefficients = KernelLayout::Handle<"coefficients">();
 				blurKernel = std::make_shared<Bind::CachingPixelConstantBufferEx>(gfx, buf, 0);
 				SetKernelGauss(radius, sigma);
 				AddGlobalSource(DirectBindableSource<Bind::CachingPixelConstantBufferEx>::Make("blurKernel", blurKernel));
 			}
+			// one per direction, so that neither blur pass has to rewrite a buffer the other one binds
 			{
-				Dcb::RawLayout layout;
-				layout.Add<Dcb::Bool>("isHorizontal");
-				Dcb::Buffer buf{ std::move(layout) };
-				blurDirection = std::make_shared<Bind::CachingPixelConstantBufferEx>(gfx, buf, 1);
-				AddGlobalSource(DirectBindableSource<Bind::CachingPixelConstantBufferEx>::Make("blurDirection", blurDirection));
+				Dcb::Buffer buf{ DirectionLayout::Get() };
+				buf["isHorizontal"] = true;
+				blurHorizontal = std::make_shared<Bind::CachingPixelConstantBufferEx>(gfx, buf, 1);
+				AddGlobalSource(DirectBindableSource<Bind::CachingPixelConstantBufferEx>::Make("blurHorizontal", blurHorizontal));
+			}
+			{
+				Dcb::Buffer buf{ DirectionLayout::Get() };
+				buf["isHorizontal"] = false;
+				blurVertical = std::make_shared<Bind::CachingPixelConstantBufferEx>(gfx, buf, 1);
+				AddGlobalSource(DirectBindableSource<Bind::CachingPixelConstantBufferEx>::Make("blurVertical", blurVertical));
 			}
 		}
 
@@ -88,7 +92,7 @@ namespace Rgph
 			auto pass = std::make_unique<HorizontalBlurPass>("horizontal", gfx, gfx.GetWidth(), gfx.GetHeight());
 			pass->SetSinkLinkage("scratchIn", "outlineDraw.scratchOut");
 			pass->SetSinkLinkage("kernel", "$.blurKernel");
-			pass->SetSinkLinkage("direction", "$.blurDirection");
+			pass->SetSinkLinkage("direction", "$.blurHorizontal");
 			AppendPass(std::move(pass));
 		}
 
@@ -98,7 +102,7 @@ namespace Rgph
 			pass->SetSinkLinkage("depthStencil", "outlineMask.depthStencil");
 			pass->SetSinkLinkage("scratchIn", "horizontal.scratchOut");
 			pass->SetSinkLinkage("kernel", "$.blurKernel");
-			pass->SetSinkLinkage("direction", "$.blurDirection");
+			pass->SetSinkLinkage("direction", "$.blurVertical");
 			AppendPass(std::move(pass));
 		}
 
@@ -110,7 +114,7 @@ namespace Rgph
 		}
 		SetSinkTarget("backbuffer", "wireframe.renderTarget");
 
-		Finalize();
+		Finalize(gfx);
 	}
 
 	void BlurOutlineRG::RenderKernelWindow( Graphics& gfx )
@@ -162,7 +166,7 @@ namespace Rgph
 		assert( radius <= maxRadius );
 		auto kernel = blurKernel->GetBuffer();
 		const int nTaps = radius * 2 + 1;
-		kernel["nTaps"] = nTaps;
+		kernel[kernelTaps] = nTaps;
 		float sum = 0.0f;
 		
 		for ( int i = 0; i < nTaps; i++ )
@@ -170,11 +174,11 @@ namespace Rgph
 			const auto x = float(i - radius);
 			const auto g = gauss(x, sigma);
 			sum += g;
-			kernel["coefficients"][i] = g;
+			kernel[kernelCoefficients[i]] = g;
 		}
 		
 		for ( int i = 0; i < nTaps; i++ )
-			kernel["coefficients"][i] = (float)kernel["coefficients"][i] / sum;
+			kernel[kernelCoefficients[i]] /= sum;
 
 		blurKernel->SetBuffer( kernel );
 	}
@@ -184,11 +188,11 @@ namespace Rgph
 		assert( radius <= maxRadius );
 		auto kernel = blurKernel->GetBuffer();
 		const int nTaps = radius * 2 + 1;
-		kernel["nTaps"] = nTaps;
+		kernel[kernelTaps] = nTaps;
 		const float coefficients = 1.0f / nTaps;
 		
 		for ( int i = 0; i < nTaps; i++ )
-			kernel["coefficients"][i] = coefficients;
+			kernel[kernelCoefficients[i]] = coefficients;
 
 		blurKernel->SetBuffer( kernel );
 	}
@@ -204,4 +208,9 @@ namespace Rgph
 		dynamic_cast<ShadowMappingPass&>( FindPassByName( "shadowMap" ) ).BindShadowCamera( cam );
 		dynamic_cast<LambertianPass&>( FindPassByName( "lambertian" ) ).BindShadowCamera( cam );
 	}
+
+	void BlurOutlineRG::BindLight( PointLight& light )
+	{
+		dynamic_cast<LambertianPass&>( FindPassByName( "lambertian" ) ).BindLight( light );
+	}
 }
\ No newline at end of file
@@ -1,10 +1,12 @@
 #pragma once
 #include "RenderGraph.h"
 #include "ConstantBufferEx.h"
+#include "StaticLayout.h"
 #include <memory>
 
 class Camera;
 class Graphics;
+class PointLight;
 
 namespace Bind
 {
@@ -23,6 +25,7 @@ namespace Rgph
 		void RenderKernelWindow( Graphics& gfx );
 		void BindMainCamera( Camera& cam );
 		void BindShadowCamera( Camera& cam );
+		void BindLight( PointLight& light );
 	private:
 		void SetKernelGauss( int radius, float sigma ) noexcept(!IS_DEBUG);
 		void SetKernelBox( int radius ) noexcept(!IS_DEBUG);
@@ -32,9 +35,17 @@ namespace Rgph
 			Box
 		} kernelType = KernelType::Gauss;
 		static constexpr int maxRadius = 7;
+		using KernelLayout = Dcb::StaticLayout<
+			Dcb::Field<Dcb::Integer, "nTaps">,
+			Dcb::ArrayField<Dcb::Float, maxRadius * 2 + 1, "coefficients">
+		>;
+		using DirectionLayout = Dcb::StaticLayout<Dcb::Field<Dcb::Bool, "isHorizontal">>;
 		int radius = 4;
 		float sigma = 2.0f;
 		std::shared_ptr<Bind::CachingPixelConstantBufferEx> blurKernel;
-		std::shared_ptr<Bind::CachingPixelConstantBufferEx> blurDirection;
+		Dcb::FieldHandle<int> kernelTaps;
+		Dcb::FieldHandle<float> kernelCoefficients;
+		std::shared_ptr<Bind::CachingPixelConstantBufferEx> blurHorizontal;
+		std::shared_ptr<Bind::CachingPixelConstantBufferEx> blurVertical;
 	};
 }
\ No newline at end of file
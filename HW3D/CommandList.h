@@ -0,0 +1,20 @@
+#pragma once
+#include <functional>
+
+class Graphics;
+
+namespace Rgph
+{
+	// list a single pass records its binds and draws into, possibly on another thread
+	// lists are created by Graphics, so each backend provides its own - a deferred context on d3d11
+	class CommandList
+	{
+	public:
+		virtual ~CommandList() = default;
+		// runs the commands with every bind and draw of the calling thread going into this list
+		// recording starts from the view set on gfx, the fullscreen viewport and otherwise default pipeline state
+		virtual void Record( Graphics& gfx, const std::function<void()>& commands ) = 0;
+		// plays the recorded commands back on the immediate context and empties the list - main thread only
+		virtual void Execute( Graphics& gfx ) = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "CommandLog.h"
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+
+void CommandLog::Add( Type type, const char* name, unsigned int slot, size_t count, const void* pObject, const void* pData, size_t dataSize )
+{
+	std::lock_guard lock( mutex );
+	entries.push_back( { type, name, slot, count, pObject, data.size(), dataSize } );
+	const auto pBytes = static_cast<const unsigned char*>( pData );
+	data.insert( data.end(), pBytes, pBytes + dataSize );
+}
+
+void CommandLog::Append( const CommandLog& other )
+{
+	auto appended = other.GetEntries();
+	const auto appendedData = other.GetData();
+	std::lock_guard lock( mutex );
+	for ( auto& e : appended )
+	{
+		e.dataOffset += data.size();
+	}
+	entries.insert( entries.end(), appended.begin(), appended.end() );
+	data.insert( data.end(), appendedData.begin(), appendedData.end() );
+}
+
+void CommandLog::Clear() noexcept
+{
+	std::lock_guard lock( mutex );
+	// keeps the capacity - headless runs log every frame
+	entries.clear();
+	data.clear();
+}
+
+std::vector<CommandLog::Entry> CommandLog::GetEntries() const
+{
+	std::lock_guard lock( mutex );
+	return entries;
+}
+
+std::vector<unsigned char> CommandLog::GetData() const
+{
+	std::lock_guard lock( mutex );
+	return data;
+}
+
+size_t CommandLog::Count( Type type ) const noexcept
+{
+	std::lock_guard lock( mutex );
+	return size_t( std::count_if( entries.begin(), entries.end(), [type]( const Entry& e ) { return e.type == type; } ) );
+}
+
+std::string CommandLog::Dump() const
+{
+	static constexpr const char* typeNames[] = { "create", "bind", "upload", "clear", "draw" };
+	std::unordered_map<const void*, size_t> ids;
+	std::ostringstream oss;
+	for ( const auto& e : GetEntries() )
+	{
+		oss << typeNames[size_t( e.type )] << ' ' << e.name << " slot " << e.slot << " count " << e.count;
+		if ( e.pObject )
+		{
+			oss << " #" << ids.emplace( e.pObject, ids.size() ).first->second;
+		}
+		oss << std::endl;
+	}
+	return oss.str();
+}
+
+uint64_t CommandLog::GetFingerprint() const
+{
+	// fnv-1a
+	uint64_t hash = 14695981039346656037ull;
+	for ( const auto c : Dump() )
+	{
+		hash = ( hash ^ uint8_t( c ) ) * 1099511628211ull;
+	}
+	return hash;
+}
\ No newline at end of file
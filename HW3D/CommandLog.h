@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// in-memory record of the work graphics was asked to do - kept by headless graphics in place of rendering
+// holds enough to count, compare and diff the commands of a frame, and with their arguments to capture it for replay
+class CommandLog
+{
+public:
+	enum class Type
+	{
+		Create,
+		Bind,
+		Upload,
+		Clear,
+		Draw
+	};
+	struct Entry
+	{
+		Type type;
+		// static string naming the call, or the type of the object created
+		const char* name;
+		// pipeline slot - or the value standing in for one, like the instance count of an instanced draw
+		unsigned int slot;
+		// indices for draws, bytes for uploads and creations
+		size_t count;
+		// object bound, written, cleared or created - only meaningful within one run
+		const void* pObject;
+		// arguments beyond the object and slot, like uploaded bytes or a clear color - kept in the log's data
+		size_t dataOffset;
+		size_t dataSize;
+	};
+public:
+	CommandLog() = default;
+	CommandLog( const CommandLog& ) = delete;
+	CommandLog& operator=( const CommandLog& ) = delete;
+	// safe to call from any thread - resources can be created while passes record
+	void Add( Type type, const char* name, unsigned int slot = 0u, size_t count = 0u, const void* pObject = nullptr, const void* pData = nullptr, size_t dataSize = 0u );
+	// appends the entries of a log another context was recorded with
+	void Append( const CommandLog& other );
+	void Clear() noexcept;
+	std::vector<Entry> GetEntries() const;
+	// arguments of all entries - each entry's lie at its data offset
+	std::vector<unsigned char> GetData() const;
+	size_t Count( Type type ) const noexcept;
+	// one line per entry with objects numbered in order of first use, so dumps of two runs can be diffed
+	std::string Dump() const;
+	// hash of the dump - equal for runs that issued the same work
+	uint64_t GetFingerprint() const;
+private:
+	mutable std::mutex mutex;
+	std::vector<Entry> entries;
+	std::vector<unsigned char> data;
+};
\ No newline at end of file
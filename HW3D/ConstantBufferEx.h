@@ -3,11 +3,22 @@
 #include "DynamicConstant.h"
 #include "GraphicsThrowMacros.h"
 #include "TechniqueProbe.h"
+#include <mutex>
 
 namespace Bind
 {
 	class ConstantBufferEx : public Bindable
 	{
+	public:
+		// accounting of dynamic constant buffer traffic - reset once per frame by the app
+		struct UploadStatistics
+		{
+			size_t uploads = 0u;
+			size_t skips = 0u;
+			size_t bytesUploaded = 0u;
+			size_t bytesDirty = 0u;
+			size_t bytesSkipped = 0u;
+		};
 	public:
 		void Update( Graphics& gfx, const Dcb::Buffer& buf )
 		{
@@ -22,11 +33,42 @@ namespace Bind
 				0u,
 				&msr
 			) );
+			// write-discard leaves the previous contents undefined, so the whole buffer is always written
 			memcpy( msr.pData, buf.GetData(), buf.GetSizeInBytes() );
 			GetContext( gfx )->Unmap( pConstantBuffer.Get(), 0u );
+			if ( const auto pLog = gfx.GetLog() )
+				pLog->Add( CommandLog::Type::Upload, "ConstantBufferEx", slot, buf.GetSizeInBytes(), pConstantBuffer.Get(), buf.GetData(), buf.GetSizeInBytes() );
+
+			std::lock_guard lock( StatisticsMutex() );
+			auto& stats = GetStatistics();
+			stats.uploads++;
+			stats.bytesUploaded += buf.GetSizeInBytes();
+			stats.bytesDirty += buf.GetDirtyTracker().GetDirtyBytes();
 		}
 		virtual const Dcb::LayoutElement& GetRootLayoutElement() const noexcept = 0;
+		static UploadStatistics& GetStatistics() noexcept
+		{
+			static UploadStatistics stats;
+			return stats;
+		}
+		static void ResetStatistics() noexcept
+		{
+			GetStatistics() = {};
+		}
 	protected:
+		// buffers are bound from every thread that records a pass
+		static std::mutex& StatisticsMutex() noexcept
+		{
+			static std::mutex mutex;
+			return mutex;
+		}
+		static void RecordSkippedUpdate( size_t bytes ) noexcept
+		{
+			std::lock_guard lock( StatisticsMutex() );
+			auto& stats = GetStatistics();
+			stats.skips++;
+			stats.bytesSkipped += bytes;
+		}
 		ConstantBufferEx(Graphics& gfx, const Dcb::LayoutElement& layoutRoot, UINT slot, const Dcb::Buffer* pBuf)
 			:
 			slot(slot)
@@ -64,7 +106,7 @@ namespace Bind
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override
 		{
 			INFOMANAGER_NOHR( gfx );
-			GFX_THROW_INFO_ONLY( GetContext( gfx )->PSSetConstantBuffers( slot, 1u, pConstantBuffer.GetAddressOf() ) );
+			GFX_THROW_INFO_ONLY( GetStateCache( gfx ).PSSetConstantBuffer( slot, pConstantBuffer.Get() ) );
 		}
 	};
 
@@ -75,7 +117,7 @@ namespace Bind
 		void Bind(Graphics& gfx) noexcept(!IS_DEBUG) override
 		{
 			INFOMANAGER_NOHR( gfx );
-			GFX_THROW_INFO_ONLY( GetContext(gfx)->VSSetConstantBuffers(slot, 1u, pConstantBuffer.GetAddressOf()) );
+			GFX_THROW_INFO_ONLY( GetStateCache(gfx).VSSetConstantBuffer(slot, pConstantBuffer.Get()) );
 		}
 	};
 
@@ -87,12 +129,18 @@ namespace Bind
 			:
 			T(gfx, *layout.ShareRoot(), slot, nullptr),
 			buf(Dcb::Buffer(layout))
-		{}
+		{
+			// gpu buffer was created without initial data
+			buf.MarkAllDirty();
+		}
 		CachingConstantBufferEx(Graphics& gfx, const Dcb::Buffer& buf, UINT slot)
 			:
 			T(gfx, buf.GetRootLayoutElement(), slot, &buf),
 			buf(buf)
-		{}
+		{
+			// gpu buffer was initialized with the contents of buf
+			this->buf.ClearDirty();
+		}
 		const Dcb::LayoutElement& GetRootLayoutElement() const noexcept override
 		{
 			return buf.GetRootLayoutElement();
@@ -104,24 +152,41 @@ namespace Bind
 		void SetBuffer(const Dcb::Buffer& buf_in)
 		{
 			buf.CopyFrom(buf_in);
-			bufferSet = true;
 		}
 		void Bind(Graphics& gfx) noexcept(!IS_DEBUG) override
 		{
-			if (bufferSet)
+			if (buf.IsDirty())
 			{
 				T::Update(gfx, buf);
-				bufferSet = false;
+				// passes recorded concurrently may all bind this buffer and any of their lists can replay first
+				// so each of them uploads it, and it only counts as clean once everything recorded has been replayed
+				GraphicsResource::DeferUntilReplayed(gfx, [this] { buf.ClearDirty(); });
+			}
+			else
+			{
+				T::RecordSkippedUpdate(buf.GetSizeInBytes());
 			}
 			T::Bind(gfx);
 		}
+		bool BindsSameStateAs( const Bindable& other ) const noexcept override
+		{
+			// a separate buffer holding the same constants at the same slot is interchangeable
+			if ( this == &other )
+				return true;
+			const auto pOther = dynamic_cast<const CachingConstantBufferEx*>( &other );
+			return pOther != nullptr && pOther->slot == this->slot &&
+				&pOther->GetRootLayoutElement() == &GetRootLayoutElement() &&
+				memcmp( pOther->buf.GetData(), buf.GetData(), buf.GetSizeInBytes() ) == 0;
+		}
 		void Accept( TechniqueProbe& probe ) override
 		{
-			if ( probe.VisitBuffer( buf ) )
-				bufferSet = true;
+			// probes write through pointers which dirties every field they visit
+			// so roll back to the previous state if the probe reports no change
+			const auto dirtyBefore = buf.GetDirtyTracker();
+			if ( !probe.VisitBuffer( buf ) )
+				buf.RestoreDirty( dirtyBefore );
 		}
 	private:
-		bool bufferSet = false;
 		Dcb::Buffer buf;
 	};
 
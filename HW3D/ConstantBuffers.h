@@ -17,6 +17,8 @@ namespace Bind
 			GFX_THROW_INFO( GetContext( gfx )->Map( pConstantBuffer.Get(), 0u, D3D11_MAP_WRITE_DISCARD, 0u, &msr ) );
 			memcpy( msr.pData, &consts, sizeof( consts ) );
 			GetContext( gfx )->Unmap( pConstantBuffer.Get(), 0u );
+			if ( const auto pLog = gfx.GetLog() )
+				pLog->Add( CommandLog::Type::Upload, "ConstantBuffer", slot, sizeof( consts ), pConstantBuffer.Get(), &consts, sizeof( consts ) );
 		}
 		ConstantBuffer( Graphics& gfx, const C& consts, UINT slot = 0u ) : slot( slot )
 		{
@@ -47,6 +49,10 @@ namespace Bind
 			cbd.StructureByteStride = 0u;
 			GetDevice( gfx )->CreateBuffer( &cbd, nullptr, &pConstantBuffer );
 		}
+		size_t GetSizeInBytes() const noexcept override
+		{
+			return sizeof( C );
+		}
 	protected:
 		Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
 		UINT slot;
@@ -64,7 +70,7 @@ namespace Bind
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override
 		{
 			INFOMANAGER_NOHR( gfx );
-			GFX_THROW_INFO_ONLY( GetContext( gfx )->VSSetConstantBuffers( slot, 1u, pConstantBuffer.GetAddressOf() ) );
+			GFX_THROW_INFO_ONLY( GetStateCache( gfx ).VSSetConstantBuffer( slot, pConstantBuffer.Get() ) );
 		}
 		static std::shared_ptr<VertexConstantBuffer> Resolve( Graphics& gfx, const C& consts, UINT slot = 0 )
 		{
@@ -74,18 +80,17 @@ namespace Bind
 		{
 			return Codex::Resolve<VertexConstantBuffer>( gfx, slot );
 		}
-		static std::string GenerateUID( const C&, UINT slot )
+		static BindKey GenerateKey( const C&, UINT slot )
 		{
-			return GenerateUID( slot );
+			return GenerateKey( slot );
 		}
-		static std::string GenerateUID( UINT slot = 0 )
+		static BindKey GenerateKey( UINT slot = 0 )
 		{
-			using namespace std::string_literals;
-			return typeid( VertexConstantBuffer ).name() + "#"s + std::to_string( slot );
+			return BindKey::Make<VertexConstantBuffer>( slot );
 		}
-		std::string GetUID() const noexcept override
+		BindKey GetKey() const noexcept(!IS_DEBUG) override
 		{
-			return GenerateUID( slot );
+			return GenerateKey( slot );
 		}
 	};
 
@@ -101,7 +106,7 @@ namespace Bind
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override
 		{
 			INFOMANAGER_NOHR( gfx );
-			GFX_THROW_INFO_ONLY( GetContext( gfx )->PSSetConstantBuffers( slot, 1u, pConstantBuffer.GetAddressOf() ) );
+			GFX_THROW_INFO_ONLY( GetStateCache( gfx ).PSSetConstantBuffer( slot, pConstantBuffer.Get() ) );
 		}
 		static std::shared_ptr<PixelConstantBuffer> Resolve( Graphics& gfx, const C& consts, UINT slot = 0 )
 		{
@@ -111,18 +116,17 @@ namespace Bind
 		{
 			return Codex::Resolve<PixelConstantBuffer>( gfx, slot );
 		}
-		static std::string GenerateUID( const C&, UINT slot )
+		static BindKey GenerateKey( const C&, UINT slot )
 		{
-			return GenerateUID( slot );
+			return GenerateKey( slot );
 		}
-		static std::string GenerateUID( UINT slot = 0 )
+		static BindKey GenerateKey( UINT slot = 0 )
 		{
-			using namespace std::string_literals;
-			return typeid( PixelConstantBuffer ).name() + "#"s + std::to_string( slot );
+			return BindKey::Make<PixelConstantBuffer>( slot );
 		}
-		std::string GetUID() const noexcept override
+		BindKey GetKey() const noexcept(!IS_DEBUG) override
 		{
-			return GenerateUID( slot );
+			return GenerateKey( slot );
 		}
 	};
 }
\ No newline at end of file
@@ -58,7 +58,7 @@ namespace Bind
 	void CubeTexture::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER_NOHR( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->PSSetShaderResources( slot, 1u, pTextureView.GetAddressOf() ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).PSSetShaderResource( slot, pTextureView.Get() ) );
 	}
 
 	CubeTargetTexture::CubeTargetTexture( Graphics& gfx,UINT width,UINT height,UINT slot,DXGI_FORMAT format )
@@ -107,7 +107,7 @@ namespace Bind
 	void CubeTargetTexture::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER_NOHR( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->PSSetShaderResources( slot,1u,pTextureView.GetAddressOf() ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).PSSetShaderResource( slot,pTextureView.Get() ) );
 	}
 
 	std::shared_ptr<OutputOnlyRenderTarget> Bind::CubeTargetTexture::GetRenderTarget( size_t index ) const
@@ -0,0 +1,61 @@
+#include "DeferredCommandList.h"
+#include "GraphicsThrowMacros.h"
+
+namespace Rgph
+{
+	DeferredCommandList::DeferredCommandList( Graphics& gfx )
+		:
+		pDeferredContext( CreateContext( gfx ) ),
+		stateCache( pDeferredContext.Get() )
+	{}
+
+	void DeferredCommandList::Record( Graphics& gfx, const std::function<void()>& commands )
+	{
+		INFOMANAGER( gfx );
+		// finishing the previous list put the deferred context back into default state
+		stateCache.Invalidate();
+		// logging can be switched on and off between frames
+		stateCache.SetLog( gfx.GetLog() ? &log : nullptr );
+		{
+			Graphics::Recording recording( gfx, pDeferredContext.Get(), stateCache, afterReplay );
+			commands();
+		}
+		// no state is carried over into the next list - every pass binds what it draws with
+		GFX_THROW_INFO( pDeferredContext->FinishCommandList( FALSE, &pCommandList ) );
+	}
+
+	void DeferredCommandList::Execute( Graphics& gfx )
+	{
+		INFOMANAGER_NOHR( gfx );
+		if ( pCommandList )
+		{
+			GFX_THROW_INFO_ONLY( GetContext( gfx )->ExecuteCommandList( pCommandList.Get(), FALSE ) );
+			pCommandList.Reset();
+		}
+
+		// the immediate context is left in default state, which its cache cannot know about
+		auto& immediateCache = GetStateCache( gfx );
+		immediateCache.Invalidate();
+		immediateCache.AddStatistics( stateCache.GetStatistics() );
+		stateCache.ResetStatistics();
+		if ( const auto pLog = gfx.GetLog() )
+		{
+			pLog->Append( log );
+		}
+		log.Clear();
+
+		for ( auto& action : afterReplay )
+		{
+			action();
+		}
+		afterReplay.clear();
+	}
+
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext> DeferredCommandList::CreateContext( Graphics& gfx )
+	{
+		INFOMANAGER( gfx );
+		Microsoft::WRL::ComPtr<ID3D11DeviceContext> pContext;
+		GFX_THROW_INFO( GetDevice( gfx )->CreateDeferredContext( 0u, &pContext ) );
+		return pContext;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+#include "CommandList.h"
+#include "GraphicsResource.h"
+#include <vector>
+
+namespace Rgph
+{
+	// d3d11 command list - the pass records into a deferred context of its own and the immediate context executes the result
+	class DeferredCommandList : public CommandList, public GraphicsResource
+	{
+	public:
+		DeferredCommandList( Graphics& gfx );
+		void Record( Graphics& gfx, const std::function<void()>& commands ) override;
+		void Execute( Graphics& gfx ) override;
+	private:
+		static Microsoft::WRL::ComPtr<ID3D11DeviceContext> CreateContext( Graphics& gfx );
+	private:
+		Microsoft::WRL::ComPtr<ID3D11DeviceContext> pDeferredContext;
+		Microsoft::WRL::ComPtr<ID3D11CommandList> pCommandList;
+		StateCache stateCache;
+		// entries of this pass - added to the frame's log in replay order while gfx keeps one
+		CommandLog log;
+		std::vector<std::function<void()>> afterReplay;
+	};
+}
\ No newline at end of file
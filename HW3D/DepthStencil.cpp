@@ -95,7 +95,7 @@ namespace Bind
 
 	void DepthStencil::BindAsBuffer( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
-		GetContext( gfx )->OMSetRenderTargets( 0, nullptr, pDepthStencilView.Get() );
+		GetStateCache( gfx ).OMSetRenderTargets( 0, nullptr, pDepthStencilView.Get() );
 	}
 
 	void DepthStencil::BindAsBuffer( Graphics& gfx, BufferResource* renderTarget ) noexcept(!IS_DEBUG)
@@ -112,6 +112,8 @@ namespace Bind
 	void DepthStencil::Clear( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		GetContext( gfx )->ClearDepthStencilView( pDepthStencilView.Get(),D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL,1.0f,0u );
+		if ( const auto pLog = gfx.GetLog() )
+			pLog->Add( CommandLog::Type::Clear, "ClearDepthStencilView", 0u, 0u, pDepthStencilView.Get() );
 	}
 
 
@@ -240,7 +242,7 @@ namespace Bind
 
 	void ShaderInputDepthStencil::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
-		GetContext( gfx )->PSSetShaderResources( slot,1u,pShaderResourceView.GetAddressOf() );
+		GetStateCache( gfx ).PSSetShaderResource( slot,pShaderResourceView.Get() );
 	}
 
 	OutputOnlyDepthStencil::OutputOnlyDepthStencil( Graphics& gfx, Microsoft::WRL::ComPtr<ID3D11Texture2D> pTexture, UINT face ) :
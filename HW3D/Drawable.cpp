@@ -8,19 +8,31 @@
 using namespace Bind;
 
 Drawable::Drawable( Graphics& gfx, const Material& mat, const aiMesh& mesh, float scale ) noexcept
-{
-	pVertices = mat.MakeVertexBindable( gfx, mesh, scale );
-	pIndices = mat.MakeIndexBindable( gfx, mesh );
-	pTopology = Bind::Topology::Resolve( gfx );
+	:
+	Drawable( gfx, mat, mat.ExtractGeometry( mesh, scale ) )
+{}
+
+Drawable::Drawable( Graphics& gfx, const Material& mat, MeshGeometry&& geometry ) noexcept
+	:
+	Drawable( gfx, mat,
+		Bind::VertexBuffer::Resolve( gfx, geometry.tag, std::move( geometry.vertices ) ),
+		Bind::IndexBuffer::Resolve( gfx, geometry.tag, std::move( geometry.indices ) ) )
+{}
 
+Drawable::Drawable( Graphics& gfx, const Material& mat, std::shared_ptr<Bind::VertexBuffer> pVertices_in, std::shared_ptr<Bind::IndexBuffer> pIndices_in ) noexcept
+	:
+	pIndices( std::move( pIndices_in ) ),
+	pTopology( Bind::Topology::Resolve( gfx ) ),
+	pVertices( std::move( pVertices_in ) )
+{
 	for ( auto& t : mat.GetTechniques() )
 		AddTechnique( std::move( t ) );
 }
 
-void Drawable::Submit( size_t channelFilter ) const noexcept
+void Drawable::Submit( size_t channelFilter, const DirectX::XMFLOAT4X4* pTransform ) const noexcept
 {
 	for ( const auto& tech : techniques )
-		tech.Submit( *this, channelFilter );
+		tech.Submit( *this, channelFilter, pTransform );
 }
 
 void Drawable::AddTechnique( Technique tech_in ) noexcept
@@ -47,6 +59,11 @@ UINT Drawable::GetIndexCount() const noexcept(!IS_DEBUG)
 	return pIndices->GetCount();
 }
 
+bool Drawable::SharesGeometry( const Drawable& other ) const noexcept
+{
+	return pVertices == other.pVertices && pIndices == other.pIndices && pTopology == other.pTopology;
+}
+
 void Drawable::LinkTechniques( Rgph::RenderGraph& rg )
 {
 	for ( auto& tech : techniques )
@@ -5,6 +5,7 @@
 
 class TechniqueProbe;
 class Material;
+struct MeshGeometry;
 struct aiMesh;
 
 namespace Rgph
@@ -26,12 +27,18 @@ public:
 	Drawable() = default;
 	Drawable( const Drawable& ) = delete;
 	Drawable( Graphics& gfx, const Material& mat, const aiMesh& mesh, float scale = 1.0f ) noexcept;
+	// geometry extracted beforehand, possibly on another thread
+	Drawable( Graphics& gfx, const Material& mat, MeshGeometry&& geometry ) noexcept;
+	Drawable( Graphics& gfx, const Material& mat, std::shared_ptr<Bind::VertexBuffer> pVertices, std::shared_ptr<Bind::IndexBuffer> pIndices ) noexcept;
 	void AddTechnique( Technique tech_in ) noexcept;
 	virtual DirectX::XMMATRIX GetTransformXM() const noexcept = 0;
-	void Submit( size_t channelFilter ) const noexcept;
+	// pTransform stands in for GetTransformXM() in the submitted jobs - for drawables shared by several nodes
+	void Submit( size_t channelFilter, const DirectX::XMFLOAT4X4* pTransform = nullptr ) const noexcept;
 	void Bind( Graphics& gfx ) const noexcept(!IS_DEBUG);
 	void Accept( TechniqueProbe& );
 	UINT GetIndexCount() const noexcept(!IS_DEBUG);
+	// same vertex and index buffers and topology - the condition for drawing both with one instanced draw
+	bool SharesGeometry( const Drawable& other ) const noexcept;
 	void LinkTechniques( Rgph::RenderGraph& );
 	virtual ~Drawable();
 protected:
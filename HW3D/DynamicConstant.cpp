@@ -39,11 +39,68 @@ namespace Dcb
 		}
 	}
 
+	uint64_t LayoutElement::GetHash() const noexcept(!IS_DEBUG)
+	{
+		// same information that goes into the signature, folded in the same order
+		auto hash = HashCombine( 0u, uint64_t( type ) );
+		switch ( type )
+		{
+#define X( element ) case element: return hash;
+			LEAF_ELEMENT_TYPES
+#undef X
+		case Struct:
+			for ( const auto& el : static_cast<ExtraData::Struct&>( *pExtraData ).layoutElements )
+			{
+				hash = HashCombine( hash, FlatLayout::HashName( el.first ) );
+				hash = HashCombine( hash, el.second.GetHash() );
+			}
+			return hash;
+		case Array:
+		{
+			const auto& data = static_cast<ExtraData::Array&>( *pExtraData );
+			hash = HashCombine( hash, data.size );
+			return HashCombine( hash, data.layoutElement->GetHash() );
+		}
+		default:
+			assert( "Bad type in hash generation!" && false );
+			return 0u;
+		}
+	}
+
+	bool LayoutElement::StructurallyEquals( const LayoutElement& other ) const noexcept(!IS_DEBUG)
+	{
+		if ( type != other.type )
+		{
+			return false;
+		}
+		if ( type == Struct )
+		{
+			const auto& lhs = static_cast<ExtraData::Struct&>( *pExtraData ).layoutElements;
+			const auto& rhs = static_cast<ExtraData::Struct&>( *other.pExtraData ).layoutElements;
+			return std::equal( lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), []( const auto& l, const auto& r )
+			{
+				return l.first == r.first && l.second.StructurallyEquals( r.second );
+			} );
+		}
+		if ( type == Array )
+		{
+			const auto& lhs = static_cast<ExtraData::Array&>( *pExtraData );
+			const auto& rhs = static_cast<ExtraData::Array&>( *other.pExtraData );
+			return lhs.size == rhs.size && lhs.layoutElement->StructurallyEquals( *rhs.layoutElement );
+		}
+		return true;
+	}
+
 	bool LayoutElement::Exists() const noexcept
 	{
 		return type != Empty;
 	}
 
+	Type LayoutElement::GetType() const noexcept
+	{
+		return type;
+	}
+
 	std::pair<size_t, const LayoutElement*> LayoutElement::CalculateIndexingOffset( size_t offset, size_t index ) const noexcept(!IS_DEBUG)
 	{
 		assert( "Indexing into non-array!" && type == Array );
@@ -79,6 +136,18 @@ namespace Dcb
 		return const_cast<LayoutElement&>( *this ).T();
 	}
 
+	size_t LayoutElement::GetArrayLength() const noexcept(!IS_DEBUG)
+	{
+		assert( "Accessing length of non-array!" && type == Array );
+		return static_cast<ExtraData::Array&>( *pExtraData ).size;
+	}
+
+	size_t LayoutElement::GetArrayStride() const noexcept(!IS_DEBUG)
+	{
+		assert( "Accessing stride of non-array!" && type == Array );
+		return static_cast<ExtraData::Array&>( *pExtraData ).element_size;
+	}
+
 	size_t LayoutElement::GetOffsetBegin() const noexcept(!IS_DEBUG)
 	{
 		return *offset;
@@ -211,22 +280,14 @@ namespace Dcb
 		return GetOffsetEnd();
 	}
 
-	bool LayoutElement::CrossesBoundary(size_t offset, size_t size) noexcept
-	{
-		const auto end = offset + size;
-		const auto pageStart = offset / 16u;
-		const auto pageEnd = end / 16u;
-		return (pageStart != pageEnd && end % 16 != 0u) || size > 16u;
-	}
-
-	size_t LayoutElement::AdvanceIfCrossesBoundary(size_t offset, size_t size) noexcept
-	{
-		return CrossesBoundary(offset, size) ? AdvanceToBoundary(offset) : offset;
-	}
-
-	size_t LayoutElement::AdvanceToBoundary(size_t offset) noexcept
+	uint64_t LayoutElement::HashCombine( uint64_t hash, uint64_t value ) noexcept
 	{
-		return offset + (16u - offset % 16u) % 16u;
+		// splitmix64 finalizer spreads small values (types, sizes) over all bits before mixing
+		value += 0x9e3779b97f4a7c15ull;
+		value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+		value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebull;
+		value ^= value >> 31;
+		return hash ^ ( value + 0x9e3779b97f4a7c15ull + ( hash << 6 ) + ( hash >> 2 ) );
 	}
 
 	bool LayoutElement::ValidateSymbolName(const std::string& name) noexcept
@@ -239,6 +300,99 @@ namespace Dcb
 		);
 	}
 
+	/***** FLAT LAYOUT *****/
+	FlatLayout::FlatLayout( const LayoutElement& root, uint64_t hash ) noexcept(!IS_DEBUG)
+		:
+		hash( hash ),
+		signature( root.GetSignature() )
+	{
+		assert( root.type == Struct );
+		// reserved empty element returned for failed lookups
+		nodes.emplace_back();
+#ifndef NDEBUG
+		names.emplace_back();
+#endif
+		PushNode( root, 0u, "" );
+		BakeChildren( rootIndex, root );
+	}
+
+	size_t FlatLayout::Member( size_t index, const std::string& key ) const noexcept(!IS_DEBUG)
+	{
+		const auto& node = nodes[index];
+		assert( "Keying into non-struct!" && node.type == Struct );
+		const auto hash = HashName( key );
+		const auto end = node.firstChild + node.childCount;
+		for ( size_t i = node.firstChild; i < end; i++ )
+		{
+			if ( nodes[i].nameHash == hash )
+			{
+				assert( "Name hash collision in layout!" && names[i] == key );
+				return i;
+			}
+		}
+		return emptyIndex;
+	}
+
+	size_t FlatLayout::GetSizeInBytes() const noexcept
+	{
+		return nodes[rootIndex].size;
+	}
+
+	uint64_t FlatLayout::HashName( const std::string& name ) noexcept
+	{
+		// 64-bit FNV-1a
+		uint64_t hash = 14695981039346656037ull;
+		for ( const auto c : name )
+		{
+			hash ^= uint64_t( (unsigned char)c );
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	void FlatLayout::BakeChildren( size_t index, const LayoutElement& element ) noexcept(!IS_DEBUG)
+	{
+		// children of a node are pushed as one contiguous block, then each child bakes its own children
+		if ( element.type == Struct )
+		{
+			const auto& data = static_cast<ExtraData::Struct&>( *element.pExtraData );
+			const auto first = nodes.size();
+			nodes[index].firstChild = uint32_t( first );
+			nodes[index].childCount = uint32_t( data.layoutElements.size() );
+			for ( const auto& el : data.layoutElements )
+			{
+				PushNode( el.second, HashName( el.first ), el.first );
+			}
+			for ( size_t i = 0; i < data.layoutElements.size(); i++ )
+			{
+				BakeChildren( first + i, data.layoutElements[i].second );
+			}
+		}
+		else if ( element.type == Array )
+		{
+			const auto& data = static_cast<ExtraData::Array&>( *element.pExtraData );
+			const auto first = nodes.size();
+			nodes[index].firstChild = uint32_t( first );
+			nodes[index].childCount = uint32_t( data.size );
+			nodes[index].stride = uint32_t( data.element_size );
+			PushNode( *data.layoutElement, 0u, "" );
+			BakeChildren( first, *data.layoutElement );
+		}
+	}
+
+	void FlatLayout::PushNode( const LayoutElement& element, uint64_t nameHash, const std::string& name ) noexcept(!IS_DEBUG)
+	{
+		Node node;
+		node.type = element.type;
+		node.offset = uint32_t( element.GetOffsetBegin() );
+		node.size = uint32_t( element.GetSizeInBytes() );
+		node.nameHash = nameHash;
+		nodes.push_back( node );
+#ifndef NDEBUG
+		names.push_back( name );
+#endif
+	}
+
 	/***** LAYOUT *****/
 	Layout::Layout(std::shared_ptr<LayoutElement> pRoot) noexcept
 		:
@@ -255,6 +409,11 @@ namespace Dcb
 		return pRoot->GetSignature();
 	}
 
+	uint64_t Layout::GetHash() const noexcept(!IS_DEBUG)
+	{
+		return pRoot->GetHash();
+	}
+
 	/***** RAW LAYOUT *****/
 	RawLayout::RawLayout() noexcept
 		:
@@ -280,9 +439,10 @@ namespace Dcb
 	}
 
 	/***** COMPLETE LAYOUT *****/
-	CompleteLayout::CompleteLayout(std::shared_ptr<LayoutElement> pRoot) noexcept
+	CompleteLayout::CompleteLayout(std::shared_ptr<LayoutElement> pRoot, std::shared_ptr<const FlatLayout> pFlat) noexcept
 		:
-		Layout(std::move(pRoot))
+		Layout(std::move(pRoot)),
+		pFlat(std::move(pFlat))
 	{}
 
 	std::shared_ptr<LayoutElement> CompleteLayout::RelinquishRoot() const noexcept
@@ -290,31 +450,93 @@ namespace Dcb
 		return std::move(pRoot);
 	}
 
+	const std::string& CompleteLayout::GetSignature() const noexcept
+	{
+		return pFlat->GetSignature();
+	}
+
+	uint64_t CompleteLayout::GetHash() const noexcept
+	{
+		return pFlat->GetHash();
+	}
+
 	std::shared_ptr<LayoutElement> CompleteLayout::ShareRoot() const noexcept
 	{
 		return pRoot;
 	}
 
+	std::shared_ptr<const FlatLayout> CompleteLayout::ShareFlat() const noexcept
+	{
+		return pFlat;
+	}
+
 	const LayoutElement& CompleteLayout::operator[](const std::string& key) const noexcept(!IS_DEBUG)
 	{
 		return (*pRoot)[key];
 	}
 
+	/***** DIRTY TRACKER *****/
+	DirtyTracker::DirtyTracker( size_t sizeInBytes ) noexcept
+		:
+		nRegisters( ( sizeInBytes + registerSize - 1u ) / registerSize ),
+		registers( ( nRegisters + 63u ) / 64u, 0u )
+	{}
+
+	void DirtyTracker::Mark( size_t offset, size_t size ) noexcept(!IS_DEBUG)
+	{
+		assert( size != 0u );
+		const auto last = ( offset + size - 1u ) / registerSize;
+		assert( last < nRegisters );
+		for ( auto r = offset / registerSize; r <= last; r++ )
+		{
+			registers[r / 64u] |= uint64_t( 1u ) << ( r % 64u );
+		}
+	}
+
+	void DirtyTracker::MarkAll() noexcept
+	{
+		for ( size_t r = 0; r < nRegisters; r++ )
+		{
+			registers[r / 64u] |= uint64_t( 1u ) << ( r % 64u );
+		}
+	}
+
+	void DirtyTracker::Clear() noexcept
+	{
+		std::fill( registers.begin(), registers.end(), 0u );
+	}
+
+	bool DirtyTracker::IsDirty() const noexcept
+	{
+		return std::any_of( registers.begin(), registers.end(), []( uint64_t w ) { return w != 0u; } );
+	}
+
+	size_t DirtyTracker::GetDirtyBytes() const noexcept
+	{
+		size_t count = 0u;
+		for ( size_t r = 0; r < nRegisters; r++ )
+		{
+			if ( ( registers[r / 64u] >> ( r % 64u ) ) & 1u )
+				count++;
+		}
+		return count * registerSize;
+	}
+
 	/***** CONST ELEMENT REF *****/
 	bool ConstElementRef::Exists() const noexcept
 	{
-		return pLayout->Exists();
+		return pLayout->Exists(index);
 	}
 
 	ConstElementRef ConstElementRef::operator[](const std::string& key) const noexcept(!IS_DEBUG)
 	{
-		return { &(*pLayout)[key],pBytes,offset };
+		return { pLayout,pLayout->Member(index, key),pBytes,offset };
 	}
 
-	ConstElementRef ConstElementRef::operator[](size_t index) const noexcept(!IS_DEBUG)
+	ConstElementRef ConstElementRef::operator[](size_t arrayIndex) const noexcept(!IS_DEBUG)
 	{
-		const auto indexingData = pLayout->CalculateIndexingOffset(offset, index);
-		return { indexingData.second,pBytes,indexingData.first };
+		const auto indexingData = pLayout->Element(index, offset, arrayIndex);
+		return { pLayout,indexingData.first,pBytes,indexingData.second };
 	}
 
 	ConstElementRef::Pointer ConstElementRef::operator&() const noexcept(!IS_DEBUG)
@@ -322,11 +544,12 @@ namespace Dcb
 		return Pointer{ this };
 	}
 
-	ConstElementRef::ConstElementRef(const LayoutElement* pLayout, const char* pBytes, size_t offset) noexcept
+	ConstElementRef::ConstElementRef(const FlatLayout* pLayout, size_t index, const char* pBytes, size_t offset) noexcept
 		:
 		offset(offset),
+		pBytes(pBytes),
 		pLayout(pLayout),
-		pBytes(pBytes)
+		index(index)
 	{}
 
 	ConstElementRef::Pointer::Pointer(const ConstElementRef* ref) noexcept : ref(ref)
@@ -335,23 +558,23 @@ namespace Dcb
 	/***** ELEMENT REF *****/
 	ElementRef::operator ConstElementRef() const noexcept
 	{
-		return { pLayout,pBytes,offset };
+		return { pLayout,index,pBytes,offset };
 	}
 
 	bool ElementRef::Exists() const noexcept
 	{
-		return pLayout->Exists();
+		return pLayout->Exists(index);
 	}
 
 	ElementRef ElementRef::operator[](const std::string& key) const noexcept(!IS_DEBUG)
 	{
-		return { &(*pLayout)[key],pBytes,offset };
+		return { pLayout,pLayout->Member(index, key),pBytes,pDirty,offset };
 	}
 
-	ElementRef ElementRef::operator[](size_t index) const noexcept(!IS_DEBUG)
+	ElementRef ElementRef::operator[](size_t arrayIndex) const noexcept(!IS_DEBUG)
 	{
-		const auto indexingData = pLayout->CalculateIndexingOffset(offset, index);
-		return { indexingData.second,pBytes,indexingData.first };
+		const auto indexingData = pLayout->Element(index, offset, arrayIndex);
+		return { pLayout,indexingData.first,pBytes,pDirty,indexingData.second };
 	}
 
 	ElementRef::Pointer ElementRef::operator&() const noexcept(!IS_DEBUG)
@@ -359,11 +582,13 @@ namespace Dcb
 		return Pointer{ const_cast<ElementRef*>(this) };
 	}
 
-	ElementRef::ElementRef(const LayoutElement* pLayout, char* pBytes, size_t offset) noexcept
+	ElementRef::ElementRef(const FlatLayout* pLayout, size_t index, char* pBytes, DirtyTracker* pDirty, size_t offset) noexcept
 		:
+		pBytes(pBytes),
 		offset(offset),
 		pLayout(pLayout),
-		pBytes(pBytes)
+		index(index),
+		pDirty(pDirty)
 	{}
 
 	ElementRef::Pointer::Pointer(ElementRef* ref) noexcept : ref(ref)
@@ -378,35 +603,43 @@ namespace Dcb
 	Buffer::Buffer(const CompleteLayout& lay) noexcept(!IS_DEBUG)
 		:
 		pLayoutRoot(lay.ShareRoot()),
-		bytes(pLayoutRoot->GetOffsetEnd())
+		pFlatLayout(lay.ShareFlat()),
+		bytes(pLayoutRoot->GetOffsetEnd()),
+		dirty(bytes.size())
 	{}
 
 	Buffer::Buffer(CompleteLayout&& lay) noexcept(!IS_DEBUG)
 		:
 		pLayoutRoot(lay.RelinquishRoot()),
-		bytes(pLayoutRoot->GetOffsetEnd())
+		pFlatLayout(lay.ShareFlat()),
+		bytes(pLayoutRoot->GetOffsetEnd()),
+		dirty(bytes.size())
 	{}
 
 	Buffer::Buffer(const Buffer& buf) noexcept
 		:
 		pLayoutRoot(buf.pLayoutRoot),
-		bytes(buf.bytes)
+		pFlatLayout(buf.pFlatLayout),
+		bytes(buf.bytes),
+		dirty(buf.dirty)
 	{}
 
 	Buffer::Buffer(Buffer&& buf) noexcept
 		:
 		pLayoutRoot(std::move(buf.pLayoutRoot)),
-		bytes(std::move(buf.bytes))
+		pFlatLayout(std::move(buf.pFlatLayout)),
+		bytes(std::move(buf.bytes)),
+		dirty(std::move(buf.dirty))
 	{}
 
 	ElementRef Buffer::operator[](const std::string& key) noexcept(!IS_DEBUG)
 	{
-		return { &(*pLayoutRoot)[key],bytes.data(),0u };
+		return { pFlatLayout.get(),pFlatLayout->Member(FlatLayout::rootIndex, key),bytes.data(),&dirty,0u };
 	}
 
 	ConstElementRef Buffer::operator[](const std::string& key) const noexcept(!IS_DEBUG)
 	{
-		return const_cast<Buffer&>(*this)[key];
+		return { pFlatLayout.get(),pFlatLayout->Member(FlatLayout::rootIndex, key),bytes.data(),0u };
 	}
 
 	const char* Buffer::GetData() const noexcept
@@ -427,7 +660,42 @@ namespace Dcb
 	void Buffer::CopyFrom(const Buffer& other) noexcept(!IS_DEBUG)
 	{
 		assert(&GetRootLayoutElement() == &other.GetRootLayoutElement());
-		std::copy(other.bytes.begin(), other.bytes.end(), bytes.begin());
+		// compare register by register so that unchanged registers stay clean
+		constexpr size_t registerSize = 16u;
+		for (size_t offset = 0u; offset < bytes.size(); offset += registerSize)
+		{
+			const auto size = std::min(registerSize, bytes.size() - offset);
+			if (!std::equal(bytes.begin() + offset, bytes.begin() + offset + size, other.bytes.begin() + offset))
+			{
+				std::copy_n(other.bytes.begin() + offset, size, bytes.begin() + offset);
+				dirty.Mark(offset, size);
+			}
+		}
+	}
+
+	bool Buffer::IsDirty() const noexcept
+	{
+		return dirty.IsDirty();
+	}
+
+	const DirtyTracker& Buffer::GetDirtyTracker() const noexcept
+	{
+		return dirty;
+	}
+
+	void Buffer::MarkAllDirty() noexcept
+	{
+		dirty.MarkAll();
+	}
+
+	void Buffer::ClearDirty() noexcept
+	{
+		dirty.Clear();
+	}
+
+	void Buffer::RestoreDirty(const DirtyTracker& tracker) noexcept
+	{
+		dirty = tracker;
 	}
 
 	std::shared_ptr<LayoutElement> Buffer::ShareLayoutRoot() const noexcept
@@ -5,6 +5,7 @@
 #include <vector>
 #include <memory>
 #include <optional>
+#include <cstdint>
 
 #define LEAF_ELEMENT_TYPES \
 	X( Float ) \
@@ -113,10 +114,17 @@ namespace Dcb
 			virtual ~ExtraDataBase() = default;
 		};
 		friend class RawLayout;
+		friend class FlatLayout;
 		friend struct ExtraData;
+		friend struct StaticPacking;
 	public:
 		std::string GetSignature() const noexcept(!IS_DEBUG);
+		// 64-bit hash of the same structure the signature describes - built without any string allocation
+		uint64_t GetHash() const noexcept(!IS_DEBUG);
+		// true if both trees would produce the same signature
+		bool StructurallyEquals( const LayoutElement& other ) const noexcept(!IS_DEBUG);
 		bool Exists() const noexcept;
+		Type GetType() const noexcept;
 		// calculate the array indexing offset
 		std::pair<size_t, const LayoutElement*> CalculateIndexingOffset( size_t offset, size_t index ) const noexcept(!IS_DEBUG);
 		
@@ -127,6 +135,9 @@ namespace Dcb
 		// T() only works for arrays - gets the array type layout
 		LayoutElement& T() noexcept(!IS_DEBUG);
 		const LayoutElement& T() const noexcept(!IS_DEBUG);
+		// only works for arrays - number of elements and byte distance between them
+		size_t GetArrayLength() const noexcept(!IS_DEBUG);
+		size_t GetArrayStride() const noexcept(!IS_DEBUG);
 		
 		// offset-based functions
 		size_t GetOffsetBegin() const noexcept(!IS_DEBUG);
@@ -180,6 +191,9 @@ namespace Dcb
 		size_t FinalizeForStruct( size_t offsetIn );
 		size_t FinalizeForArray( size_t offsetIn );
 
+		// fold a value into a running structural hash
+		static uint64_t HashCombine( uint64_t hash, uint64_t value ) noexcept;
+
 		// returns singleton instance of empty layout element
 		static LayoutElement& GetEmptyElement() noexcept
 		{
@@ -187,12 +201,25 @@ namespace Dcb
 			return empty;
 		}
 
+		// packing rules are constexpr so that StaticLayout can apply them at compile time
 		// returns value of offset up to next 16-byte boundary
-		static size_t AdvanceToBoundary( size_t offset ) noexcept;
+		static constexpr size_t AdvanceToBoundary( size_t offset ) noexcept
+		{
+			return offset + ( 16u - offset % 16u ) % 16u;
+		}
 		// return true if memory block crosses boundary
-		static bool CrossesBoundary( size_t offset, size_t size ) noexcept;
+		static constexpr bool CrossesBoundary( size_t offset, size_t size ) noexcept
+		{
+			const auto end = offset + size;
+			const auto pageStart = offset / 16u;
+			const auto pageEnd = end / 16u;
+			return ( pageStart != pageEnd && end % 16 != 0u ) || size > 16u;
+		}
 		// advance an offset to next boundary if block crosses
-		static size_t AdvanceIfCrossesBoundary( size_t offset, size_t size ) noexcept;
+		static constexpr size_t AdvanceIfCrossesBoundary( size_t offset, size_t size ) noexcept
+		{
+			return CrossesBoundary( offset, size ) ? AdvanceToBoundary( offset ) : offset;
+		}
 		// check string for validity as a struct key
 		static bool ValidateSymbolName( const std::string& name ) noexcept;
 	private:
@@ -202,6 +229,83 @@ namespace Dcb
 		std::unique_ptr<ExtraDataBase> pExtraData;
 	};
 
+	// contiguous, index-based bake of a finalized LayoutElement tree
+	// element refs navigate this table with a few integer ops instead of chasing pointers through the tree
+	// index 0 is reserved for the empty element and the root struct is always at index 1
+	class FlatLayout
+	{
+	public:
+		struct Node
+		{
+			Type type = Empty;
+			uint32_t offset = 0u;
+			uint32_t size = 0u;
+			// struct: index of first member and number of members (members of a struct are contiguous)
+			// array: index of the element node and number of elements
+			uint32_t firstChild = 0u;
+			uint32_t childCount = 0u;
+			// array: distance in bytes between consecutive elements
+			uint32_t stride = 0u;
+			// hash of the member name when node is a member of a struct
+			uint64_t nameHash = 0u;
+		};
+		static constexpr size_t emptyIndex = 0u;
+		static constexpr size_t rootIndex = 1u;
+	public:
+		FlatLayout( const LayoutElement& root, uint64_t hash ) noexcept(!IS_DEBUG);
+		bool Exists( size_t index ) const noexcept
+		{
+			return nodes[index].type != Empty;
+		}
+		// index of named member of struct node - returns emptyIndex if not found
+		size_t Member( size_t index, const std::string& key ) const noexcept(!IS_DEBUG);
+		// index of the element node of an array node and the byte offset of the indexed element
+		std::pair<size_t, size_t> Element( size_t index, size_t offset, size_t arrayIndex ) const noexcept(!IS_DEBUG)
+		{
+			const auto& node = nodes[index];
+			assert( "Indexing into non-array!" && node.type == Array );
+			assert( arrayIndex < node.childCount );
+			return { node.firstChild, offset + node.stride * arrayIndex };
+		}
+		// returns offset of leaf type for read/write
+		template<typename T>
+		size_t Resolve( size_t index ) const noexcept(!IS_DEBUG)
+		{
+			const auto& node = nodes[index];
+			switch ( node.type )
+			{
+#define X( element ) case element: assert( typeid( Map<element>::DynamicType ) == typeid( T ) ); return node.offset;
+			LEAF_ELEMENT_TYPES
+#undef X
+			default:
+				assert( "Tried to resolve non-leaf element!" && false );
+				return 0u;
+			}
+		}
+		size_t GetSizeInBytes() const noexcept;
+		uint64_t GetHash() const noexcept
+		{
+			return hash;
+		}
+		const std::string& GetSignature() const noexcept
+		{
+			return signature;
+		}
+		static uint64_t HashName( const std::string& name ) noexcept;
+	private:
+		void BakeChildren( size_t index, const LayoutElement& element ) noexcept(!IS_DEBUG);
+		void PushNode( const LayoutElement& element, uint64_t nameHash, const std::string& name ) noexcept(!IS_DEBUG);
+	private:
+		std::vector<Node> nodes;
+		// structural hash and signature are generated once per distinct layout - every buffer shares them
+		uint64_t hash;
+		std::string signature;
+#ifndef NDEBUG
+		// kept to catch name hash collisions
+		std::vector<std::string> names;
+#endif
+	};
+
 	// 1 - acts as a shell to hold the root of the LayoutElement tree
 	// 2 - create RawLayout and access and add elements from there
 	// 3 - when layout is complete, move to codex to finalize
@@ -213,6 +317,7 @@ namespace Dcb
 	public:
 		size_t GetSizeInBytes() const noexcept;
 		std::string GetSignature() const noexcept(!IS_DEBUG);
+		uint64_t GetHash() const noexcept(!IS_DEBUG);
 	protected:
 		Layout( std::shared_ptr<LayoutElement> pRoot ) noexcept;
 		std::shared_ptr<LayoutElement> pRoot;
@@ -227,6 +332,10 @@ namespace Dcb
 		// key into the root struct
 		LayoutElement& operator[]( const std::string& key ) noexcept(!IS_DEBUG);
 		// add element to root struct
+		LayoutElement& Add( Type type, const std::string& key ) noexcept(!IS_DEBUG)
+		{
+			return pRoot->Add( type, key );
+		}
 		template<Type type>
 		LayoutElement& Add( const std::string& key ) noexcept(!IS_DEBUG)
 		{
@@ -247,13 +356,40 @@ namespace Dcb
 	public:
 		// key into the root struct
 		const LayoutElement& operator[]( const std::string& key ) const noexcept(!IS_DEBUG);
+		// interned when the layout was registered - no regeneration
+		const std::string& GetSignature() const noexcept;
+		uint64_t GetHash() const noexcept;
 		// get a share on the layout tree root
 		std::shared_ptr<LayoutElement> ShareRoot() const noexcept;
+		// get a share on the flattened table baked from the tree
+		std::shared_ptr<const FlatLayout> ShareFlat() const noexcept;
 	private:
 		// used by Codex to return complete layout
-		CompleteLayout( std::shared_ptr<LayoutElement> pRoot ) noexcept;
+		CompleteLayout( std::shared_ptr<LayoutElement> pRoot, std::shared_ptr<const FlatLayout> pFlat ) noexcept;
 		// used to pilfer the layout tree
 		std::shared_ptr<LayoutElement> RelinquishRoot() const noexcept;
+		std::shared_ptr<const FlatLayout> pFlat;
+	};
+
+	// tracks which 16-byte hlsl registers of a buffer have been written since the last upload
+	// writes through mutable refs are recorded conservatively - any mutable access marks its register(s)
+	// so reads that should leave a buffer clean have to go through a const Buffer or a ConstElementRef
+	class DirtyTracker
+	{
+	public:
+		DirtyTracker( size_t sizeInBytes = 0u ) noexcept;
+		// mark the registers overlapped by a block of bytes
+		void Mark( size_t offset, size_t size ) noexcept(!IS_DEBUG);
+		void MarkAll() noexcept;
+		void Clear() noexcept;
+		bool IsDirty() const noexcept;
+		// number of bytes in dirty registers
+		size_t GetDirtyBytes() const noexcept;
+	private:
+		static constexpr size_t registerSize = 16u;
+		size_t nRegisters;
+		// one bit per register
+		std::vector<uint64_t> registers;
 	};
 
 	// proxy type used when indexing into a buffer element allowing for manipulation of raw bytes of the buffer
@@ -294,15 +430,17 @@ namespace Dcb
 		operator const T& () const noexcept(!IS_DEBUG)
 		{
 			static_assert( ReverseMap<std::remove_const_t<T>>::valid, "Unsupported DynamicType used in conversion!" );
-			return *reinterpret_cast<const T*>( pBytes + offset + pLayout->Resolve<T>() );
+			return *reinterpret_cast<const T*>( pBytes + offset + pLayout->Resolve<T>( index ) );
 		}
 	private:
 		// refs can only be constructed by other refs or the buffer
-		ConstElementRef( const LayoutElement* pLayout, const char* pBytes, size_t offset ) noexcept;
+		ConstElementRef( const FlatLayout* pLayout, size_t index, const char* pBytes, size_t offset ) noexcept;
 		// offset built up by indexing into arrays for every array index in the path of access to the struct
 		size_t offset;
 		const char* pBytes;
-		const LayoutElement* pLayout;
+		const FlatLayout* pLayout;
+		// index of the node in the flattened layout table
+		size_t index;
 	};
 
 	// copy of ConstElementRef that allows for writing to the bytes of Buffer
@@ -346,11 +484,17 @@ namespace Dcb
 
 		Pointer operator&() const noexcept(!IS_DEBUG);
 		// conversion for read/write as supported DynamicType
+		// only conversions to a mutable reference mark the register dirty
 		template<typename T>
 		operator T& () const noexcept(!IS_DEBUG)
 		{
 			static_assert( ReverseMap<std::remove_const_t<T>>::valid, "Unsupported DynamicType used in conversion!" );
-			return *reinterpret_cast<T*>( pBytes + offset + pLayout->Resolve<T>() );
+			const auto leafOffset = offset + pLayout->Resolve<std::remove_const_t<T>>( index );
+			if constexpr ( !std::is_const_v<T> )
+			{
+				pDirty->Mark( leafOffset, sizeof( T ) );
+			}
+			return *reinterpret_cast<T*>( pBytes + leafOffset );
 		}
 		// assignment for writing to as supported DynamicType
 		template<typename T>
@@ -361,10 +505,92 @@ namespace Dcb
 		}
 	private:
 		// refs can only be constructed by other refs or the Buffer
-		ElementRef( const LayoutElement* pLayout, char* pBytes, size_t offset ) noexcept;
+		ElementRef( const FlatLayout* pLayout, size_t index, char* pBytes, DirtyTracker* pDirty, size_t offset ) noexcept;
 		char* pBytes;
 		size_t offset;
-		const LayoutElement* pLayout;
+		const FlatLayout* pLayout;
+		size_t index;
+		// dirty state of the owning buffer
+		DirtyTracker* pDirty;
+	};
+
+	// typed accessor resolved once against a finalized layout
+	// stores the flat byte offset of a leaf so that reads/writes skip the string lookup and tree walk
+	// if the key names an array of T, the handle can be indexed to produce handles to its elements
+	template<typename T>
+	class FieldHandle
+	{
+		friend class Buffer;
+		template<typename...Fields>
+		friend class StaticLayout;
+		static_assert( ReverseMap<std::remove_const_t<T>>::valid, "Unsupported DynamicType used in FieldHandle!" );
+	public:
+		// construct empty handle - Exists() will return false
+		FieldHandle() noexcept = default;
+		// resolve key into the root struct of the layout
+		FieldHandle( const CompleteLayout& layout, const std::string& key ) noexcept(!IS_DEBUG)
+			:
+			FieldHandle( *layout.ShareRoot(), key )
+		{}
+		FieldHandle( const class Buffer& buf, const std::string& key ) noexcept(!IS_DEBUG);
+		// check if the key was found in the layout
+		bool Exists() const noexcept
+		{
+			return offset != invalidOffset;
+		}
+		// index into handle that was resolved against an array
+		FieldHandle operator[]( size_t index ) const noexcept(!IS_DEBUG)
+		{
+			assert( "Indexing into non-array handle!" && stride != 0u );
+			assert( index < length );
+			FieldHandle element{ *this };
+			element.offset = offset + stride * index;
+			element.stride = 0u;
+			element.length = 0u;
+			return element;
+		}
+	private:
+		FieldHandle( const LayoutElement& root, const std::string& key ) noexcept(!IS_DEBUG)
+		{
+			const auto& el = root[key];
+			if ( !el.Exists() )
+				return;
+
+			if ( el.GetType() == Array )
+			{
+				offset = el.T().Resolve<T>();
+				stride = el.GetArrayStride();
+				length = el.GetArrayLength();
+			}
+			else
+			{
+				offset = el.Resolve<T>();
+			}
+#ifndef NDEBUG
+			pLayoutRoot = &root;
+#endif
+		}
+		// used by StaticLayout where offsets are known at compile time
+		FieldHandle( const LayoutElement& root, size_t offset, size_t stride, size_t length ) noexcept
+			:
+			offset( offset ),
+			stride( stride ),
+			length( length )
+		{
+#ifndef NDEBUG
+			pLayoutRoot = &root;
+#endif
+		}
+	private:
+		static constexpr size_t invalidOffset = ~size_t( 0u );
+		size_t offset = invalidOffset;
+		// only non-zero for array handles
+		size_t stride = 0u;
+		size_t length = 0u;
+#ifndef NDEBUG
+		// used to catch handles being applied to a buffer with a different layout
+		const LayoutElement* pLayoutRoot = nullptr;
+#endif
 	};
 
 	// 1 - Buffer is a combination of a raw byte buffer with a LayoutElement tree structure
@@ -386,19 +612,64 @@ namespace Dcb
 		ElementRef operator[]( const std::string& key ) noexcept(!IS_DEBUG);
 		ConstElementRef operator[]( const std::string& key ) const noexcept(!IS_DEBUG);
 
+		// access through precompiled handle - no lookup, just an offset into the bytes
+		template<typename T>
+		T& operator[]( const FieldHandle<T>& handle ) noexcept(!IS_DEBUG)
+		{
+			assert( "Accessing buffer through empty handle!" && handle.Exists() );
+			assert( "Accessing array handle without index!" && handle.stride == 0u );
+			assert( "Handle was resolved against a different layout!" && handle.pLayoutRoot == pLayoutRoot.get() );
+			dirty.Mark( handle.offset, sizeof( T ) );
+			return *reinterpret_cast<T*>( bytes.data() + handle.offset );
+		}
+		template<typename T>
+		const T& operator[]( const FieldHandle<T>& handle ) const noexcept(!IS_DEBUG)
+		{
+			assert( "Accessing buffer through empty handle!" && handle.Exists() );
+			assert( "Accessing array handle without index!" && handle.stride == 0u );
+			assert( "Handle was resolved against a different layout!" && handle.pLayoutRoot == pLayoutRoot.get() );
+			return *reinterpret_cast<const T*>( bytes.data() + handle.offset );
+		}
+		// optionally set value if handle is not empty
+		template<typename T>
+		bool SetIfExists( const FieldHandle<T>& handle, const T& value ) noexcept(!IS_DEBUG)
+		{
+			if ( handle.Exists() )
+			{
+				( *this )[handle] = value;
+				return true;
+			}
+			return false;
+		}
+
 		// get the raw bytes
 		const char* GetData() const noexcept;
 		// get size of raw byte buffer
 		size_t GetSizeInBytes() const noexcept;
 		const LayoutElement& GetRootLayoutElement() const noexcept;
-		// copy bytes from another buffer
+		// copy bytes from another buffer - only registers whose contents differ are marked dirty
 		void CopyFrom( const Buffer& ) noexcept(!IS_DEBUG);
+		// dirty tracking of written registers since last upload
+		bool IsDirty() const noexcept;
+		const DirtyTracker& GetDirtyTracker() const noexcept;
+		void MarkAllDirty() noexcept;
+		void ClearDirty() noexcept;
+		// roll back dirty state to a previously captured one
+		void RestoreDirty( const DirtyTracker& tracker ) noexcept;
 		// return another shared_ptr to the layout root
 		std::shared_ptr<LayoutElement> ShareLayoutRoot() const noexcept;
 	private:
 		std::shared_ptr<LayoutElement> pLayoutRoot;
+		std::shared_ptr<const FlatLayout> pFlatLayout;
 		std::vector<char> bytes;
+		DirtyTracker dirty;
 	};
+
+	template<typename T>
+	FieldHandle<T>::FieldHandle( const Buffer& buf, const std::string& key ) noexcept(!IS_DEBUG)
+		:
+		FieldHandle( buf.GetRootLayoutElement(), key )
+	{}
 }
 
 #ifndef DCB_IMPL_SOURCE
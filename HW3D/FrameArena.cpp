@@ -0,0 +1,50 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cassert>
+
+namespace Rgph
+{
+	FrameArena::FrameArena( size_t capacity )
+		:
+		pBlock( std::make_unique<std::byte[]>( capacity ) ),
+		capacity( capacity )
+	{}
+
+	void* FrameArena::Allocate( size_t bytes, size_t alignment )
+	{
+		// blocks come from operator new so they already satisfy any fundamental alignment
+		assert( alignment != 0u && ( alignment & ( alignment - 1u ) ) == 0u );
+		assert( alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ );
+		std::lock_guard lock( mutex );
+		const auto aligned = ( offset + alignment - 1u ) & ~( alignment - 1u );
+		if ( aligned + bytes <= capacity )
+		{
+			offset = aligned + bytes;
+			return pBlock.get() + aligned;
+		}
+
+		// out of space - keep the frame going on the heap and remember to grow at the next reset
+		overflow.push_back( std::make_unique<std::byte[]>( bytes ) );
+		overflowBytes += bytes;
+		return overflow.back().get();
+	}
+
+	void FrameArena::Reset() noexcept
+	{
+		const auto used = offset + overflowBytes;
+		peak = std::max( peak, used );
+		if ( !overflow.empty() )
+		{
+			overflow.clear();
+			capacity = std::max( capacity * 2u, used );
+			pBlock = std::make_unique<std::byte[]>( capacity );
+		}
+		offset = 0u;
+		overflowBytes = 0u;
+	}
+
+	FrameArena::Statistics FrameArena::GetStatistics() const noexcept
+	{
+		return { offset + overflowBytes, std::max( peak, offset + overflowBytes ), capacity, overflow.size() };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+
+namespace Rgph
+{
+	// linear allocator for data that only lives until the end of the frame
+	// allocating bumps an offset and Reset() rewinds it - nothing is ever freed individually
+	class FrameArena
+	{
+	public:
+		struct Statistics
+		{
+			size_t bytesUsed = 0u;
+			size_t bytesPeak = 0u;
+			size_t capacity = 0u;
+			// heap blocks taken this frame because the main block ran out
+			size_t overflowBlocks = 0u;
+		};
+	public:
+		FrameArena( size_t capacity = 64u * 1024u );
+		FrameArena( const FrameArena& ) = delete;
+		FrameArena& operator=( const FrameArena& ) = delete;
+		// safe to call from passes that are recorded concurrently
+		void* Allocate( size_t bytes, size_t alignment );
+		// storage for count objects - only for types that need no destruction
+		template<typename T>
+		T* Allocate( size_t count )
+		{
+			static_assert( std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+				"Frame arena memory is rewound without running destructors!" );
+			return static_cast<T*>( Allocate( sizeof( T ) * count, alignof( T ) ) );
+		}
+		// invalidates every allocation - the main block is grown here so the next frame fits without overflowing
+		void Reset() noexcept;
+		Statistics GetStatistics() const noexcept;
+	private:
+		// queues allocate a few times per frame at most, so a plain lock costs nothing measurable
+		std::mutex mutex;
+		std::unique_ptr<std::byte[]> pBlock;
+		size_t capacity;
+		size_t offset = 0u;
+		std::vector<std::unique_ptr<std::byte[]>> overflow;
+		size_t overflowBytes = 0u;
+		size_t peak = 0u;
+	};
+}
\ No newline at end of file
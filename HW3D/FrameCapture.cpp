@@ -0,0 +1,890 @@
+#include "FrameCapture.h"
+#include "GraphicsThrowMacros.h"
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#define CAPTURE_EXCEPT( note ) FrameCapture::CaptureException( __LINE__, __FILE__, ( note ) )
+
+namespace
+{
+	// {8A0C5E55-3D0B-4F52-9A5E-6C1F0D2B7E41}
+	constexpr GUID creationDataGuid = { 0x8a0c5e55, 0x3d0b, 0x4f52, { 0x9a, 0x5e, 0x6c, 0x1f, 0x0d, 0x2b, 0x7e, 0x41 } };
+	constexpr char magic[8] = { 'H', 'W', '3', 'D', 'F', 'R', 'M', 'E' };
+	constexpr uint32_t version = 1u;
+
+	template<typename T>
+	void Append( std::vector<unsigned char>& bytes, const T& value )
+	{
+		const auto pBytes = reinterpret_cast<const unsigned char*>( &value );
+		bytes.insert( bytes.end(), pBytes, pBytes + sizeof( T ) );
+	}
+
+	// arguments are packed without alignment
+	template<typename T>
+	T Read( const unsigned char* pBytes ) noexcept
+	{
+		T value;
+		memcpy( &value, pBytes, sizeof( T ) );
+		return value;
+	}
+
+	template<typename T>
+	void Write( std::ostream& stream, const T& value )
+	{
+		stream.write( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+	}
+
+	template<typename T>
+	T Read( std::istream& stream )
+	{
+		T value{};
+		stream.read( reinterpret_cast<char*>( &value ), sizeof( T ) );
+		return value;
+	}
+
+	std::vector<unsigned char> GetCreationData( ID3D11DeviceChild* pObject )
+	{
+		UINT size = 0u;
+		pObject->GetPrivateData( creationDataGuid, &size, nullptr );
+		std::vector<unsigned char> bytes( size );
+		if ( size > 0u )
+		{
+			pObject->GetPrivateData( creationDataGuid, &size, bytes.data() );
+		}
+		return bytes;
+	}
+}
+
+FrameCapture::FrameCapture( Graphics& gfx, const CommandLog& log )
+	:
+	width( gfx.GetWidth() ),
+	height( gfx.GetHeight() )
+{
+	DirectX::XMStoreFloat4x4( &camera, gfx.GetCamera() );
+	DirectX::XMStoreFloat4x4( &projection, gfx.GetProjection() );
+
+	std::unordered_map<const void*, int32_t> ids;
+	const auto logData = log.GetData();
+	// the log without creations - replays create everything up front
+	CommandLog frame;
+	for ( const auto& e : log.GetEntries() )
+	{
+		if ( e.type == CommandLog::Type::Create )
+		{
+			continue;
+		}
+		const auto op = FindOp( e.name );
+		Command command{ op, e.slot, e.count, Describe( GetInfo( op ).kind, e.pObject, ids ), data.size(), 0u };
+		const auto pArgs = logData.data() + e.dataOffset;
+		if ( op == Op::OMSetRenderTargets )
+		{
+			// the views, then the depth view
+			for ( size_t i = 0; i <= e.slot; i++ )
+			{
+				const auto kind = i < e.slot ? Kind::RenderTargetView : Kind::DepthStencilView;
+				Append( data, Describe( kind, Read<const void*>( pArgs + i * sizeof( const void* ) ), ids ) );
+			}
+		}
+		else
+		{
+			data.insert( data.end(), pArgs, pArgs + e.dataSize );
+		}
+		command.dataSize = data.size() - command.dataOffset;
+		commands.push_back( command );
+		frame.Add( e.type, e.name, e.slot, e.count, e.pObject );
+	}
+	fingerprint = frame.GetFingerprint();
+}
+
+FrameCapture::FrameCapture( const std::string& path )
+{
+	std::ifstream file( path, std::ios::binary );
+	if ( !file )
+	{
+		throw CAPTURE_EXCEPT( "Failed to open capture: " + path );
+	}
+	const auto fileMagic = Read<std::array<char, sizeof( magic )>>( file );
+	if ( memcmp( fileMagic.data(), magic, sizeof( magic ) ) != 0 || Read<uint32_t>( file ) != version )
+	{
+		throw CAPTURE_EXCEPT( "Not a frame capture of this version: " + path );
+	}
+	width = Read<UINT>( file );
+	height = Read<UINT>( file );
+	camera = Read<DirectX::XMFLOAT4X4>( file );
+	projection = Read<DirectX::XMFLOAT4X4>( file );
+	fingerprint = Read<uint64_t>( file );
+
+	// counts and sizes are checked against what is left of the file before anything is allocated for them
+	const auto fileSize = std::filesystem::file_size( path );
+	const auto checkRemaining = [&]( uint64_t count, uint64_t bytesEach )
+	{
+		if ( !file || count > ( fileSize - uint64_t( file.tellg() ) ) / bytesEach )
+		{
+			throw CAPTURE_EXCEPT( "Truncated frame capture: " + path );
+		}
+	};
+	const auto nObjects = Read<uint32_t>( file );
+	checkRemaining( nObjects, sizeof( Kind ) + sizeof( uint32_t ) );
+	objects.resize( nObjects );
+	for ( auto& o : objects )
+	{
+		o.kind = Read<Kind>( file );
+		const auto descSize = Read<uint32_t>( file );
+		checkRemaining( descSize, 1u );
+		o.desc.resize( descSize );
+		file.read( reinterpret_cast<char*>( o.desc.data() ), o.desc.size() );
+	}
+	const auto nCommands = Read<uint32_t>( file );
+	checkRemaining( nCommands, sizeof( Op ) + sizeof( UINT ) + sizeof( uint64_t ) + sizeof( int32_t ) + sizeof( uint32_t ) );
+	commands.resize( nCommands );
+	for ( auto& c : commands )
+	{
+		c.op = Read<Op>( file );
+		c.slot = Read<UINT>( file );
+		c.count = Read<uint64_t>( file );
+		c.object = Read<int32_t>( file );
+		c.dataOffset = data.size();
+		c.dataSize = Read<uint32_t>( file );
+		checkRemaining( c.dataSize, 1u );
+		data.resize( data.size() + c.dataSize );
+		file.read( reinterpret_cast<char*>( data.data() + c.dataOffset ), c.dataSize );
+	}
+	if ( !file )
+	{
+		throw CAPTURE_EXCEPT( "Truncated frame capture: " + path );
+	}
+
+	for ( size_t i = 0; i < objects.size(); i++ )
+	{
+		if ( !IsValid( objects[i], i ) )
+		{
+			throw CAPTURE_EXCEPT( "Corrupt object " + std::to_string( i ) + " in frame capture: " + path );
+		}
+	}
+	for ( size_t i = 0; i < commands.size(); i++ )
+	{
+		if ( !IsValid( commands[i] ) )
+		{
+			throw CAPTURE_EXCEPT( "Corrupt command " + std::to_string( i ) + " in frame capture: " + path );
+		}
+	}
+}
+
+void FrameCapture::Save( const std::string& path ) const
+{
+	const std::filesystem::path filePath{ path };
+	if ( filePath.has_parent_path() )
+	{
+		std::filesystem::create_directories( filePath.parent_path() );
+	}
+	std::ofstream file( filePath, std::ios::binary );
+	if ( !file )
+	{
+		throw CAPTURE_EXCEPT( "Failed to create capture: " + path );
+	}
+	file.write( magic, sizeof( magic ) );
+	Write( file, version );
+	Write( file, width );
+	Write( file, height );
+	Write( file, camera );
+	Write( file, projection );
+	Write( file, fingerprint );
+
+	Write( file, uint32_t( objects.size() ) );
+	for ( const auto& o : objects )
+	{
+		Write( file, o.kind );
+		Write( file, uint32_t( o.desc.size() ) );
+		file.write( reinterpret_cast<const char*>( o.desc.data() ), o.desc.size() );
+	}
+	Write( file, uint32_t( commands.size() ) );
+	for ( const auto& c : commands )
+	{
+		Write( file, c.op );
+		Write( file, c.slot );
+		Write( file, c.count );
+		Write( file, c.object );
+		Write( file, uint32_t( c.dataSize ) );
+		file.write( reinterpret_cast<const char*>( data.data() + c.dataOffset ), c.dataSize );
+	}
+	if ( !file )
+	{
+		throw CAPTURE_EXCEPT( "Failed to write capture: " + path );
+	}
+}
+
+void FrameCapture::Prepare( Graphics& gfx )
+{
+	INFOMANAGER( gfx );
+	auto pDevice = GetDevice( gfx );
+	created.clear();
+	pointers.clear();
+
+	// resources always come before their views
+	for ( const auto& o : objects )
+	{
+		const auto pDesc = o.desc.data();
+		Microsoft::WRL::ComPtr<ID3D11DeviceChild> pObject;
+		void* pointer = nullptr;
+		// keeps the typed pointer as well - the commands need it and the view creations need resources
+		const auto keep = [&pObject, &pointer]( auto& pTyped )
+		{
+			pointer = pTyped.Get();
+			pObject = pTyped;
+		};
+		switch ( o.kind )
+		{
+		case Kind::Buffer:
+		{
+			auto desc = Read<D3D11_BUFFER_DESC>( pDesc );
+			// contents were not captured, and immutable buffers need them at creation
+			if ( desc.Usage == D3D11_USAGE_IMMUTABLE )
+			{
+				desc.Usage = D3D11_USAGE_DEFAULT;
+			}
+			Microsoft::WRL::ComPtr<ID3D11Buffer> p;
+			GFX_THROW_INFO( pDevice->CreateBuffer( &desc, nullptr, &p ) );
+			keep( p );
+			break;
+		}
+		case Kind::Texture2D:
+		{
+			auto desc = Read<D3D11_TEXTURE2D_DESC>( pDesc );
+			if ( desc.Usage == D3D11_USAGE_IMMUTABLE )
+			{
+				desc.Usage = D3D11_USAGE_DEFAULT;
+			}
+			Microsoft::WRL::ComPtr<ID3D11Texture2D> p;
+			GFX_THROW_INFO( pDevice->CreateTexture2D( &desc, nullptr, &p ) );
+			keep( p );
+			break;
+		}
+		case Kind::VertexShader:
+		{
+			Microsoft::WRL::ComPtr<ID3D11VertexShader> p;
+			GFX_THROW_INFO( pDevice->CreateVertexShader( pDesc, o.desc.size(), nullptr, &p ) );
+			keep( p );
+			break;
+		}
+		case Kind::PixelShader:
+		{
+			Microsoft::WRL::ComPtr<ID3D11PixelShader> p;
+			GFX_THROW_INFO( pDevice->CreatePixelShader( pDesc, o.desc.size(), nullptr, &p ) );
+			keep( p );
+			break;
+		}
+		case Kind::InputLayout:
+		{
+			// element count, elements with their semantic names inline, then the vertex shader bytecode
+			std::vector<D3D11_INPUT_ELEMENT_DESC> elements( Read<uint32_t>( pDesc ) );
+			auto pRead = pDesc + sizeof( uint32_t );
+			for ( auto& e : elements )
+			{
+				e.SemanticName = reinterpret_cast<const char*>( pRead );
+				pRead += strlen( e.SemanticName ) + 1u;
+				e.SemanticIndex = Read<UINT>( pRead );
+				e.Format = Read<DXGI_FORMAT>( pRead + sizeof( UINT ) );
+				e.InputSlot = Read<UINT>( pRead + sizeof( UINT ) * 2u );
+				e.AlignedByteOffset = Read<UINT>( pRead + sizeof( UINT ) * 3u );
+				e.InputSlotClass = Read<D3D11_INPUT_CLASSIFICATION>( pRead + sizeof( UINT ) * 4u );
+				e.InstanceDataStepRate = Read<UINT>( pRead + sizeof( UINT ) * 5u );
+				pRead += sizeof( UINT ) * 6u;
+			}
+			Microsoft::WRL::ComPtr<ID3D11InputLayout> p;
+			GFX_THROW_INFO( pDevice->CreateInputLayout(
+				elements.data(), (UINT)elements.size(),
+				pRead, size_t( o.desc.data() + o.desc.size() - pRead ),
+				&p
+			) );
+			keep( p );
+			break;
+		}
+		case Kind::ShaderResourceView:
+		{
+			const auto desc = Read<D3D11_SHADER_RESOURCE_VIEW_DESC>( pDesc );
+			Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> p;
+			GFX_THROW_INFO( pDevice->CreateShaderResourceView( GetResource( Read<int32_t>( pDesc + sizeof( desc ) ) ), &desc, &p ) );
+			keep( p );
+			break;
+		}
+		case Kind::RenderTargetView:
+		{
+			const auto desc = Read<D3D11_RENDER_TARGET_VIEW_DESC>( pDesc );
+			Microsoft::WRL::ComPtr<ID3D11RenderTargetView> p;
+			GFX_THROW_INFO( pDevice->CreateRenderTargetView( GetResource( Read<int32_t>( pDesc + sizeof( desc ) ) ), &desc, &p ) );
+			keep( p );
+			break;
+		}
+		case Kind::DepthStencilView:
+		{
+			const auto desc = Read<D3D11_DEPTH_STENCIL_VIEW_DESC>( pDesc );
+			Microsoft::WRL::ComPtr<ID3D11DepthStencilView> p;
+			GFX_THROW_INFO( pDevice->CreateDepthStencilView( GetResource( Read<int32_t>( pDesc + sizeof( desc ) ) ), &desc, &p ) );
+			keep( p );
+			break;
+		}
+		case Kind::Sampler:
+		{
+			const auto desc = Read<D3D11_SAMPLER_DESC>( pDesc );
+			Microsoft::WRL::ComPtr<ID3D11SamplerState> p;
+			GFX_THROW_INFO( pDevice->CreateSamplerState( &desc, &p ) );
+			keep( p );
+			break;
+		}
+		case Kind::BlendState:
+		{
+			const auto desc = Read<D3D11_BLEND_DESC>( pDesc );
+			Microsoft::WRL::ComPtr<ID3D11BlendState> p;
+			GFX_THROW_INFO( pDevice->CreateBlendState( &desc, &p ) );
+			keep( p );
+			break;
+		}
+		case Kind::DepthStencilState:
+		{
+			const auto desc = Read<D3D11_DEPTH_STENCIL_DESC>( pDesc );
+			Microsoft::WRL::ComPtr<ID3D11DepthStencilState> p;
+			GFX_THROW_INFO( pDevice->CreateDepthStencilState( &desc, &p ) );
+			keep( p );
+			break;
+		}
+		case Kind::RasterizerState:
+		{
+			const auto desc = Read<D3D11_RASTERIZER_DESC>( pDesc );
+			Microsoft::WRL::ComPtr<ID3D11RasterizerState> p;
+			GFX_THROW_INFO( pDevice->CreateRasterizerState( &desc, &p ) );
+			keep( p );
+			break;
+		}
+		default:
+			throw CAPTURE_EXCEPT( "Unknown object kind in frame capture" );
+		}
+		created.push_back( std::move( pObject ) );
+		pointers.push_back( pointer );
+	}
+
+	gfx.SetCamera( DirectX::XMLoadFloat4x4( &camera ) );
+	gfx.SetProjection( DirectX::XMLoadFloat4x4( &projection ) );
+}
+
+void FrameCapture::Replay( Graphics& gfx ) const noexcept(!IS_DEBUG)
+{
+	INFOMANAGER( gfx );
+	assert( pointers.size() == objects.size() && "Prepare the capture before replaying it" );
+	const auto pContext = GetContext( gfx );
+	const auto pLog = gfx.GetLog();
+	for ( const auto& c : commands )
+	{
+		const auto pArgs = data.data() + c.dataOffset;
+		const auto pObject = Get( c.object );
+		std::array<void*, D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT + 1u> views{};
+		switch ( c.op )
+		{
+		case Op::VSSetShader:
+			pContext->VSSetShader( static_cast<ID3D11VertexShader*>( pObject ), nullptr, 0u );
+			break;
+		case Op::PSSetShader:
+			pContext->PSSetShader( static_cast<ID3D11PixelShader*>( pObject ), nullptr, 0u );
+			break;
+		case Op::IASetInputLayout:
+			pContext->IASetInputLayout( static_cast<ID3D11InputLayout*>( pObject ) );
+			break;
+		case Op::IASetPrimitiveTopology:
+			pContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY( c.slot ) );
+			break;
+		case Op::IASetIndexBuffer:
+			pContext->IASetIndexBuffer( static_cast<ID3D11Buffer*>( pObject ), DXGI_FORMAT( Read<UINT>( pArgs ) ), Read<UINT>( pArgs + sizeof( UINT ) ) );
+			break;
+		case Op::IASetVertexBuffers:
+		{
+			const auto pBuffer = static_cast<ID3D11Buffer*>( pObject );
+			const auto stride = Read<UINT>( pArgs );
+			const auto offset = Read<UINT>( pArgs + sizeof( UINT ) );
+			pContext->IASetVertexBuffers( c.slot, 1u, &pBuffer, &stride, &offset );
+			break;
+		}
+		case Op::VSSetConstantBuffers:
+		case Op::PSSetConstantBuffers:
+		{
+			const auto pBuffer = static_cast<ID3D11Buffer*>( pObject );
+			if ( c.op == Op::VSSetConstantBuffers )
+				pContext->VSSetConstantBuffers( c.slot, 1u, &pBuffer );
+			else
+				pContext->PSSetConstantBuffers( c.slot, 1u, &pBuffer );
+			break;
+		}
+		case Op::VSSetShaderResources:
+		case Op::PSSetShaderResources:
+		{
+			const auto pView = static_cast<ID3D11ShaderResourceView*>( pObject );
+			if ( c.op == Op::VSSetShaderResources )
+				pContext->VSSetShaderResources( c.slot, 1u, &pView );
+			else
+				pContext->PSSetShaderResources( c.slot, 1u, &pView );
+			break;
+		}
+		case Op::PSSetSamplers:
+		{
+			const auto pSampler = static_cast<ID3D11SamplerState*>( pObject );
+			pContext->PSSetSamplers( c.slot, 1u, &pSampler );
+			break;
+		}
+		case Op::OMSetBlendState:
+			pContext->OMSetBlendState( static_cast<ID3D11BlendState*>( pObject ), nullptr, 0xFFFFFFFFu );
+			break;
+		case Op::OMSetDepthStencilState:
+			pContext->OMSetDepthStencilState( static_cast<ID3D11DepthStencilState*>( pObject ), c.slot );
+			break;
+		case Op::RSSetState:
+			pContext->RSSetState( static_cast<ID3D11RasterizerState*>( pObject ) );
+			break;
+		case Op::OMSetRenderTargets:
+		{
+			assert( c.slot <= D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT && c.dataSize == ( c.slot + 1u ) * sizeof( int32_t ) );
+			std::array<ID3D11RenderTargetView*, D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT> targets{};
+			for ( size_t i = 0; i <= c.slot; i++ )
+			{
+				views[i] = Get( Read<int32_t>( pArgs + i * sizeof( int32_t ) ) );
+			}
+			for ( size_t i = 0; i < c.slot; i++ )
+			{
+				targets[i] = static_cast<ID3D11RenderTargetView*>( views[i] );
+			}
+			pContext->OMSetRenderTargets( c.slot, targets.data(), static_cast<ID3D11DepthStencilView*>( views[c.slot] ) );
+			break;
+		}
+		case Op::RSSetViewports:
+		{
+			const auto viewport = Read<D3D11_VIEWPORT>( pArgs );
+			pContext->RSSetViewports( 1u, &viewport );
+			break;
+		}
+		case Op::UploadConstantBuffer:
+		case Op::UploadConstantBufferEx:
+		case Op::UploadInstanceBuffer:
+		{
+			const auto pBuffer = static_cast<ID3D11Buffer*>( pObject );
+			// never more than the buffer holds - checked on load for captures read from files
+			assert( c.dataSize <= Read<D3D11_BUFFER_DESC>( objects[c.object].desc.data() ).ByteWidth );
+			D3D11_MAPPED_SUBRESOURCE msr{};
+			GFX_THROW_INFO( pContext->Map( pBuffer, 0u, D3D11_MAP_WRITE_DISCARD, 0u, &msr ) );
+			memcpy( msr.pData, pArgs, c.dataSize );
+			pContext->Unmap( pBuffer, 0u );
+			break;
+		}
+		case Op::ClearRenderTargetView:
+		{
+			const auto color = Read<std::array<float, 4>>( pArgs );
+			pContext->ClearRenderTargetView( static_cast<ID3D11RenderTargetView*>( pObject ), color.data() );
+			break;
+		}
+		case Op::ClearDepthStencilView:
+			pContext->ClearDepthStencilView( static_cast<ID3D11DepthStencilView*>( pObject ), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0u );
+			break;
+		case Op::DrawIndexed:
+			GFX_THROW_INFO_ONLY( pContext->DrawIndexed( UINT( c.count ), 0u, 0u ) );
+			break;
+		case Op::DrawIndexedInstanced:
+			GFX_THROW_INFO_ONLY( pContext->DrawIndexedInstanced( UINT( c.count ), c.slot, 0u, 0u, 0u ) );
+			break;
+		}
+		if ( pLog )
+		{
+			const auto& info = GetInfo( c.op );
+			if ( c.op == Op::OMSetRenderTargets )
+			{
+				// logged with the views, like the original
+				pLog->Add( info.type, info.name, c.slot, c.count, c.slot > 0u ? views[0] : nullptr, views.data(), ( c.slot + 1u ) * sizeof( void* ) );
+			}
+			else
+			{
+				pLog->Add( info.type, info.name, c.slot, c.count, pObject, pArgs, c.dataSize );
+			}
+		}
+	}
+	// the commands went around the state cache
+	GetStateCache( gfx ).Invalidate();
+}
+
+UINT FrameCapture::GetWidth() const noexcept
+{
+	return width;
+}
+
+UINT FrameCapture::GetHeight() const noexcept
+{
+	return height;
+}
+
+size_t FrameCapture::GetCommandCount() const noexcept
+{
+	return commands.size();
+}
+
+size_t FrameCapture::GetObjectCount() const noexcept
+{
+	return objects.size();
+}
+
+uint64_t FrameCapture::GetFingerprint() const noexcept
+{
+	return fingerprint;
+}
+
+void FrameCapture::AttachCreationData( ID3D11DeviceChild* pShader, ID3DBlob* pBytecode )
+{
+	pShader->SetPrivateData( creationDataGuid, (UINT)pBytecode->GetBufferSize(), pBytecode->GetBufferPointer() );
+}
+
+void FrameCapture::AttachCreationData( ID3D11InputLayout* pLayout, const std::vector<D3D11_INPUT_ELEMENT_DESC>& elements, ID3DBlob* pBytecode )
+{
+	std::vector<unsigned char> bytes;
+	Append( bytes, uint32_t( elements.size() ) );
+	for ( const auto& e : elements )
+	{
+		bytes.insert( bytes.end(), e.SemanticName, e.SemanticName + strlen( e.SemanticName ) + 1u );
+		Append( bytes, e.SemanticIndex );
+		Append( bytes, UINT( e.Format ) );
+		Append( bytes, e.InputSlot );
+		Append( bytes, e.AlignedByteOffset );
+		Append( bytes, UINT( e.InputSlotClass ) );
+		Append( bytes, e.InstanceDataStepRate );
+	}
+	const auto pCode = static_cast<const unsigned char*>( pBytecode->GetBufferPointer() );
+	bytes.insert( bytes.end(), pCode, pCode + pBytecode->GetBufferSize() );
+	pLayout->SetPrivateData( creationDataGuid, (UINT)bytes.size(), bytes.data() );
+}
+
+const FrameCapture::OpInfo& FrameCapture::GetInfo( Op op ) noexcept
+{
+	using Type = CommandLog::Type;
+	static constexpr OpInfo infos[] = {
+		{ Type::Bind, "VSSetShader", Kind::VertexShader },
+		{ Type::Bind, "PSSetShader", Kind::PixelShader },
+		{ Type::Bind, "IASetInputLayout", Kind::InputLayout },
+		{ Type::Bind, "IASetPrimitiveTopology", Kind::None },
+		{ Type::Bind, "IASetIndexBuffer", Kind::Buffer },
+		{ Type::Bind, "IASetVertexBuffers", Kind::Buffer },
+		{ Type::Bind, "VSSetConstantBuffers", Kind::Buffer },
+		{ Type::Bind, "PSSetConstantBuffers", Kind::Buffer },
+		{ Type::Bind, "VSSetShaderResources", Kind::ShaderResourceView },
+		{ Type::Bind, "PSSetShaderResources", Kind::ShaderResourceView },
+		{ Type::Bind, "PSSetSamplers", Kind::Sampler },
+		{ Type::Bind, "OMSetBlendState", Kind::BlendState },
+		{ Type::Bind, "OMSetDepthStencilState", Kind::DepthStencilState },
+		{ Type::Bind, "RSSetState", Kind::RasterizerState },
+		// views are described from the arguments
+		{ Type::Bind, "OMSetRenderTargets", Kind::None },
+		{ Type::Bind, "RSSetViewports", Kind::None },
+		{ Type::Upload, "ConstantBuffer", Kind::Buffer },
+		{ Type::Upload, "ConstantBufferEx", Kind::Buffer },
+		{ Type::Upload, "InstanceBuffer", Kind::Buffer },
+		{ Type::Clear, "ClearRenderTargetView", Kind::RenderTargetView },
+		{ Type::Clear, "ClearDepthStencilView", Kind::DepthStencilView },
+		{ Type::Draw, "DrawIndexed", Kind::None },
+		{ Type::Draw, "DrawIndexedInstanced", Kind::None },
+	};
+	static_assert( std::size( infos ) == size_t( Op::Count ) );
+	return infos[size_t( op )];
+}
+
+FrameCapture::Op FrameCapture::FindOp( const char* name )
+{
+	for ( size_t i = 0; i < size_t( Op::Count ); i++ )
+	{
+		if ( strcmp( GetInfo( Op( i ) ).name, name ) == 0 )
+		{
+			return Op( i );
+		}
+	}
+	throw CAPTURE_EXCEPT( std::string( "Command cannot be captured: " ) + name );
+}
+
+bool FrameCapture::IsValid( const Object& o, size_t index ) const noexcept
+{
+	const auto size = o.desc.size();
+	const auto pDesc = o.desc.data();
+	// views are followed by the index of their resource, which always comes before them
+	const auto isView = [&]( size_t descSize )
+	{
+		if ( size != descSize + sizeof( int32_t ) )
+		{
+			return false;
+		}
+		const auto resource = Read<int32_t>( pDesc + descSize );
+		return resource >= 0 && size_t( resource ) < index &&
+			( objects[resource].kind == Kind::Buffer || objects[resource].kind == Kind::Texture2D );
+	};
+	switch ( o.kind )
+	{
+	case Kind::Buffer:
+		return size == sizeof( D3D11_BUFFER_DESC );
+	case Kind::Texture2D:
+		return size == sizeof( D3D11_TEXTURE2D_DESC );
+	case Kind::VertexShader:
+	case Kind::PixelShader:
+		return size > 0u;
+	case Kind::InputLayout:
+	{
+		// element count, elements with their semantic names inline, then the vertex shader bytecode
+		if ( size < sizeof( uint32_t ) )
+		{
+			return false;
+		}
+		const auto pEnd = pDesc + size;
+		auto pRead = pDesc + sizeof( uint32_t );
+		for ( auto n = Read<uint32_t>( pDesc ); n > 0u; n-- )
+		{
+			const auto pName = static_cast<const unsigned char*>( memchr( pRead, '\0', size_t( pEnd - pRead ) ) );
+			if ( pName == nullptr || size_t( pEnd - pName ) <= sizeof( UINT ) * 6u )
+			{
+				return false;
+			}
+			pRead = pName + 1u + sizeof( UINT ) * 6u;
+		}
+		return pRead < pEnd;
+	}
+	case Kind::ShaderResourceView:
+		return isView( sizeof( D3D11_SHADER_RESOURCE_VIEW_DESC ) );
+	case Kind::RenderTargetView:
+		return isView( sizeof( D3D11_RENDER_TARGET_VIEW_DESC ) );
+	case Kind::DepthStencilView:
+		return isView( sizeof( D3D11_DEPTH_STENCIL_VIEW_DESC ) );
+	case Kind::Sampler:
+		return size == sizeof( D3D11_SAMPLER_DESC );
+	case Kind::BlendState:
+		return size == sizeof( D3D11_BLEND_DESC );
+	case Kind::DepthStencilState:
+		return size == sizeof( D3D11_DEPTH_STENCIL_DESC );
+	case Kind::RasterizerState:
+		return size == sizeof( D3D11_RASTERIZER_DESC );
+	default:
+		return false;
+	}
+}
+
+bool FrameCapture::IsValid( const Command& c ) const noexcept
+{
+	if ( c.op >= Op::Count || c.object < -1 || c.object >= int32_t( objects.size() ) )
+	{
+		return false;
+	}
+	// commands bind the kind of object their op takes, or nothing
+	const auto kind = GetInfo( c.op ).kind;
+	if ( c.object >= 0 && objects[c.object].kind != kind )
+	{
+		return false;
+	}
+	const auto pArgs = data.data() + c.dataOffset;
+	switch ( c.op )
+	{
+	case Op::IASetPrimitiveTopology:
+		return c.slot <= D3D11_PRIMITIVE_TOPOLOGY_32_CONTROL_POINT_PATCHLIST && c.dataSize == 0u;
+	case Op::IASetIndexBuffer:
+		return c.dataSize == sizeof( UINT ) * 2u;
+	case Op::IASetVertexBuffers:
+		return c.slot < D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT && c.dataSize == sizeof( UINT ) * 2u;
+	case Op::VSSetConstantBuffers:
+	case Op::PSSetConstantBuffers:
+		return c.slot < D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT && c.dataSize == 0u;
+	case Op::VSSetShaderResources:
+	case Op::PSSetShaderResources:
+		return c.slot < D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT && c.dataSize == 0u;
+	case Op::PSSetSamplers:
+		return c.slot < D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT && c.dataSize == 0u;
+	case Op::OMSetRenderTargets:
+	{
+		// the views, then the depth view
+		if ( c.slot > D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT || c.dataSize != ( c.slot + 1u ) * sizeof( int32_t ) )
+		{
+			return false;
+		}
+		for ( size_t i = 0; i <= c.slot; i++ )
+		{
+			const auto view = Read<int32_t>( pArgs + i * sizeof( int32_t ) );
+			const auto viewKind = i < c.slot ? Kind::RenderTargetView : Kind::DepthStencilView;
+			if ( view < -1 || view >= int32_t( objects.size() ) || ( view >= 0 && objects[view].kind != viewKind ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	case Op::RSSetViewports:
+		return c.dataSize == sizeof( D3D11_VIEWPORT );
+	case Op::UploadConstantBuffer:
+	case Op::UploadConstantBufferEx:
+	case Op::UploadInstanceBuffer:
+	{
+		// mapped for discard, so the buffer has to be dynamic and hold all of the upload
+		if ( c.object < 0 )
+		{
+			return false;
+		}
+		const auto desc = Read<D3D11_BUFFER_DESC>( objects[c.object].desc.data() );
+		return desc.Usage == D3D11_USAGE_DYNAMIC && ( desc.CPUAccessFlags & D3D11_CPU_ACCESS_WRITE ) != 0u &&
+			c.dataSize > 0u && c.dataSize <= desc.ByteWidth;
+	}
+	case Op::ClearRenderTargetView:
+		return c.object >= 0 && c.dataSize == sizeof( std::array<float, 4> );
+	case Op::ClearDepthStencilView:
+		return c.object >= 0 && c.dataSize == 0u;
+	default:
+		return c.dataSize == 0u;
+	}
+}
+
+int32_t FrameCapture::Describe( Kind kind, const void* pObject, std::unordered_map<const void*, int32_t>& ids )
+{
+	if ( pObject == nullptr || kind == Kind::None )
+	{
+		return -1;
+	}
+	if ( const auto i = ids.find( pObject ); i != ids.end() )
+	{
+		return i->second;
+	}
+
+	Object object{ kind };
+	// logged as the interface it was bound through
+	const auto p = const_cast<void*>( pObject );
+	// views are described along with the resource they view, which gets described first
+	const auto describeView = [this, &object, &ids]( auto* pView, auto desc )
+	{
+		pView->GetDesc( &desc );
+		Microsoft::WRL::ComPtr<ID3D11Resource> pResource;
+		pView->GetResource( &pResource );
+		D3D11_RESOURCE_DIMENSION dimension;
+		pResource->GetType( &dimension );
+		int32_t resource;
+		if ( dimension == D3D11_RESOURCE_DIMENSION_BUFFER )
+		{
+			resource = Describe( Kind::Buffer, static_cast<ID3D11Buffer*>( pResource.Get() ), ids );
+		}
+		else if ( dimension == D3D11_RESOURCE_DIMENSION_TEXTURE2D )
+		{
+			resource = Describe( Kind::Texture2D, static_cast<ID3D11Texture2D*>( pResource.Get() ), ids );
+		}
+		else
+		{
+			throw CAPTURE_EXCEPT( "Only buffers and 2d textures can be captured" );
+		}
+		Append( object.desc, desc );
+		Append( object.desc, resource );
+	};
+	switch ( kind )
+	{
+	case Kind::Buffer:
+	{
+		D3D11_BUFFER_DESC desc;
+		static_cast<ID3D11Buffer*>( p )->GetDesc( &desc );
+		Append( object.desc, desc );
+		break;
+	}
+	case Kind::Texture2D:
+	{
+		D3D11_TEXTURE2D_DESC desc;
+		static_cast<ID3D11Texture2D*>( p )->GetDesc( &desc );
+		Append( object.desc, desc );
+		break;
+	}
+	case Kind::VertexShader:
+		object.desc = GetCreationData( static_cast<ID3D11VertexShader*>( p ) );
+		break;
+	case Kind::PixelShader:
+		object.desc = GetCreationData( static_cast<ID3D11PixelShader*>( p ) );
+		break;
+	case Kind::InputLayout:
+		object.desc = GetCreationData( static_cast<ID3D11InputLayout*>( p ) );
+		break;
+	case Kind::ShaderResourceView:
+		describeView( static_cast<ID3D11ShaderResourceView*>( p ), D3D11_SHADER_RESOURCE_VIEW_DESC{} );
+		break;
+	case Kind::RenderTargetView:
+		describeView( static_cast<ID3D11RenderTargetView*>( p ), D3D11_RENDER_TARGET_VIEW_DESC{} );
+		break;
+	case Kind::DepthStencilView:
+		describeView( static_cast<ID3D11DepthStencilView*>( p ), D3D11_DEPTH_STENCIL_VIEW_DESC{} );
+		break;
+	case Kind::Sampler:
+	{
+		D3D11_SAMPLER_DESC desc;
+		static_cast<ID3D11SamplerState*>( p )->GetDesc( &desc );
+		Append( object.desc, desc );
+		break;
+	}
+	case Kind::BlendState:
+	{
+		D3D11_BLEND_DESC desc;
+		static_cast<ID3D11BlendState*>( p )->GetDesc( &desc );
+		Append( object.desc, desc );
+		break;
+	}
+	case Kind::DepthStencilState:
+	{
+		D3D11_DEPTH_STENCIL_DESC desc;
+		static_cast<ID3D11DepthStencilState*>( p )->GetDesc( &desc );
+		Append( object.desc, desc );
+		break;
+	}
+	case Kind::RasterizerState:
+	{
+		D3D11_RASTERIZER_DESC desc;
+		static_cast<ID3D11RasterizerState*>( p )->GetDesc( &desc );
+		Append( object.desc, desc );
+		break;
+	}
+	}
+
+	if ( object.desc.empty() )
+	{
+		throw CAPTURE_EXCEPT( "Shader or input layout was created without attaching its creation data" );
+	}
+	const auto index = int32_t( objects.size() );
+	objects.push_back( std::move( object ) );
+	ids.emplace( pObject, index );
+	return index;
+}
+
+ID3D11Resource* FrameCapture::GetResource( int32_t index ) const noexcept
+{
+	// pointers are kept as the type they were created as
+	if ( objects[index].kind == Kind::Buffer )
+	{
+		return static_cast<ID3D11Buffer*>( pointers[index] );
+	}
+	return static_cast<ID3D11Texture2D*>( pointers[index] );
+}
+
+void* FrameCapture::Get( int32_t index ) const noexcept
+{
+	return index < 0 ? nullptr : pointers[index];
+}
+
+FrameCapture::CaptureException::CaptureException( int line, const char* file, std::string note ) noexcept
+	:
+	Exception( line, file ),
+	note( std::move( note ) )
+{}
+
+const char* FrameCapture::CaptureException::what() const noexcept
+{
+	std::ostringstream oss;
+	oss << Exception::what() << std::endl
+		<< "[Note] " << GetNote();
+	whatBuffer = oss.str();
+	return whatBuffer.c_str();
+}
+
+const char* FrameCapture::CaptureException::GetType() const noexcept
+{
+	return "Frame Capture Exception";
+}
+
+const std::string& FrameCapture::CaptureException::GetNote() const noexcept
+{
+	return note;
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+#include "GraphicsResource.h"
+#include "Exception.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// one frame of pipeline work - every bind, upload, clear and draw it issued, and a description of each object they used
+// built from the command log of the frame and saved as a compact binary file
+// a replay recreates the objects on any graphics, windowed or headless, and issues the same commands again,
+// so the driver side cpu cost of a frame can be measured without the scene, input or window that produced it
+// only the recorded d3d calls are timed - the engine work that issued them (submission, queue sorting, the state cache,
+// dcb uploads and graph traversal) is not part of a replay, the bench-headless and bench-sort commands measure that
+// contents of textures and static buffers are not kept - replays do the same work but draw nothing meaningful
+class FrameCapture : public GraphicsResource
+{
+public:
+	class CaptureException : public Exception
+	{
+	public:
+		CaptureException( int line, const char* file, std::string note ) noexcept;
+		const char* what() const noexcept override;
+		const char* GetType() const noexcept override;
+		const std::string& GetNote() const noexcept;
+	private:
+		std::string note;
+	};
+public:
+	// the log has to cover the whole frame - enable it on gfx before the frame begins
+	FrameCapture( Graphics& gfx, const CommandLog& log );
+	FrameCapture( const std::string& path );
+	void Save( const std::string& path ) const;
+	// recreates the captured objects and view on gfx - call once before replaying
+	void Prepare( Graphics& gfx );
+	// issues the frame on the immediate context, adding it to the log of gfx if it keeps one
+	void Replay( Graphics& gfx ) const noexcept(!IS_DEBUG);
+	UINT GetWidth() const noexcept;
+	UINT GetHeight() const noexcept;
+	size_t GetCommandCount() const noexcept;
+	size_t GetObjectCount() const noexcept;
+	// fingerprint of the captured frame's log - a replay logging the same one issued identical work
+	uint64_t GetFingerprint() const noexcept;
+	// shaders and input layouts cannot be described through the api, so the data they were created from is attached to them
+	static void AttachCreationData( ID3D11DeviceChild* pShader, ID3DBlob* pBytecode );
+	static void AttachCreationData( ID3D11InputLayout* pLayout, const std::vector<D3D11_INPUT_ELEMENT_DESC>& elements, ID3DBlob* pBytecode );
+private:
+	// stored in files - only ever append
+	enum class Kind : uint8_t
+	{
+		None,
+		Buffer,
+		Texture2D,
+		VertexShader,
+		PixelShader,
+		InputLayout,
+		ShaderResourceView,
+		RenderTargetView,
+		DepthStencilView,
+		Sampler,
+		BlendState,
+		DepthStencilState,
+		RasterizerState
+	};
+	enum class Op : uint8_t
+	{
+		VSSetShader,
+		PSSetShader,
+		IASetInputLayout,
+		IASetPrimitiveTopology,
+		IASetIndexBuffer,
+		IASetVertexBuffers,
+		VSSetConstantBuffers,
+		PSSetConstantBuffers,
+		VSSetShaderResources,
+		PSSetShaderResources,
+		PSSetSamplers,
+		OMSetBlendState,
+		OMSetDepthStencilState,
+		RSSetState,
+		OMSetRenderTargets,
+		RSSetViewports,
+		UploadConstantBuffer,
+		UploadConstantBufferEx,
+		UploadInstanceBuffer,
+		ClearRenderTargetView,
+		ClearDepthStencilView,
+		DrawIndexed,
+		DrawIndexedInstanced,
+		Count
+	};
+	struct OpInfo
+	{
+		// same type and name the command is logged with
+		CommandLog::Type type;
+		const char* name;
+		Kind kind;
+	};
+	struct Object
+	{
+		Kind kind;
+		// api description, or creation data for shaders and input layouts
+		// views are followed by the index of their resource
+		std::vector<unsigned char> desc;
+	};
+	struct Command
+	{
+		Op op;
+		UINT slot;
+		uint64_t count;
+		// index into the objects, -1 for none
+		int32_t object;
+		size_t dataOffset;
+		size_t dataSize;
+	};
+private:
+	static const OpInfo& GetInfo( Op op ) noexcept;
+	static Op FindOp( const char* name );
+	// checks every field read from a file against what Prepare() and Replay() rely on
+	// objects are checked in order, so a view's resource is known to be valid before the view
+	bool IsValid( const Object& object, size_t index ) const noexcept;
+	bool IsValid( const Command& command ) const noexcept;
+	int32_t Describe( Kind kind, const void* pObject, std::unordered_map<const void*, int32_t>& ids );
+	ID3D11Resource* GetResource( int32_t index ) const noexcept;
+	void* Get( int32_t index ) const noexcept;
+private:
+	UINT width;
+	UINT height;
+	DirectX::XMFLOAT4X4 camera;
+	DirectX::XMFLOAT4X4 projection;
+	uint64_t fingerprint = 0u;
+	std::vector<Object> objects;
+	std::vector<Command> commands;
+	// command arguments - render target commands hold object indices instead of the views logged
+	std::vector<unsigned char> data;
+	// objects recreated by Prepare, by index
+	std::vector<Microsoft::WRL::ComPtr<ID3D11DeviceChild>> created;
+	std::vector<void*> pointers;
+};
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "dxerr.h"
 #include "DepthStencil.h"
 #include "RenderTarget.h"
+#include "DeferredCommandList.h"
 #include <sstream>
 #include <d3dcompiler.h>
 #include <array>
@@ -58,24 +59,72 @@ Graphics::Graphics( HWND hWnd, int width, int height ) : width( width ), height(
 	if ( FAILED( pSwap->SetFullscreenState( true, nullptr ) ) )
 		throw GFX_EXCEPT( hr );
 
+	// all bindables bind through the state cache
+	pStateCache = std::make_unique<StateCache>( pContext.Get() );
+
 	// gain access to back buffer (sub-resource)
 	Microsoft::WRL::ComPtr<ID3D11Texture2D> pBackBuffer;
 	GFX_THROW_INFO(pSwap->GetBuffer(0, __uuidof(ID3D11Texture2D), &pBackBuffer));
 	pTarget = std::shared_ptr<Bind::RenderTarget>{ new Bind::OutputOnlyRenderTarget( *this, pBackBuffer.Get() ) };
 
 	// viewport always fullscreen
-	D3D11_VIEWPORT vp;
-	vp.Width = (float)width;
-	vp.Height = (float)height;
-	vp.MinDepth = 0.0f;
-	vp.MaxDepth = 1.0f;
-	vp.TopLeftX = 0.0f;
-	vp.TopLeftY = 0.0f;
-	pContext->RSSetViewports( 1u, &vp );
+	SetFullscreenViewport( *pStateCache );
 
 	ImGui_ImplDX11_Init( pDevice.Get(), pContext.Get() );
 }
 
+Graphics::Graphics( int width, int height ) : imguiEnabled( false ), width( width ), height( height )
+{
+	UINT createFlags = 0;
+#ifndef NDEBUG
+	createFlags |= D3D11_CREATE_DEVICE_DEBUG;
+#endif
+
+	HRESULT hr = E_FAIL;
+
+	// the null driver validates and accepts every call without rendering, so only the engine's own work is measured
+	// it ships with the graphics tools optional feature - warp is always there, but it does rasterize
+	for ( const auto driver : { D3D_DRIVER_TYPE_NULL, D3D_DRIVER_TYPE_WARP } )
+	{
+		hr = D3D11CreateDevice(
+			nullptr,
+			driver,
+			nullptr,
+			createFlags,
+			nullptr,
+			0,
+			D3D11_SDK_VERSION,
+			&pDevice,
+			nullptr,
+			&pContext
+		);
+		if ( SUCCEEDED( hr ) )
+			break;
+	}
+	if ( FAILED( hr ) )
+		throw GFX_EXCEPT( hr );
+
+	pStateCache = std::make_unique<StateCache>( pContext.Get() );
+	EnableCommandLog();
+
+	// offscreen texture stands in for the back buffer
+	D3D11_TEXTURE2D_DESC textureDesc = {};
+	textureDesc.Width = this->width;
+	textureDesc.Height = this->height;
+	textureDesc.MipLevels = 1u;
+	textureDesc.ArraySize = 1u;
+	textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	textureDesc.SampleDesc.Count = 1u;
+	textureDesc.SampleDesc.Quality = 0u;
+	textureDesc.Usage = D3D11_USAGE_DEFAULT;
+	textureDesc.BindFlags = D3D11_BIND_RENDER_TARGET;
+	Microsoft::WRL::ComPtr<ID3D11Texture2D> pBackBuffer;
+	GFX_THROW_INFO( pDevice->CreateTexture2D( &textureDesc, nullptr, &pBackBuffer ) );
+	pTarget = std::shared_ptr<Bind::RenderTarget>{ new Bind::OutputOnlyRenderTarget( *this, pBackBuffer.Get() ) };
+
+	SetFullscreenViewport( *pStateCache );
+}
+
 void Graphics::BeginFrame( float red, float green, float blue ) noexcept
 {
 	if ( imguiEnabled )
@@ -84,10 +133,14 @@ void Graphics::BeginFrame( float red, float green, float blue ) noexcept
 		ImGui_ImplWin32_NewFrame();
 		ImGui::NewFrame();
 	}
+	// imgui restores its own state but the cache cannot see that, so start every frame from scratch
+	pStateCache->Invalidate();
+	pStateCache->ResetStatistics();
+	if ( pLog )
+		pLog->Clear();
 	// clear shader inputs
-	ID3D11ShaderResourceView* const pNullTex = nullptr;
-	pContext->PSSetShaderResources( 0, 1, &pNullTex ); // fullscreen input texture
-	pContext->PSSetShaderResources( 3, 1, &pNullTex ); // shadow map texture
+	pStateCache->PSSetShaderResource( 0, nullptr ); // fullscreen input texture
+	pStateCache->PSSetShaderResource( 3, nullptr ); // shadow map texture
 }
 
 void Graphics::EndFrame()
@@ -97,6 +150,8 @@ void Graphics::EndFrame()
 		ImGui::Render();
 		ImGui_ImplDX11_RenderDrawData( ImGui::GetDrawData() );
 	}
+	if ( IsHeadless() )
+		return;
 
 	HRESULT hr;
 #ifndef NDEBUG
@@ -117,32 +172,42 @@ void Graphics::EndFrame()
 
 void Graphics::DrawIndexed( UINT count ) noexcept(!IS_DEBUG)
 {
-	GFX_THROW_INFO_ONLY( pContext->DrawIndexed( count, 0u, 0u ) );
+	GFX_THROW_INFO_ONLY( GetActiveContext()->DrawIndexed( count, 0u, 0u ) );
+	if ( const auto pActiveLog = GetLog() )
+		pActiveLog->Add( CommandLog::Type::Draw, "DrawIndexed", 0u, count );
+}
+
+void Graphics::DrawIndexedInstanced( UINT count, UINT instances ) noexcept(!IS_DEBUG)
+{
+	GFX_THROW_INFO_ONLY( GetActiveContext()->DrawIndexedInstanced( count, instances, 0u, 0u, 0u ) );
+	if ( const auto pActiveLog = GetLog() )
+		pActiveLog->Add( CommandLog::Type::Draw, "DrawIndexedInstanced", instances, count );
 }
 
 void Graphics::SetProjection( DirectX::FXMMATRIX proj ) noexcept
 {
-	projection = proj;
+	( pRecording ? pRecording->projection : projection ) = proj;
 }
 
 DirectX::XMMATRIX Graphics::GetProjection() const noexcept
 {
-	return projection;
+	return pRecording ? pRecording->projection : projection;
 }
 
 void Graphics::SetCamera( DirectX::FXMMATRIX cam ) noexcept
 {
-	camera = cam;
+	( pRecording ? pRecording->camera : camera ) = cam;
 }
 
 DirectX::XMMATRIX Graphics::GetCamera() const noexcept
 {
-	return camera;
+	return pRecording ? pRecording->camera : camera;
 }
 
 void Graphics::EnableImGui() noexcept
 {
-	imguiEnabled = true;
+	// imgui was never set up without a window
+	imguiEnabled = !IsHeadless();
 }
 
 void Graphics::DisableImGui() noexcept
@@ -170,6 +235,89 @@ std::shared_ptr<Bind::RenderTarget> Graphics::GetTarget()
 	return pTarget;
 }
 
+const StateCache::Statistics& Graphics::GetBindStatistics() const noexcept
+{
+	return pStateCache->GetStatistics();
+}
+
+std::unique_ptr<Rgph::CommandList> Graphics::CreateCommandList()
+{
+	// the null and warp devices of headless graphics make deferred contexts too, so passes record in parallel there as well
+	return std::make_unique<Rgph::DeferredCommandList>( *this );
+}
+
+bool Graphics::IsHeadless() const noexcept
+{
+	return pSwap == nullptr;
+}
+
+void Graphics::EnableCommandLog()
+{
+	if ( !pLog )
+	{
+		pLog = std::make_unique<CommandLog>();
+		pStateCache->SetLog( pLog.get() );
+	}
+}
+
+void Graphics::DisableCommandLog() noexcept
+{
+	// the log is all headless graphics produces
+	if ( !IsHeadless() )
+	{
+		pStateCache->SetLog( nullptr );
+		pLog.reset();
+	}
+}
+
+CommandLog* Graphics::GetLog() const noexcept
+{
+	return GetActiveStateCache().GetLog();
+}
+
+ID3D11DeviceContext* Graphics::GetActiveContext() const noexcept
+{
+	return pRecording ? pRecording->pContext : pContext.Get();
+}
+
+StateCache& Graphics::GetActiveStateCache() const noexcept
+{
+	return pRecording ? pRecording->stateCache : *pStateCache;
+}
+
+void Graphics::SetFullscreenViewport( StateCache& target ) const noexcept
+{
+	D3D11_VIEWPORT vp;
+	vp.Width = (float)width;
+	vp.Height = (float)height;
+	vp.MinDepth = 0.0f;
+	vp.MaxDepth = 1.0f;
+	vp.TopLeftX = 0.0f;
+	vp.TopLeftY = 0.0f;
+	target.RSSetViewport( vp );
+}
+
+thread_local Graphics::Recording* Graphics::pRecording = nullptr;
+
+Graphics::Recording::Recording( Graphics& gfx, ID3D11DeviceContext* pContext, StateCache& stateCache, std::vector<std::function<void()>>& afterReplay ) noexcept
+	:
+	projection( gfx.GetProjection() ),
+	camera( gfx.GetCamera() ),
+	pContext( pContext ),
+	stateCache( stateCache ),
+	afterReplay( afterReplay ),
+	pPrevious( pRecording )
+{
+	// passes that only bind a depth stencil draw with whatever viewport is set
+	gfx.SetFullscreenViewport( stateCache );
+	pRecording = this;
+}
+
+Graphics::Recording::~Recording()
+{
+	pRecording = pPrevious;
+}
+
 Graphics::HrException::HrException( int line, const char* file, HRESULT hr, std::vector<std::string> infoMsgs ) noexcept : GfxException(line, file), hr(hr)
 {
 	// join all info messages with newlines into string
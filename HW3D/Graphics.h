@@ -9,8 +9,10 @@
 #include <random>
 
 #include "DxgiInfoManager.h"
+#include "StateCache.h"
 #include <vector>
 #include <string>
+#include <functional>
 
 namespace Bind
 {
@@ -18,6 +20,11 @@ namespace Bind
 	class RenderTarget;
 }
 
+namespace Rgph
+{
+	class CommandList;
+}
+
 class Graphics
 {
 	friend class GraphicsResource;
@@ -57,14 +64,40 @@ public:
 		const char* GetType() const noexcept override;
 		std::string reason;
 	};
+	// while alive, binds and draws of the calling thread go to another context and view changes stay local to it
+	// the view starts out as the one set on gfx, the viewport as fullscreen
+	class Recording
+	{
+		friend Graphics;
+		friend class GraphicsResource;
+	public:
+		Recording( Graphics& gfx, ID3D11DeviceContext* pContext, StateCache& stateCache, std::vector<std::function<void()>>& afterReplay ) noexcept;
+		Recording( const Recording& ) = delete;
+		Recording& operator=( const Recording& ) = delete;
+		~Recording();
+	private:
+		DirectX::XMMATRIX projection;
+		DirectX::XMMATRIX camera;
+		ID3D11DeviceContext* pContext;
+		StateCache& stateCache;
+		// actions that must wait until the recorded commands have been replayed
+		std::vector<std::function<void()>>& afterReplay;
+		Recording* pPrevious;
+	};
 public:
 	Graphics( HWND hWnd, int width, int height );
+	// headless - no window, no swap chain and nothing is rendered, but every api call is still made
+	// binds, draws, uploads, clears and codex creations of each frame are kept in the command log
+	// the device is the d3d11 null driver, or warp where that is missing, so headless runs still need windows
+	// there is no device-free backend - bindables call d3d11 directly, not through an interface graphics could swap
+	Graphics( int width, int height );
 	Graphics( const Graphics&  ) = delete;
 	Graphics& operator = ( const Graphics& ) = delete;
 	~Graphics() = default;
 	void BeginFrame( float red, float green, float blue ) noexcept;
 	void EndFrame();
 	void DrawIndexed( UINT count ) noexcept(!IS_DEBUG);
+	void DrawIndexedInstanced( UINT count, UINT instances ) noexcept(!IS_DEBUG);
 	void SetProjection( DirectX::FXMMATRIX proj ) noexcept;
 	DirectX::XMMATRIX GetProjection() const noexcept;
 	void SetCamera( DirectX::FXMMATRIX cam ) noexcept;
@@ -75,7 +108,22 @@ public:
 	UINT GetWidth() const noexcept;
 	UINT GetHeight() const noexcept;
 	std::shared_ptr<Bind::RenderTarget> GetTarget();
+	const StateCache::Statistics& GetBindStatistics() const noexcept;
+	// list a pass can be recorded into on any thread - a deferred context of the device, headless or not
+	std::unique_ptr<Rgph::CommandList> CreateCommandList();
+	bool IsHeadless() const noexcept;
+	// keep a command log of each frame from the next one on - needed to capture frames when not headless
+	void EnableCommandLog();
+	void DisableCommandLog() noexcept;
+	// log of the current frame for the calling thread's context - null unless headless or enabled
+	CommandLog* GetLog() const noexcept;
+private:
+	// immediate context unless the calling thread is recording
+	ID3D11DeviceContext* GetActiveContext() const noexcept;
+	StateCache& GetActiveStateCache() const noexcept;
+	void SetFullscreenViewport( StateCache& target ) const noexcept;
 private:
+	static thread_local Recording* pRecording;
 	bool imguiEnabled = true;
 	DirectX::XMMATRIX projection;
 	DirectX::XMMATRIX camera;
@@ -87,5 +135,7 @@ private:
 	Microsoft::WRL::ComPtr<ID3D11Device> pDevice;
 	Microsoft::WRL::ComPtr<IDXGISwapChain> pSwap;
 	Microsoft::WRL::ComPtr<ID3D11DeviceContext> pContext;
+	std::unique_ptr<StateCache> pStateCache;
+	std::unique_ptr<CommandLog> pLog;
 	std::shared_ptr<Bind::RenderTarget> pTarget;
 };
\ No newline at end of file
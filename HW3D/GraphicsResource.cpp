@@ -3,7 +3,7 @@
 
 ID3D11DeviceContext* GraphicsResource::GetContext( Graphics& gfx ) noexcept
 {
-	return gfx.pContext.Get();
+	return gfx.GetActiveContext();
 }
 
 ID3D11Device* GraphicsResource::GetDevice( Graphics& gfx ) noexcept
@@ -11,6 +11,11 @@ ID3D11Device* GraphicsResource::GetDevice( Graphics& gfx ) noexcept
 	return gfx.pDevice.Get();
 }
 
+StateCache& GraphicsResource::GetStateCache( Graphics& gfx ) noexcept
+{
+	return gfx.GetActiveStateCache();
+}
+
 DxgiInfoManager& GraphicsResource::GetInfoManager( Graphics& gfx )
 {
 #ifndef NDEBUG
@@ -18,4 +23,16 @@ DxgiInfoManager& GraphicsResource::GetInfoManager( Graphics& gfx )
 #else
 	throw std::logic_error( "ERROR:: Tried to access gfx.infomanager in Release config!" );
 #endif
+}
+
+void GraphicsResource::DeferUntilReplayed( Graphics& gfx, std::function<void()> action )
+{
+	if ( Graphics::pRecording )
+	{
+		Graphics::pRecording->afterReplay.push_back( std::move( action ) );
+	}
+	else
+	{
+		action();
+	}
 }
\ No newline at end of file
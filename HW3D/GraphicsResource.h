@@ -8,5 +8,9 @@ class GraphicsResource
 protected:
 	static ID3D11DeviceContext* GetContext( Graphics& gfx ) noexcept;
 	static ID3D11Device* GetDevice( Graphics& gfx ) noexcept;
+	static StateCache& GetStateCache( Graphics& gfx ) noexcept;
 	static DxgiInfoManager& GetInfoManager( Graphics& gfx );
+	// runs the action once what the calling thread has bound reached the immediate context
+	// that is right away, unless the thread is recording a pass
+	static void DeferUntilReplayed( Graphics& gfx, std::function<void()> action );
 };
\ No newline at end of file
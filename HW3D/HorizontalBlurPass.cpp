@@ -18,19 +18,9 @@ namespace Rgph
 
 		AddBindSink<Bind::RenderTarget>( "scratchIn" );
 		AddBindSink<Bind::CachingPixelConstantBufferEx>( "kernel" );
-		RegisterSink( DirectBindableSink<Bind::CachingPixelConstantBufferEx>::Make( "direction", direction ) );
+		AddBindSink<Bind::CachingPixelConstantBufferEx>( "direction" );
 
-		renderTarget = std::make_shared<Bind::ShaderInputRenderTarget>(gfx, width / 2, height / 2, 0u);
+		RequestTransient(renderTarget, width / 2, height / 2, 0u, "scratchOut");
 		RegisterSource(DirectBindableSource<Bind::RenderTarget>::Make("scratchOut", renderTarget));
 	}
-
-	void HorizontalBlurPass::Execute(Graphics& gfx) const noexcept(!IS_DEBUG)
-	{
-		auto buf = direction->GetBuffer();
-		buf["isHorizontal"] = true;
-		direction->SetBuffer(buf);
-
-		direction->Bind(gfx);
-		FullscreenPass::Execute(gfx);
-	}
 }
\ No newline at end of file
@@ -1,32 +1,63 @@
 #include "IndexBuffer.h"
 #include "BindableCodex.h"
 #include "GraphicsThrowMacros.h"
+#include <algorithm>
+#include <limits>
 
 namespace Bind
 {
 	IndexBuffer::IndexBuffer( Graphics& gfx, const std::vector<unsigned short>& indices ) : IndexBuffer( gfx, "?", indices ) {}
 
-	IndexBuffer::IndexBuffer( Graphics& gfx, std::string tag, const std::vector<unsigned short>& indices ) : count( (UINT)indices.size() )
+	IndexBuffer::IndexBuffer( Graphics& gfx, std::string tag, const std::vector<unsigned short>& indices )
+		: IndexBuffer( gfx, std::move( tag ), indices.data(), indices.size() ) {}
+
+	IndexBuffer::IndexBuffer( Graphics& gfx, std::string tag, const unsigned short* pIndices, size_t count ) : tag( std::move( tag ) ), count( (UINT)count )
+	{
+		Create( gfx, pIndices );
+	}
+
+	IndexBuffer::IndexBuffer( Graphics& gfx, const std::vector<unsigned int>& indices ) : IndexBuffer( gfx, "?", indices ) {}
+
+	IndexBuffer::IndexBuffer( Graphics& gfx, std::string tag, const std::vector<unsigned int>& indices )
+		: IndexBuffer( gfx, std::move( tag ), indices.data(), indices.size() ) {}
+
+	IndexBuffer::IndexBuffer( Graphics& gfx, std::string tag, const unsigned int* pIndices, size_t count ) : tag( std::move( tag ) ), count( (UINT)count )
+	{
+		if ( FitsShort( pIndices, count ) )
+		{
+			// half the index bandwidth for every mesh that allows it
+			std::vector<unsigned short> narrow( count );
+			std::transform( pIndices, pIndices + count, narrow.begin(), []( unsigned int i ) { return (unsigned short)i; } );
+			Create( gfx, narrow.data() );
+		}
+		else
+		{
+			format = DXGI_FORMAT_R32_UINT;
+			Create( gfx, pIndices );
+		}
+	}
+
+	void IndexBuffer::Create( Graphics& gfx, const void* pIndices )
 	{
 		INFOMANAGER( gfx );
 
 		D3D11_BUFFER_DESC ibd = { 0 };
-		ibd.ByteWidth = UINT( count * sizeof( unsigned short ) );
+		ibd.ByteWidth = count * GetStride();
 		ibd.Usage = D3D11_USAGE_DEFAULT;
 		ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
 		ibd.CPUAccessFlags = 0u;
 		ibd.MiscFlags = 0u;
-		ibd.StructureByteStride = sizeof( unsigned short );
+		ibd.StructureByteStride = GetStride();
 
 		D3D11_SUBRESOURCE_DATA isd = { 0 };
-		isd.pSysMem = indices.data();
+		isd.pSysMem = pIndices;
 		GFX_THROW_INFO( GetDevice( gfx )->CreateBuffer( &ibd, &isd, &pIndexBuffer ) );
 	}
 
 	void IndexBuffer::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->IASetIndexBuffer( pIndexBuffer.Get(), DXGI_FORMAT_R16_UINT, 0u ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).IASetIndexBuffer( pIndexBuffer.Get(), format, 0u ) );
 	}
 
 	UINT IndexBuffer::GetCount() const noexcept
@@ -34,20 +65,57 @@ namespace Bind
 		return count;
 	}
 
+	DXGI_FORMAT IndexBuffer::GetFormat() const noexcept
+	{
+		return format;
+	}
+
+	bool IndexBuffer::FitsShort( const unsigned int* pIndices, size_t count ) noexcept
+	{
+		return std::all_of( pIndices, pIndices + count, []( unsigned int i ) { return i <= std::numeric_limits<unsigned short>::max(); } );
+	}
+
+	UINT IndexBuffer::GetStride() const noexcept
+	{
+		return format == DXGI_FORMAT_R32_UINT ? sizeof( unsigned int ) : sizeof( unsigned short );
+	}
+
 	std::shared_ptr<IndexBuffer> IndexBuffer::Resolve( Graphics& gfx, const std::string& tag, const std::vector<unsigned short>& indices )
 	{
 		assert( tag != "?" );
 		return Codex::Resolve<IndexBuffer>( gfx, tag, indices );
 	}
 
-	std::string IndexBuffer::GenerateUID_( const std::string& tag )
+	std::shared_ptr<IndexBuffer> IndexBuffer::Resolve( Graphics& gfx, const std::string& tag, const unsigned short* pIndices, size_t count )
+	{
+		assert( tag != "?" );
+		return Codex::Resolve<IndexBuffer>( gfx, tag, pIndices, count );
+	}
+
+	std::shared_ptr<IndexBuffer> IndexBuffer::Resolve( Graphics& gfx, const std::string& tag, const std::vector<unsigned int>& indices )
+	{
+		assert( tag != "?" );
+		return Codex::Resolve<IndexBuffer>( gfx, tag, indices );
+	}
+
+	std::shared_ptr<IndexBuffer> IndexBuffer::Resolve( Graphics& gfx, const std::string& tag, const unsigned int* pIndices, size_t count )
+	{
+		assert( tag != "?" );
+		return Codex::Resolve<IndexBuffer>( gfx, tag, pIndices, count );
+	}
+
+	BindKey IndexBuffer::GenerateKey_( const std::string& tag )
+	{
+		return BindKey::Make<IndexBuffer>( tag );
+	}
+
+	BindKey IndexBuffer::GetKey() const noexcept(!IS_DEBUG)
 	{
-		using namespace std::string_literals;
-		return typeid( IndexBuffer ).name() + "#"s + tag;
+		return GenerateKey_( tag );
 	}
 
-	std::string IndexBuffer::GetUID() const noexcept
+	size_t IndexBuffer::GetSizeInBytes() const noexcept
 	{
-		return GenerateUID_( tag );
+		return count * GetStride();
 	}
 }
\ No newline at end of file
@@ -8,20 +8,35 @@ namespace Bind
 	public:
 		IndexBuffer( Graphics& gfx, const std::vector<unsigned short>& indices );
 		IndexBuffer( Graphics& gfx, std::string tag, const std::vector<unsigned short>& indices );
+		IndexBuffer( Graphics& gfx, std::string tag, const unsigned short* pIndices, size_t count );
+		// stored 16 bit when every index fits and 32 bit otherwise
+		IndexBuffer( Graphics& gfx, const std::vector<unsigned int>& indices );
+		IndexBuffer( Graphics& gfx, std::string tag, const std::vector<unsigned int>& indices );
+		IndexBuffer( Graphics& gfx, std::string tag, const unsigned int* pIndices, size_t count );
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		UINT GetCount() const noexcept;
+		DXGI_FORMAT GetFormat() const noexcept;
+		static bool FitsShort( const unsigned int* pIndices, size_t count ) noexcept;
 		static std::shared_ptr<IndexBuffer> Resolve( Graphics& gfx, const std::string& tag, const std::vector<unsigned short>& indices );
+		static std::shared_ptr<IndexBuffer> Resolve( Graphics& gfx, const std::string& tag, const unsigned short* pIndices, size_t count );
+		static std::shared_ptr<IndexBuffer> Resolve( Graphics& gfx, const std::string& tag, const std::vector<unsigned int>& indices );
+		static std::shared_ptr<IndexBuffer> Resolve( Graphics& gfx, const std::string& tag, const unsigned int* pIndices, size_t count );
 		template<typename...Ignore>
-		static std::string GenerateUID( const std::string& tag, Ignore&&...ignore )
+		static BindKey GenerateKey( const std::string& tag, Ignore&&...ignore )
 		{
-			return GenerateUID_( tag );
+			return GenerateKey_( tag );
 		}
-		std::string GetUID() const noexcept override;
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
+		size_t GetSizeInBytes() const noexcept override;
 	private:
-		static std::string GenerateUID_( const std::string& tag );
+		static BindKey GenerateKey_( const std::string& tag );
+		// indices in the buffer's format
+		void Create( Graphics& gfx, const void* pIndices );
+		UINT GetStride() const noexcept;
 	protected:
 		std::string tag;
 		UINT count;
+		DXGI_FORMAT format = DXGI_FORMAT_R16_UINT;
 		Microsoft::WRL::ComPtr<ID3D11Buffer> pIndexBuffer;
 	};
 }
\ No newline at end of file
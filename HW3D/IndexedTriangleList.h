@@ -7,7 +7,7 @@ class IndexedTriangleList
 {
 public:
 	IndexedTriangleList() = default;
-	IndexedTriangleList( VertexMeta::VertexBuffer verts_in, std::vector<unsigned short> indices_in )
+	IndexedTriangleList( VertexMeta::VertexBuffer verts_in, std::vector<unsigned int> indices_in )
 		: vertices( std::move( verts_in ) ), indices( std::move( indices_in ) )
 	{
 		assert( vertices.Size() > 2 );
@@ -51,5 +51,6 @@ public:
 	}
 public:
 	VertexMeta::VertexBuffer vertices;
-	std::vector<unsigned short> indices;
+	// index buffers made from these are 16 bit whenever the indices fit
+	std::vector<unsigned int> indices;
 };
\ No newline at end of file
@@ -2,11 +2,12 @@
 #include "VertexShader.h"
 #include "BindableCodex.h"
 #include "GraphicsThrowMacros.h"
+#include "FrameCapture.h"
 
 namespace Bind
 {
 	InputLayout::InputLayout( Graphics& gfx, VertexMeta::VertexLayout layout_in, const VertexShader& vs )
-		: layout( std::move( layout_in ) )
+		: vertexShaderKey( vs.GetKey() ), layout( std::move( layout_in ) )
 	{
 		INFOMANAGER( gfx );
 
@@ -20,12 +21,13 @@ namespace Bind
 			pByteCode->GetBufferSize(),
 			&pInputLayout
 		) );
+		FrameCapture::AttachCreationData( pInputLayout.Get(), d3dLayout, pByteCode );
 	}
 
 	void InputLayout::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER_NOHR( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->IASetInputLayout( pInputLayout.Get() ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).IASetInputLayout( pInputLayout.Get() ) );
 	}
 
 	const VertexMeta::VertexLayout InputLayout::GetLayout() const noexcept
@@ -38,15 +40,24 @@ namespace Bind
 		return Codex::Resolve<InputLayout>( gfx, layout, vs );
 	}
 
-	std::string InputLayout::GenerateUID( const VertexMeta::VertexLayout& layout, const VertexShader& vs )
+	BindKey InputLayout::GenerateKey( const VertexMeta::VertexLayout& layout, const VertexShader& vs )
 	{
-		using namespace std::string_literals;
-		return typeid( InputLayout ).name() + "#"s + layout.GetCode() + "#"s + vs.GetUID();
+		return MakeKey( layout, vs.GetKey() );
 	}
 
-	std::string InputLayout::GetUID() const noexcept
+	BindKey InputLayout::GetKey() const noexcept(!IS_DEBUG)
 	{
-		using namespace std::string_literals;
-		return typeid( InputLayout ).name() + "#"s + layout.GetCode() + "#"s + vertexShaderUID;
+		return MakeKey( layout, vertexShaderKey );
+	}
+
+	BindKey InputLayout::MakeKey( const VertexMeta::VertexLayout& layout, const BindKey& vertexShaderKey ) noexcept(!IS_DEBUG)
+	{
+		// fold element codes in one by one rather than building the layout code string
+		auto key = BindKey::Make<InputLayout>();
+		for ( size_t i = 0; i < layout.GetElementCount(); i++ )
+		{
+			key.Add( layout.ResolveByIndex( i ).GetCode() );
+		}
+		return key.Add( vertexShaderKey );
 	}
 }
\ No newline at end of file
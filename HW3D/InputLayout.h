@@ -13,10 +13,12 @@ namespace Bind
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		const VertexMeta::VertexLayout GetLayout() const noexcept;
 		static std::shared_ptr<InputLayout> Resolve( Graphics& gfx, const VertexMeta::VertexLayout& layout, const VertexShader& vs );
-		static std::string GenerateUID( const VertexMeta::VertexLayout& layout, const VertexShader& vs );
-		std::string GetUID() const noexcept override;
+		static BindKey GenerateKey( const VertexMeta::VertexLayout& layout, const VertexShader& vs );
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
+	private:
+		static BindKey MakeKey( const VertexMeta::VertexLayout& layout, const BindKey& vertexShaderKey ) noexcept(!IS_DEBUG);
 	protected:
-		std::string vertexShaderUID;
+		BindKey vertexShaderKey;
 		VertexMeta::VertexLayout layout;
 		Microsoft::WRL::ComPtr<ID3D11InputLayout> pInputLayout;
 	};
@@ -0,0 +1,64 @@
+#pragma once
+#include "Bindable.h"
+#include "GraphicsThrowMacros.h"
+#include <algorithm>
+
+namespace Bind
+{
+	// dynamic structured buffer of per-instance data read by instanced vertex shaders through SV_InstanceID
+	template<typename T>
+	class InstanceBuffer : public Bindable
+	{
+	public:
+		InstanceBuffer( Graphics& gfx, UINT capacity, UINT slot = 0u ) : capacity( capacity ), slot( slot )
+		{
+			INFOMANAGER( gfx );
+
+			D3D11_BUFFER_DESC bd = {};
+			bd.ByteWidth = UINT( sizeof( T ) * capacity );
+			bd.Usage = D3D11_USAGE_DYNAMIC;
+			bd.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+			bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+			bd.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+			bd.StructureByteStride = sizeof( T );
+			GFX_THROW_INFO( GetDevice( gfx )->CreateBuffer( &bd, nullptr, &pBuffer ) );
+
+			D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+			srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+			srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+			srvDesc.Buffer.FirstElement = 0u;
+			srvDesc.Buffer.NumElements = capacity;
+			GFX_THROW_INFO( GetDevice( gfx )->CreateShaderResourceView( pBuffer.Get(), &srvDesc, &pBufferView ) );
+		}
+		void Update( Graphics& gfx, const T* pData, UINT count ) noexcept(!IS_DEBUG)
+		{
+			INFOMANAGER( gfx );
+			assert( count <= capacity );
+
+			D3D11_MAPPED_SUBRESOURCE msr{};
+			GFX_THROW_INFO( GetContext( gfx )->Map( pBuffer.Get(), 0u, D3D11_MAP_WRITE_DISCARD, 0u, &msr ) );
+			memcpy( msr.pData, pData, sizeof( T ) * std::min( count, capacity ) );
+			GetContext( gfx )->Unmap( pBuffer.Get(), 0u );
+			if ( const auto pLog = gfx.GetLog() )
+				pLog->Add( CommandLog::Type::Upload, "InstanceBuffer", slot, sizeof( T ) * count, pBuffer.Get(), pData, sizeof( T ) * count );
+		}
+		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override
+		{
+			INFOMANAGER_NOHR( gfx );
+			GFX_THROW_INFO_ONLY( GetStateCache( gfx ).VSSetShaderResource( slot, pBufferView.Get() ) );
+		}
+		UINT GetCapacity() const noexcept
+		{
+			return capacity;
+		}
+		size_t GetSizeInBytes() const noexcept override
+		{
+			return sizeof( T ) * capacity;
+		}
+	private:
+		UINT capacity;
+		UINT slot;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> pBuffer;
+		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pBufferView;
+	};
+}
\ No newline at end of file
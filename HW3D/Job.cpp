@@ -4,13 +4,39 @@
 
 namespace Rgph
 {
-	Job::Job(const Step* pStep, const Drawable* pDrawable)
-		: pDrawable{ pDrawable }, pStep{ pStep } { }
+	Job::Job(const Step* pStep, const Drawable* pDrawable, const DirectX::XMFLOAT4X4* pTransform)
+		: pDrawable{ pDrawable }, pStep{ pStep }, pTransform{ pTransform } { }
 
 	void Job::Execute(Graphics& gfx) const noexcept(!IS_DEBUG)
 	{
+		pExecuting = this;
 		pDrawable->Bind(gfx);
 		pStep->Bind(gfx);
+		pExecuting = nullptr;
 		gfx.DrawIndexed(pDrawable->GetIndexCount());
 	}
+
+	const Step& Job::GetStep() const noexcept
+	{
+		return *pStep;
+	}
+
+	const Drawable& Job::GetDrawable() const noexcept
+	{
+		return *pDrawable;
+	}
+
+	DirectX::XMMATRIX Job::GetTransformXM() const noexcept
+	{
+		if ( pTransform )
+			return DirectX::XMLoadFloat4x4( pTransform );
+		return pDrawable->GetTransformXM();
+	}
+
+	const Job* Job::GetExecuting() noexcept
+	{
+		return pExecuting;
+	}
+
+	thread_local const Job* Job::pExecuting = nullptr;
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstdint>
+#include <DirectXMath.h>
 
 class Drawable;
 class Graphics;
@@ -9,10 +11,20 @@ namespace Rgph
 	class Job
 	{
 	public:
-		Job(const Step* pStep, const Drawable* pDrawable);
+		// pTransform overrides the drawable's world matrix - set when one drawable is submitted for several nodes
+		Job(const Step* pStep, const Drawable* pDrawable, const DirectX::XMFLOAT4X4* pTransform = nullptr);
 		void Execute(Graphics& gfx) const noexcept(!IS_DEBUG);
+		const Step& GetStep() const noexcept;
+		const Drawable& GetDrawable() const noexcept;
+		DirectX::XMMATRIX GetTransformXM() const noexcept;
+		// the job executing on the calling thread, if any - read by the per-object bindables it binds
+		static const Job* GetExecuting() noexcept;
+		// order of the job within its pass - filled in by the pass according to its sort policy
+		uint64_t sortKey = 0u;
 	private:
 		const class Drawable* pDrawable;
 		const class Step* pStep;
+		const DirectX::XMFLOAT4X4* pTransform;
+		static thread_local const Job* pExecuting;
 	};
 }
\ No newline at end of file
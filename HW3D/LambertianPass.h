@@ -9,6 +9,7 @@
 #include "DepthStencil.h"
 #include "ShadowCameraCbuf.h"
 #include "ShadowSampler.h"
+#include "PointLight.h"
 #include <vector>
 
 class Graphics;
@@ -19,7 +20,7 @@ namespace Rgph
 	{
 	public:
 		LambertianPass(Graphics& gfx, std::string name) :
-			RenderQueuePass(std::move(name)),
+			RenderQueuePass(std::move(name), {}, SortPolicy::State),
 			pShadowCbuf{ std::make_shared<Bind::ShadowCameraCbuf>( gfx ) }
 		{
 			AddBind( pShadowCbuf );
@@ -40,15 +41,23 @@ namespace Rgph
 		{
 			pShadowCbuf->SetCamera( &cam );
 		}
+		void BindLight( const PointLight& light ) noexcept
+		{
+			pLight = &light;
+		}
 		void Execute( Graphics& gfx ) const noexcept(!IS_DEBUG) override
 		{
 			assert( pMainCamera );
+			assert( pLight );
 			pShadowCbuf->Update( gfx );
 			pMainCamera->BindToGraphics( gfx );
+			// bound by the pass because a recorded pass does not see what was bound before the graph executed
+			pLight->Bind( gfx, gfx.GetCamera() );
 			RenderQueuePass::Execute( gfx );
 		}
 	private:
 		std::shared_ptr<Bind::ShadowCameraCbuf> pShadowCbuf;
 		const Camera* pMainCamera = nullptr;
+		const PointLight* pLight = nullptr;
 	};
 }
\ No newline at end of file
@@ -1,24 +1,52 @@
 #include "LayoutCodex.h"
+#include <mutex>
 
 namespace Dcb
 {
 	CompleteLayout LayoutCodex::Resolve( RawLayout&& layout ) noexcept(!IS_DEBUG)
 	{
-		auto sig = layout.GetSignature();
-		auto& map = Get_().map;
-		const auto i = map.find( sig );
+		const auto hash = layout.GetHash();
+		// low bits select the bucket inside the shard map so shard on the high bits
+		auto& shard = Get_().shards[( hash >> 60 ) % nShards];
 
 		// identical layout already exists
-		if ( i != map.end() )
 		{
-			layout.ClearRoot();
-			return { i->second };
+			std::shared_lock lock{ shard.mutex };
+			if ( const auto pExisting = Find( shard, hash, *layout.pRoot ) )
+			{
+				layout.ClearRoot();
+				return *pExisting;
+			}
 		}
 
-		// otherwise add layout root element to map
-		auto result = map.insert( { std::move( sig ), layout.DeliverRoot() } );
+		// otherwise finalize the tree and bake its flattened table outside of the lock
+		auto pRoot = layout.DeliverRoot();
+		auto pFlat = std::make_shared<const FlatLayout>( *pRoot, hash );
+
+		std::unique_lock lock{ shard.mutex };
+		// another thread may have registered the same layout while this one was baking
+		if ( const auto pExisting = Find( shard, hash, *pRoot ) )
+		{
+			return *pExisting;
+		}
+		auto& bucket = shard.map[hash];
+		bucket.push_back( CompleteLayout{ std::move( pRoot ), std::move( pFlat ) } );
 		// return layout with extra ref to root
-		return { result.first->second };
+		return bucket.back();
+	}
+
+	size_t LayoutCodex::GetLayoutCount() noexcept
+	{
+		size_t count = 0u;
+		for ( const auto& shard : Get_().shards )
+		{
+			std::shared_lock lock{ shard.mutex };
+			for ( const auto& bucket : shard.map )
+			{
+				count += bucket.second.size();
+			}
+		}
+		return count;
 	}
 
 	LayoutCodex& LayoutCodex::Get_() noexcept
@@ -26,4 +54,22 @@ namespace Dcb
 		static LayoutCodex codex;
 		return codex;
 	}
+
+	const CompleteLayout* LayoutCodex::Find( const Shard& shard, uint64_t hash, const LayoutElement& root ) noexcept(!IS_DEBUG)
+	{
+		const auto i = shard.map.find( hash );
+		if ( i == shard.map.end() )
+		{
+			return nullptr;
+		}
+		// hashes matched, confirm the structures really are identical
+		for ( const auto& layout : i->second )
+		{
+			if ( layout.pRoot->StructurallyEquals( root ) )
+			{
+				return &layout;
+			}
+		}
+		return nullptr;
+	}
 }
\ No newline at end of file
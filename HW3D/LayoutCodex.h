@@ -1,17 +1,33 @@
 #pragma once
 #include "DynamicConstant.h"
 #include <unordered_map>
+#include <shared_mutex>
 #include <string>
 #include <memory>
+#include <vector>
+#include <array>
 
 namespace Dcb
 {
+	// registry of finalized layouts keyed by structural hash
+	// safe to resolve from multiple threads - lookups take a shared lock on one shard only
 	class LayoutCodex
 	{
 	public:
 		static CompleteLayout Resolve( RawLayout&& layout ) noexcept(!IS_DEBUG);
+		// number of distinct layouts registered
+		static size_t GetLayoutCount() noexcept;
 	private:
+		static constexpr size_t nShards = 16u;
+		struct Shard
+		{
+			mutable std::shared_mutex mutex;
+			// buckets only hold more than one layout when structural hashes collide
+			std::unordered_map<uint64_t, std::vector<CompleteLayout>> map;
+		};
 		static LayoutCodex& Get_() noexcept;
-		std::unordered_map<std::string, std::shared_ptr<LayoutElement>> map;
+		// must be called with the shard locked
+		static const CompleteLayout* Find( const Shard& shard, uint64_t hash, const LayoutElement& root ) noexcept(!IS_DEBUG);
+		std::array<Shard, nShards> shards;
 	};
 }
\ No newline at end of file
@@ -3,11 +3,29 @@
 #include "Channels.h"
 #include "BindableCommon.h"
 #include "DynamicConstant.h"
+#include "StaticLayout.h"
 #include "ConstantBufferEx.h"
 #include "TransformCbufScaling.h"
+#include "Surface.h"
+#include "MeshOptimizer.h"
 
-Material::Material( Graphics& gfx, const aiMaterial& material, const std::filesystem::path& path ) noexcept(!IS_DEBUG)
-	: modelPath( path.string() )
+namespace
+{
+	std::shared_ptr<Bind::Texture> ResolveTexture( Graphics& gfx, const std::string& path, UINT slot, const Material::SurfaceMap* pSurfaces )
+	{
+		if ( pSurfaces )
+		{
+			if ( const auto i = pSurfaces->find( path ); i != pSurfaces->end() )
+			{
+				return Bind::Texture::Resolve( gfx, path, slot, i->second );
+			}
+		}
+		return Bind::Texture::Resolve( gfx, path, slot );
+	}
+}
+
+Material::Material( Graphics& gfx, const aiMaterial& material, const std::filesystem::path& path, const SurfaceMap* pSurfaces ) noexcept(!IS_DEBUG)
+	: layout( MakeLayout( material ) ), modelPath( path.string() )
 {
 	const auto rootPath = path.parent_path().string() + "\\";
 	{
@@ -23,8 +41,6 @@ Material::Material( Graphics& gfx, const aiMaterial& material, const std::filesy
 		aiString texFileName;
 
 		// common - pre
-		layout.Append( VertexMeta::VertexLayout::Position3D );
-		layout.Append( VertexMeta::VertexLayout::Normal );
 		Dcb::RawLayout rawLayout;
 		bool hasTexture = false;
 		bool hasGlossAlpha = false;
@@ -36,8 +52,7 @@ Material::Material( Graphics& gfx, const aiMaterial& material, const std::filesy
 			{
 				hasTexture = true;
 				shaderCode += "Dif";
-				layout.Append( VertexMeta::VertexLayout::Texture2D );
-				auto tex = Bind::Texture::Resolve( gfx, rootPath + texFileName.C_Str() );
+				auto tex = ResolveTexture( gfx, rootPath + texFileName.C_Str(), 0u, pSurfaces );
 				if ( tex->HasAlpha() )
 				{
 					hasAlpha = true;
@@ -57,8 +72,7 @@ Material::Material( Graphics& gfx, const aiMaterial& material, const std::filesy
 			{
 				hasTexture = true;
 				shaderCode += "Spc";
-				layout.Append( VertexMeta::VertexLayout::Texture2D );
-				auto tex = Bind::Texture::Resolve( gfx, rootPath + texFileName.C_Str(), 1u );
+				auto tex = ResolveTexture( gfx, rootPath + texFileName.C_Str(), 1u, pSurfaces );
 				hasGlossAlpha = tex->HasAlpha();
 				step.AddBindable( std::move( tex ) );
 				rawLayout.Add<Dcb::Bool>( "useGlossAlpha" );
@@ -74,10 +88,7 @@ Material::Material( Graphics& gfx, const aiMaterial& material, const std::filesy
 			{
 				hasTexture = true;
 				shaderCode += "Nrm";
-				layout.Append( VertexMeta::VertexLayout::Texture2D );
-				layout.Append( VertexMeta::VertexLayout::Tangent );
-				layout.Append( VertexMeta::VertexLayout::Bitangent );
-				step.AddBindable( Bind::Texture::Resolve( gfx, rootPath + texFileName.C_Str(), 2u ) );
+				step.AddBindable( ResolveTexture( gfx, rootPath + texFileName.C_Str(), 2u, pSurfaces ) );
 				rawLayout.Add<Dcb::Bool>( "useNormalMap" );
 				rawLayout.Add<Dcb::Float>( "normalMapWeight" );
 			}
@@ -94,29 +105,29 @@ Material::Material( Graphics& gfx, const aiMaterial& material, const std::filesy
 				step.AddBindable( Bind::Sampler::Resolve( gfx ) );
 			// PS Material CBuf
 			Dcb::Buffer buf{ std::move( rawLayout ) };
-			if ( auto r = buf["materialColor"]; r.Exists() )
+			if ( const Dcb::FieldHandle<DirectX::XMFLOAT3> h{ buf, "materialColor" }; h.Exists() )
 			{
 				aiColor3D color = { 0.45f, 0.45f, 0.85f };
 				material.Get( AI_MATKEY_COLOR_DIFFUSE, color );
-				r = reinterpret_cast<DirectX::XMFLOAT3&>( color );
+				buf[h] = reinterpret_cast<DirectX::XMFLOAT3&>( color );
 			}
-			buf["useGlossAlpha"].SetIfExists( hasGlossAlpha );
-			buf["useSpecularMap"].SetIfExists( true );
-			if ( auto r = buf["specularColor"]; r.Exists() )
+			buf.SetIfExists( Dcb::FieldHandle<bool>{ buf, "useGlossAlpha" }, hasGlossAlpha );
+			buf.SetIfExists( Dcb::FieldHandle<bool>{ buf, "useSpecularMap" }, true );
+			if ( const Dcb::FieldHandle<DirectX::XMFLOAT3> h{ buf, "specularColor" }; h.Exists() )
 			{
 				aiColor3D color = { 0.18f, 0.18f, 0.18f };
 				material.Get( AI_MATKEY_COLOR_SPECULAR, color );
-				r = reinterpret_cast<DirectX::XMFLOAT3&>( color );
+				buf[h] = reinterpret_cast<DirectX::XMFLOAT3&>( color );
 			}
-			buf["specularWeight"].SetIfExists( 1.0f );
-			if ( auto r = buf["specularGloss"]; r.Exists() )
+			buf.SetIfExists( Dcb::FieldHandle<float>{ buf, "specularWeight" }, 1.0f );
+			if ( const Dcb::FieldHandle<float> h{ buf, "specularGloss" }; h.Exists() )
 			{
 				float gloss = 8.0f;
 				material.Get( AI_MATKEY_SHININESS, gloss );
-				r = gloss;
+				buf[h] = gloss;
 			}
-			buf["useNormalMap"].SetIfExists( true );
-			buf["normalMapWeight"].SetIfExists( 1.0f );
+			buf.SetIfExists( Dcb::FieldHandle<bool>{ buf, "useNormalMap" }, true );
+			buf.SetIfExists( Dcb::FieldHandle<float>{ buf, "normalMapWeight" }, 1.0f );
 			step.AddBindable( std::make_unique<Bind::CachingPixelConstantBufferEx>( gfx, std::move( buf ), 1u ) );
 		}
 		phong.AddStep( std::move( step ) );
@@ -137,10 +148,9 @@ Material::Material( Graphics& gfx, const aiMaterial& material, const std::filesy
 			Step draw( "outlineDraw" );
 
 			{
-				Dcb::RawLayout lay;
-				lay.Add<Dcb::Float3>( "materialColor" );
-				auto buf = Dcb::Buffer( std::move( lay ) );
-				buf["materialColor"] = DirectX::XMFLOAT3{ 1.0f, 0.4f, 0.4f };
+				using OutlineLayout = Dcb::StaticLayout<Dcb::Field<Dcb::Float3, "materialColor">>;
+				Dcb::Buffer buf{ OutlineLayout::Get() };
+				buf[OutlineLayout::Handle<"materialColor">()] = DirectX::XMFLOAT3{ 1.0f, 0.4f, 0.4f };
 				draw.AddBindable( std::make_shared<Bind::CachingPixelConstantBufferEx>( gfx, buf, 1u ) );
 			}
 
@@ -167,14 +177,87 @@ Material::Material( Graphics& gfx, const aiMaterial& material, const std::filesy
 	}
 }
 
+std::vector<std::string> Material::GetTexturePaths( const aiMaterial& material, const std::filesystem::path& path )
+{
+	// same textures the constructor resolves
+	const auto rootPath = path.parent_path().string() + "\\";
+	std::vector<std::string> paths;
+	aiString texFileName;
+	for ( const auto type : { aiTextureType_DIFFUSE, aiTextureType_SPECULAR, aiTextureType_NORMALS } )
+	{
+		if ( material.GetTexture( type, 0, &texFileName ) == aiReturn_SUCCESS )
+		{
+			paths.push_back( rootPath + texFileName.C_Str() );
+		}
+	}
+	return paths;
+}
+
+VertexMeta::VertexLayout Material::MakeLayout( const aiMaterial& material ) noexcept(!IS_DEBUG)
+{
+	// the vertex elements the phong technique's shaders take for the textures present
+	VertexMeta::VertexLayout layout;
+	aiString texFileName;
+	layout.Append( VertexMeta::VertexLayout::Position3D );
+	layout.Append( VertexMeta::VertexLayout::Normal );
+	if ( material.GetTexture( aiTextureType_DIFFUSE, 0, &texFileName ) == aiReturn_SUCCESS )
+	{
+		layout.Append( VertexMeta::VertexLayout::Texture2D );
+	}
+	if ( material.GetTexture( aiTextureType_SPECULAR, 0, &texFileName ) == aiReturn_SUCCESS )
+	{
+		layout.Append( VertexMeta::VertexLayout::Texture2D );
+	}
+	if ( material.GetTexture( aiTextureType_NORMALS, 0, &texFileName ) == aiReturn_SUCCESS )
+	{
+		layout.Append( VertexMeta::VertexLayout::Texture2D );
+		layout.Append( VertexMeta::VertexLayout::Tangent );
+		layout.Append( VertexMeta::VertexLayout::Bitangent );
+	}
+	return layout;
+}
+
+MeshGeometry Material::ExtractGeometry( const aiMesh& mesh, float scale ) const
+{
+	return ExtractGeometry( layout, mesh, scale, MakeMeshTag( mesh ) );
+}
+
+MeshGeometry Material::ExtractGeometry( const VertexMeta::VertexLayout& layout, const aiMesh& mesh, float scale, std::string tag )
+{
+	MeshGeometry geometry{ std::move( tag ), VertexMeta::VertexBuffer{ layout, mesh }, ExtractIndices( mesh ) };
+	if ( scale != 1.0f )
+	{
+		for ( size_t i = 0; i < geometry.vertices.Size(); i++ )
+		{
+			DirectX::XMFLOAT3& pos = geometry.vertices[i].Attr<VertexMeta::VertexLayout::ElementType::Position3D>();
+			pos.x *= scale;
+			pos.y *= scale;
+			pos.z *= scale;
+		}
+	}
+	if ( MeshOptimizer::Enabled() )
+	{
+		MeshOptimizer::Vertices vertices{ geometry.vertices.GetData(), geometry.vertices.Size(), layout.Size(),
+			layout.Resolve<VertexMeta::VertexLayout::Position3D>().GetOffset() };
+		MeshOptimizer::OptimizeVertexCache( geometry.indices, vertices.count );
+		if ( MeshOptimizer::OverdrawEnabled() )
+		{
+			MeshOptimizer::OptimizeOverdraw( geometry.indices, vertices );
+		}
+		MeshOptimizer::OptimizeVertexFetch( vertices, geometry.indices );
+		geometry.vertices.Resize( vertices.count );
+	}
+	return geometry;
+}
+
 VertexMeta::VertexBuffer Material::ExtractVertices( const aiMesh& mesh ) const noexcept
 {
 	return { layout, mesh };
 }
 
-std::vector<unsigned short> Material::ExtractIndices( const aiMesh& mesh ) const noexcept
+std::vector<unsigned int> Material::ExtractIndices( const aiMesh& mesh ) noexcept
 {
-	std::vector<unsigned short> indices;
+	std::vector<unsigned int> indices;
 	indices.reserve(mesh.mNumFaces * 3);
 	for (unsigned int i = 0; i < mesh.mNumFaces; i++)
 	{
@@ -213,6 +296,11 @@ std::vector<Technique> Material::GetTechniques() const noexcept
 	return techniques;
 }
 
+const VertexMeta::VertexLayout& Material::GetLayout() const noexcept
+{
+	return layout;
+}
+
 std::string Material::MakeMeshTag(const aiMesh& mesh) const noexcept
 {
 	return modelPath + "%" + mesh.mName.C_Str();
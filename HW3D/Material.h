@@ -3,10 +3,12 @@
 #include "Technique.h"
 #include "Graphics.h"
 #include <filesystem>
+#include <unordered_map>
 #include <vector>
 
 struct aiMaterial;
 struct aiMesh;
+class Surface;
 
 namespace Bind
 {
@@ -14,15 +16,39 @@ namespace Bind
 	class IndexBuffer;
 }
 
+// geometry of one mesh in the layout of its material, ready to be uploaded
+struct MeshGeometry
+{
+	// codex tag of the buffers
+	std::string tag;
+	VertexMeta::VertexBuffer vertices;
+	// 32 bit here - the index buffer narrows them to 16 bit when they fit
+	std::vector<unsigned int> indices;
+};
+
 class Material
 {
 public:
-	Material( Graphics& gfx, const aiMaterial& material, const std::filesystem::path& path ) noexcept(!IS_DEBUG);
+	// images decoded ahead of time, by path
+	using SurfaceMap = std::unordered_map<std::string, Surface>;
+public:
+	// textures found in the surfaces are created from them instead of being decoded here
+	Material( Graphics& gfx, const aiMaterial& material, const std::filesystem::path& path, const SurfaceMap* pSurfaces = nullptr ) noexcept(!IS_DEBUG);
+	// paths of the textures a material built from this description would use
+	static std::vector<std::string> GetTexturePaths( const aiMaterial& material, const std::filesystem::path& path );
+	// vertex elements of meshes drawn with a material built from this description
+	static VertexMeta::VertexLayout MakeLayout( const aiMaterial& material ) noexcept(!IS_DEBUG);
+	// touches no gpu resources, so meshes can be extracted on any thread
+	// triangles and vertices come out reordered for the gpu unless MeshOptimizer is disabled
+	MeshGeometry ExtractGeometry( const aiMesh& mesh, float scale = 1.0f ) const;
+	// for tools that have no graphics to build the material with
+	static MeshGeometry ExtractGeometry( const VertexMeta::VertexLayout& layout, const aiMesh& mesh, float scale, std::string tag );
 	VertexMeta::VertexBuffer ExtractVertices( const aiMesh& mesh ) const noexcept;
-	std::vector<unsigned short> ExtractIndices( const aiMesh& mesh ) const noexcept;
+	static std::vector<unsigned int> ExtractIndices( const aiMesh& mesh ) noexcept;
 	std::shared_ptr<Bind::VertexBuffer> MakeVertexBindable( Graphics& gfx, const aiMesh& mesh, float scale = 1.0f ) const noexcept(!IS_DEBUG);
 	std::shared_ptr<Bind::IndexBuffer> MakeIndexBindable( Graphics& gfx, const aiMesh& mesh ) const noexcept(!IS_DEBUG);
 	std::vector<Technique> GetTechniques() const noexcept;
+	const VertexMeta::VertexLayout& GetLayout() const noexcept;
 private:
 	std::string MakeMeshTag( const aiMesh& mesh ) const noexcept;
 private:
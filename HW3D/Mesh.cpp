@@ -11,13 +11,12 @@
 
 Mesh::Mesh( Graphics& gfx, const Material& mat, const aiMesh& mesh, float scale ) noexcept(!IS_DEBUG) : Drawable( gfx, mat, mesh, scale ) { }
 
-void Mesh::Submit( size_t channels, DirectX::FXMMATRIX accumulatedTransform ) const noexcept(!IS_DEBUG)
-{
-	DirectX::XMStoreFloat4x4( &transform, accumulatedTransform );
-	Drawable::Submit( channels );
-}
+Mesh::Mesh( Graphics& gfx, const Material& mat, MeshGeometry&& geometry ) noexcept(!IS_DEBUG) : Drawable( gfx, mat, std::move( geometry ) ) { }
+
+Mesh::Mesh( Graphics& gfx, const Material& mat, std::shared_ptr<Bind::VertexBuffer> pVertices, std::shared_ptr<Bind::IndexBuffer> pIndices ) noexcept(!IS_DEBUG)
+	: Drawable( gfx, mat, std::move( pVertices ), std::move( pIndices ) ) { }
 
 DirectX::XMMATRIX Mesh::GetTransformXM() const noexcept
 {
-	return DirectX::XMLoadFloat4x4( &transform );
+	return DirectX::XMMatrixIdentity();
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Drawable.h"
 
 class Material;
+struct MeshGeometry;
 class FrameCommander;
 struct aiMesh;
 
@@ -10,8 +11,8 @@ class Mesh : public Drawable
 {
 public:
 	Mesh( Graphics& gfx, const Material& mat, const aiMesh& mesh, float scale = 1.0f ) noexcept(!IS_DEBUG);
-	void Submit( size_t channels, DirectX::FXMMATRIX accumulatedTransform ) const noexcept(!IS_DEBUG);
+	Mesh( Graphics& gfx, const Material& mat, MeshGeometry&& geometry ) noexcept(!IS_DEBUG);
+	Mesh( Graphics& gfx, const Material& mat, std::shared_ptr<Bind::VertexBuffer> pVertices, std::shared_ptr<Bind::IndexBuffer> pIndices ) noexcept(!IS_DEBUG);
+	// identity - a mesh may belong to several nodes, so each node's world matrix is handed in on submit
 	DirectX::XMMATRIX GetTransformXM() const noexcept override;
-private:
-	mutable DirectX::XMFLOAT4X4 transform;
 };
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include "MeshOptimizer.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	// the lru cache the ordering models - larger than the hardware's, as the ordering only needs it to be roughly right
+	constexpr size_t scoringCacheSize = 32u;
+	constexpr float cacheDecayPower = 1.5f;
+	// the last triangle's vertices score a fixed amount, so the order does not just fan around one vertex
+	constexpr float lastTriangleScore = 0.75f;
+	// vertices with few triangles left are favoured, so they are finished off and leave no lone triangles behind
+	constexpr float valenceBoostScale = 2.0f;
+	constexpr float valenceBoostPower = 0.5f;
+
+	float VertexScore( int cachePosition, unsigned int valence ) noexcept
+	{
+		if ( valence == 0u )
+		{
+			return -1.0f;
+		}
+		float score = 0.0f;
+		if ( cachePosition >= 0 )
+		{
+			if ( cachePosition < 3 )
+			{
+				score = lastTriangleScore;
+			}
+			else
+			{
+				const float scale = 1.0f / float( scoringCacheSize - 3u );
+				score = std::pow( 1.0f - float( cachePosition - 3 ) * scale, cacheDecayPower );
+			}
+		}
+		return score + valenceBoostScale * std::pow( float( valence ), -valenceBoostPower );
+	}
+
+	DirectX::XMVECTOR LoadPosition( const MeshOptimizer::Vertices& vertices, unsigned int index ) noexcept(!IS_DEBUG)
+	{
+		assert( index < vertices.count );
+		return DirectX::XMLoadFloat3( reinterpret_cast<const DirectX::XMFLOAT3*>(
+			vertices.pData + vertices.stride * index + vertices.positionOffset ) );
+	}
+}
+
+MeshOptimizer::CacheStatistics MeshOptimizer::AnalyzeVertexCache( const std::vector<unsigned int>& indices, size_t vertexCount, size_t cacheSize ) noexcept
+{
+	CacheStatistics stats;
+	if ( indices.size() < 3u )
+	{
+		return stats;
+	}
+	// a vertex is still cached while fewer than cacheSize misses have happened since it was loaded
+	// stamps hold the miss count right after each vertex was loaded, zero for never loaded
+	std::vector<size_t> stamps( vertexCount, 0u );
+	size_t misses = 0u;
+	size_t used = 0u;
+	for ( const auto i : indices )
+	{
+		if ( stamps[i] == 0u )
+		{
+			used++;
+		}
+		if ( stamps[i] == 0u || misses - stamps[i] >= cacheSize )
+		{
+			stamps[i] = ++misses;
+		}
+	}
+	stats.acmr = float( misses ) / float( indices.size() / 3u );
+	stats.atvr = float( misses ) / float( used );
+	return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache( std::vector<unsigned int>& indices, size_t vertexCount )
+{
+	const size_t nTriangles = indices.size() / 3u;
+	if ( nTriangles < 2u )
+	{
+		return;
+	}
+
+	// triangles of each vertex, packed - the first valence entries of each range are the ones not yet emitted
+	std::vector<unsigned int> valences( vertexCount, 0u );
+	for ( const auto i : indices )
+	{
+		valences[i]++;
+	}
+	std::vector<unsigned int> offsets( vertexCount + 1u, 0u );
+	for ( size_t v = 0; v < vertexCount; v++ )
+	{
+		offsets[v + 1u] = offsets[v] + valences[v];
+	}
+	std::vector<unsigned int> adjacency( indices.size() );
+	{
+		std::vector<unsigned int> fill( offsets.begin(), offsets.end() - 1 );
+		for ( size_t i = 0; i < indices.size(); i++ )
+		{
+			adjacency[fill[indices[i]]++] = (unsigned int)( i / 3u );
+		}
+	}
+
+	std::vector<int> cachePositions( vertexCount, -1 );
+	std::vector<float> vertexScores( vertexCount );
+	for ( size_t v = 0; v < vertexCount; v++ )
+	{
+		vertexScores[v] = VertexScore( -1, valences[v] );
+	}
+	std::vector<float> triangleScores( nTriangles );
+	for ( size_t t = 0; t < nTriangles; t++ )
+	{
+		triangleScores[t] = vertexScores[indices[t * 3u]] + vertexScores[indices[t * 3u + 1u]] + vertexScores[indices[t * 3u + 2u]];
+	}
+	std::vector<bool> emitted( nTriangles, false );
+
+	std::vector<unsigned int> ordered;
+	ordered.reserve( indices.size() );
+	// the emitted triangle's vertices go in front, so the cache briefly holds three more than it keeps
+	std::vector<unsigned int> cache;
+	std::vector<unsigned int> nextCache;
+	cache.reserve( scoringCacheSize + 3u );
+	nextCache.reserve( scoringCacheSize + 3u );
+	size_t cursor = 0u;
+	size_t best = nTriangles;
+	while ( ordered.size() < indices.size() )
+	{
+		// nothing in the cache has triangles left - start over from the first triangle not yet emitted
+		if ( best == nTriangles )
+		{
+			while ( emitted[cursor] )
+			{
+				cursor++;
+			}
+			best = cursor;
+		}
+		emitted[best] = true;
+		const unsigned int* pTriangle = &indices[best * 3u];
+		ordered.insert( ordered.end(), pTriangle, pTriangle + 3u );
+
+		nextCache.assign( pTriangle, pTriangle + 3u );
+		for ( size_t k = 0; k < 3u; k++ )
+		{
+			// swap the triangle out of the vertex's live range
+			const auto v = pTriangle[k];
+			const auto begin = adjacency.begin() + offsets[v];
+			const auto end = begin + valences[v];
+			std::iter_swap( std::find( begin, end, (unsigned int)best ), end - 1 );
+			valences[v]--;
+		}
+		for ( const auto v : cache )
+		{
+			if ( v != pTriangle[0] && v != pTriangle[1] && v != pTriangle[2] )
+			{
+				nextCache.push_back( v );
+			}
+		}
+
+		// rescore the cached vertices, including those just pushed out, and carry the change over to their triangles
+		for ( size_t i = 0; i < nextCache.size(); i++ )
+		{
+			const auto v = nextCache[i];
+			cachePositions[v] = i < scoringCacheSize ? int( i ) : -1;
+			const auto score = VertexScore( cachePositions[v], valences[v] );
+			const auto delta = score - vertexScores[v];
+			vertexScores[v] = score;
+			for ( auto a = offsets[v]; a < offsets[v] + valences[v]; a++ )
+			{
+				triangleScores[adjacency[a]] += delta;
+			}
+		}
+		nextCache.resize( std::min( nextCache.size(), scoringCacheSize ) );
+		std::swap( cache, nextCache );
+
+		// the next triangle is the best one touching the cache
+		best = nTriangles;
+		float bestScore = -std::numeric_limits<float>::max();
+		for ( const auto v : cache )
+		{
+			for ( auto a = offsets[v]; a < offsets[v] + valences[v]; a++ )
+			{
+				const auto t = adjacency[a];
+				if ( triangleScores[t] > bestScore )
+				{
+					bestScore = triangleScores[t];
+					best = t;
+				}
+			}
+		}
+	}
+	indices = std::move( ordered );
+}
+
+void MeshOptimizer::OptimizeOverdraw( std::vector<unsigned int>& indices, const Vertices& vertices, float threshold )
+{
+	namespace dx = DirectX;
+	const size_t nTriangles = indices.size() / 3u;
+	if ( nTriangles < 2u )
+	{
+		return;
+	}
+	const auto totalAcmr = AnalyzeVertexCache( indices, vertices.count ).acmr;
+
+	// clusters start where a triangle misses with all three vertices, as long as the cluster so far has an
+	// acmr within the threshold of the whole order's - moving it then costs little reuse
+	std::vector<size_t> clusterStarts{ 0u };
+	{
+		constexpr size_t cacheSize = 16u;
+		std::vector<size_t> stamps( vertices.count, 0u );
+		size_t misses = 0u;
+		size_t clusterMisses = 0u;
+		for ( size_t t = 0; t < nTriangles; t++ )
+		{
+			size_t triangleMisses = 0u;
+			for ( size_t k = 0; k < 3u; k++ )
+			{
+				const auto i = indices[t * 3u + k];
+				if ( stamps[i] == 0u || misses - stamps[i] >= cacheSize )
+				{
+					stamps[i] = ++misses;
+					triangleMisses++;
+				}
+			}
+			const auto clusterTriangles = t - clusterStarts.back();
+			if ( triangleMisses == 3u && clusterTriangles > 0u &&
+				float( clusterMisses ) / float( clusterTriangles ) <= totalAcmr * threshold )
+			{
+				clusterStarts.push_back( t );
+				clusterMisses = 0u;
+			}
+			clusterMisses += triangleMisses;
+		}
+	}
+	clusterStarts.push_back( nTriangles );
+
+	// clusters facing out from the mesh center tend to occlude the rest, so they go first
+	const size_t nClusters = clusterStarts.size() - 1u;
+	std::vector<dx::XMFLOAT3> centroids( nClusters );
+	std::vector<dx::XMFLOAT3> normals( nClusters );
+	auto meshCentroid = dx::XMVectorZero();
+	for ( size_t c = 0; c < nClusters; c++ )
+	{
+		auto centroid = dx::XMVectorZero();
+		auto normal = dx::XMVectorZero();
+		for ( size_t t = clusterStarts[c]; t < clusterStarts[c + 1u]; t++ )
+		{
+			const auto p0 = LoadPosition( vertices, indices[t * 3u] );
+			const auto p1 = LoadPosition( vertices, indices[t * 3u + 1u] );
+			const auto p2 = LoadPosition( vertices, indices[t * 3u + 2u] );
+			centroid = dx::XMVectorAdd( centroid, dx::XMVectorAdd( p0, dx::XMVectorAdd( p1, p2 ) ) );
+			// area weighted
+			normal = dx::XMVectorAdd( normal, dx::XMVector3Cross( dx::XMVectorSubtract( p1, p0 ), dx::XMVectorSubtract( p2, p0 ) ) );
+		}
+		meshCentroid = dx::XMVectorAdd( meshCentroid, centroid );
+		const auto count = float( ( clusterStarts[c + 1u] - clusterStarts[c] ) * 3u );
+		dx::XMStoreFloat3( &centroids[c], dx::XMVectorScale( centroid, 1.0f / count ) );
+		dx::XMStoreFloat3( &normals[c], dx::XMVector3Normalize( normal ) );
+	}
+	meshCentroid = dx::XMVectorScale( meshCentroid, 1.0f / float( indices.size() ) );
+	std::vector<float> sortKeys( nClusters );
+	for ( size_t c = 0; c < nClusters; c++ )
+	{
+		const auto outward = dx::XMVectorSubtract( dx::XMLoadFloat3( &centroids[c] ), meshCentroid );
+		sortKeys[c] = dx::XMVectorGetX( dx::XMVector3Dot( outward, dx::XMLoadFloat3( &normals[c] ) ) );
+	}
+	std::vector<size_t> order( nClusters );
+	for ( size_t c = 0; c < nClusters; c++ )
+	{
+		order[c] = c;
+	}
+	std::stable_sort( order.begin(), order.end(), [&sortKeys]( size_t a, size_t b ) { return sortKeys[a] > sortKeys[b]; } );
+
+	std::vector<unsigned int> sorted;
+	sorted.reserve( indices.size() );
+	for ( const auto c : order )
+	{
+		sorted.insert( sorted.end(), indices.begin() + clusterStarts[c] * 3u, indices.begin() + clusterStarts[c + 1u] * 3u );
+	}
+	indices = std::move( sorted );
+}
+
+void MeshOptimizer::OptimizeVertexFetch( Vertices& vertices, std::vector<unsigned int>& indices )
+{
+	constexpr auto unused = std::numeric_limits<unsigned int>::max();
+	std::vector<unsigned int> remap( vertices.count, unused );
+	unsigned int next = 0u;
+	for ( auto& i : indices )
+	{
+		if ( remap[i] == unused )
+		{
+			remap[i] = next++;
+		}
+		i = remap[i];
+	}
+
+	const auto stride = vertices.stride;
+	std::vector<char> reordered( size_t( next ) * stride );
+	for ( size_t v = 0; v < remap.size(); v++ )
+	{
+		if ( remap[v] != unused )
+		{
+			memcpy( reordered.data() + remap[v] * stride, vertices.pData + v * stride, stride );
+		}
+	}
+	if ( !reordered.empty() )
+	{
+		memcpy( vertices.pData, reordered.data(), reordered.size() );
+	}
+	vertices.count = next;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+// reorders indexed triangle lists for the gpu, without changing what they draw
+// - vertex cache: Forsyth's greedy ordering, picking the next triangle by how recently its vertices were used
+//   and how few triangles they have left, so vertices are reused while still in the post-transform cache
+// - overdraw: clusters of the cache order sorted so those facing away from the mesh center are drawn first
+// - vertex fetch: vertices renumbered in the order the triangles first use them
+// vertices are taken as raw interleaved bytes, so nothing here depends on the d3d vertex layout types
+class MeshOptimizer
+{
+public:
+	struct Vertices
+	{
+		char* pData;
+		size_t count;
+		size_t stride;
+		// byte offset of the float3 position inside a vertex
+		size_t positionOffset;
+	};
+	// what a simulated fifo post-transform cache would have to transform
+	struct CacheStatistics
+	{
+		// vertices transformed per triangle - 3 at worst, approaching 0.5 for large regular meshes
+		float acmr = 0.0f;
+		// vertices transformed per vertex used - 1 at best
+		float atvr = 0.0f;
+	};
+public:
+	static CacheStatistics AnalyzeVertexCache( const std::vector<unsigned int>& indices, size_t vertexCount, size_t cacheSize = 16u ) noexcept;
+	static void OptimizeVertexCache( std::vector<unsigned int>& indices, size_t vertexCount );
+	// expects indices in vertex cache order - clusters are only split where that costs less than the
+	// threshold times the order's acmr
+	static void OptimizeOverdraw( std::vector<unsigned int>& indices, const Vertices& vertices, float threshold = 1.05f );
+	// drops vertices no triangle uses - renumbers the vertices, so it runs last
+	// the used vertices are packed to the front of the data and count is lowered to match, the caller shrinks its storage
+	static void OptimizeVertexFetch( Vertices& vertices, std::vector<unsigned int>& indices );
+	// both apply to meshes extracted from then on
+	static bool& Enabled() noexcept
+	{
+		static bool enabled = true;
+		return enabled;
+	}
+	// off by default - it trades a little vertex reuse for less overdraw, which only pays off on opaque, depth tested meshes
+	static bool& OverdrawEnabled() noexcept
+	{
+		static bool enabled = false;
+		return enabled;
+	}
+};
\ No newline at end of file
@@ -4,13 +4,129 @@
 #include "Mesh.h"
 #include "MathX.h"
 #include "Material.h"
+#include "ParallelSubmitter.h"
+#include "Profiler.h"
+#include "Surface.h"
+#include "ThreadPool.h"
+#include "Timer.h"
+#include "ModelBaker.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
+#include <atomic>
+#include <optional>
+#include <unordered_set>
 
-Model::Model(Graphics& gfx, const std::string& pathString, const float scale)
+namespace
 {
+	// runs the tasks on the pool when there is one - each task only writes its own slot
+	void ForEach( ThreadPool* pPool, size_t count, const std::function<void( size_t )>& task )
+	{
+		if ( !pPool )
+		{
+			for ( size_t i = 0; i < count; i++ )
+				task( i );
+			return;
+		}
+		ThreadPool::TaskGroup group;
+		for ( size_t i = 0; i < count; i++ )
+			pPool->Run( group, [&task, i] { task( i ); } );
+		pPool->Wait( group );
+	}
+}
+
+// everything a load carries from its cpu stages to its gpu stage
+struct Model::Staging
+{
+	Staging( const std::string& pathString, float scale, ThreadPool* pPool )
+		:
+		pathString( pathString ),
+		scale( scale ),
+		pPool( pPool )
+	{}
+	std::string pathString;
+	float scale;
+	ThreadPool* pPool;
+	// materials and meshes come from either an import or a baked file
 	Assimp::Importer importer;
+	const aiScene* pScene = nullptr;
+	std::unique_ptr<ModelBaker::File> pBaked;
+	std::vector<const aiMaterial*> materialDescs;
+	// textures are found next to this model
+	std::string texturePath;
+	Material::SurfaceMap surfaces;
+	// imported meshes only - baked vertices are already in their final layout
+	std::vector<std::optional<MeshGeometry>> geometry;
+	// the parse, each image, each mesh and the gpu stage
+	std::atomic<size_t> stepsDone = 0u;
+	std::atomic<size_t> stepsTotal = 2u;
+	// a streamed load's cpu stages
+	ThreadPool::TaskGroup group;
+};
+
+Model::Model(Graphics& gfx, const std::string& pathString, const float scale, ThreadPool* pPool)
+{
+	PROFILE_SCOPE( "Model::Model" );
+	Staging staging{ pathString, scale, pPool };
+	Prepare( staging );
+	Finish( gfx, staging );
+}
+
+Model::Model() = default;
+
+std::unique_ptr<Model> Model::LoadAsync( const std::string& pathString, float scale, ThreadPool& pool )
+{
+	std::unique_ptr<Model> pModel{ new Model };
+	pModel->pStaging = std::make_unique<Staging>( pathString, scale, &pool );
+	pool.Run( pModel->pStaging->group, [pModel = pModel.get()]
+	{
+		PROFILE_SCOPE( "Model::LoadAsync" );
+		pModel->Prepare( *pModel->pStaging );
+	} );
+	return pModel;
+}
+
+bool Model::Poll( Graphics& gfx )
+{
+	// only once the task has finished, so the wait cannot block the frame
+	if ( pStaging && pStaging->group.IsDone() )
+	{
+		PROFILE_SCOPE( "Model::Poll" );
+		// returns at once, rethrowing whatever the task threw
+		pStaging->pPool->Wait( pStaging->group );
+		Finish( gfx, *pStaging );
+		pStaging.reset();
+		if ( pendingRootTransform )
+		{
+			pRoot->SetAppliedTransform( DirectX::XMLoadFloat4x4( &*pendingRootTransform ) );
+			pendingRootTransform.reset();
+		}
+		if ( pLinkedGraph )
+		{
+			LinkTechniques( *pLinkedGraph );
+		}
+	}
+	return IsReady();
+}
+
+bool Model::IsReady() const noexcept
+{
+	return !pStaging;
+}
+
+float Model::GetLoadProgress() const noexcept
+{
+	if ( !pStaging )
+	{
+		return 1.0f;
+	}
+	return float( pStaging->stepsDone ) / float( pStaging->stepsTotal );
+}
+
+const aiScene& Model::Import( Assimp::Importer& importer, const std::string& pathString )
+{
 	const auto pScene = importer.ReadFile(
 		pathString.c_str(),
 		aiProcess_Triangulate |
@@ -22,66 +138,270 @@ Model::Model(Graphics& gfx, const std::string& pathString, const float scale)
 
 	if (pScene == nullptr)
 		throw ModelException(__LINE__, __FILE__, importer.GetErrorString());
+	return *pScene;
+}
+
+DirectX::XMMATRIX Model::MakeNodeTransform( const aiNode& node, float scale ) noexcept
+{
+	return ScaleTranslation( DirectX::XMMatrixTranspose(
+		DirectX::XMLoadFloat4x4(
+			reinterpret_cast<const DirectX::XMFLOAT4X4*>(&node.mTransformation)
+		)
+	), scale );
+}
+
+void Model::Prepare( Staging& staging )
+{
+	Timer timer;
+	const auto& pathString = staging.pathString;
+	const auto pPool = staging.pPool;
+	size_t nMeshes = 0u;
+	if ( ModelBaker::IsBaked( pathString ) )
+	{
+		staging.pBaked = std::make_unique<ModelBaker::File>( pathString );
+		for ( const auto& pMaterial : staging.pBaked->GetMaterials() )
+			staging.materialDescs.push_back( pMaterial.get() );
+		staging.texturePath = staging.pBaked->GetSourcePath();
+		nMeshes = staging.pBaked->GetMeshes().size();
+	}
+	else
+	{
+		staging.pScene = &Import( staging.importer, pathString );
+		const auto& scene = *staging.pScene;
+		staging.materialDescs.assign( scene.mMaterials, scene.mMaterials + scene.mNumMaterials );
+		staging.texturePath = pathString;
+		nMeshes = scene.mNumMeshes;
+	}
+	loadStats.parse = timer.Mark();
+
+	// decode every image the materials use
+	std::vector<std::string> texturePaths;
+	{
+		std::unordered_set<std::string> seen;
+		for ( const auto pDesc : staging.materialDescs )
+			for ( auto& path : Material::GetTexturePaths( *pDesc, staging.texturePath ) )
+				if ( seen.insert( path ).second )
+					texturePaths.push_back( std::move( path ) );
+	}
+	staging.stepsTotal += texturePaths.size() + nMeshes;
+	staging.stepsDone++;
+	std::vector<std::optional<Surface>> decoded( texturePaths.size() );
+	ForEach( pPool, texturePaths.size(), [&]( size_t i )
+	{
+		decoded[i].emplace( Surface::FromFile( texturePaths[i] ) );
+		staging.stepsDone++;
+	} );
+	for ( size_t i = 0; i < texturePaths.size(); i++ )
+		staging.surfaces.emplace( std::move( texturePaths[i] ), std::move( *decoded[i] ) );
+	loadStats.decode = timer.Mark();
+	loadStats.textures = staging.surfaces.size();
 
+	// meshes are laid out as the materials built from the same descriptions will expect
+	std::vector<VertexMeta::VertexLayout> layouts;
+	for ( const auto pDesc : staging.materialDescs )
+		layouts.push_back( Material::MakeLayout( *pDesc ) );
+	if ( staging.pBaked )
+	{
+		// vertices are stored in their final layout, so there is nothing to extract
+		for ( const auto& m : staging.pBaked->GetMeshes() )
+		{
+			if ( m.material >= layouts.size() || layouts[m.material].GetCode() != m.layoutCode )
+				throw ModelException( __LINE__, __FILE__, "Baked vertex layout no longer matches its material - rebake " + staging.texturePath );
+			staging.stepsDone++;
+		}
+	}
+	else
+	{
+		const auto& scene = *staging.pScene;
+		staging.geometry.resize( scene.mNumMeshes );
+		ForEach( pPool, scene.mNumMeshes, [&]( size_t i )
+		{
+			const auto& mesh = *scene.mMeshes[i];
+			staging.geometry[i].emplace( Material::ExtractGeometry( layouts[mesh.mMaterialIndex], mesh, staging.scale, pathString + "%" + mesh.mName.C_Str() ) );
+			staging.stepsDone++;
+		} );
+	}
+	loadStats.extract = timer.Mark();
+	loadStats.meshes = nMeshes;
+}
+
+void Model::Finish( Graphics& gfx, Staging& staging )
+{
+	Timer timer;
+	// materials create their textures and shaders, and textures are filled on the immediate context
 	std::vector<Material> materials;
-	materials.reserve( pScene->mNumMaterials );
-	for ( size_t i = 0; i < pScene->mNumMaterials; i++ )
-		materials.emplace_back( gfx, *pScene->mMaterials[i], pathString );
+	materials.reserve( staging.materialDescs.size() );
+	for ( const auto pDesc : staging.materialDescs )
+		materials.emplace_back( gfx, *pDesc, staging.texturePath, &staging.surfaces );
+	staging.surfaces.clear();
+	loadStats.materials = timer.Mark();
+
+	if ( staging.pBaked )
+	{
+		FinishBaked( gfx, staging, materials );
+	}
+	else
+	{
+		// buffer creation stays on this thread, in mesh order
+		const auto& scene = *staging.pScene;
+		for ( size_t i = 0; i < scene.mNumMeshes; i++ )
+		{
+			const auto& mesh = *scene.mMeshes[i];
+			meshPtrs.push_back( std::make_unique<Mesh>( gfx, materials[mesh.mMaterialIndex], std::move( *staging.geometry[i] ) ) );
+		}
+
+		int nextID = 0;
+		pRoot = ParseNode( nextID, *scene.mRootNode, staging.scale, -1 );
+	}
+	staging.stepsDone++;
+	loadStats.upload = timer.Mark();
+}
 
-	for (size_t i = 0; i < pScene->mNumMeshes; i++)
+void Model::FinishBaked( Graphics& gfx, const Staging& staging, const std::vector<Material>& materials )
+{
+	const auto& file = *staging.pBaked;
+	const auto scale = staging.scale;
+	// buffers are created straight from the mapped file
+	for ( const auto& m : file.GetMeshes() )
 	{
-		const auto& mesh = *pScene->mMeshes[i];
-		meshPtrs.push_back( std::make_unique<Mesh>( gfx, materials[mesh.mMaterialIndex], mesh, scale ) );
+		const auto& material = materials[m.material];
+		const auto tag = staging.pathString + "%" + m.name;
+		auto pIndices = m.wideIndices ?
+			Bind::IndexBuffer::Resolve( gfx, tag, static_cast<const unsigned int*>( m.pIndices ), m.indexCount ) :
+			Bind::IndexBuffer::Resolve( gfx, tag, static_cast<const unsigned short*>( m.pIndices ), m.indexCount );
+		meshPtrs.push_back( std::make_unique<Mesh>( gfx, material,
+			Bind::VertexBuffer::Resolve( gfx, tag, material.GetLayout(), m.pVertices, m.vertexBytes ),
+			std::move( pIndices ) ) );
 	}
 
-	int nextID = 0;
-	pRoot = ParseNode( nextID, *pScene->mRootNode, scale );
+	// nodes are stored in depth first order, the order ParseNode() visits them in
+	std::vector<Node*> nodes;
+	for ( const auto& n : file.GetNodes() )
+	{
+		auto transform = DirectX::XMLoadFloat4x4( &n.transform );
+		// rescaling the root rescales everything under it, ahead of the root's own rotation and applied transform
+		if ( n.parent < 0 && scale != file.GetScale() )
+		{
+			const auto ratio = scale / file.GetScale();
+			transform = DirectX::XMMatrixScaling( ratio, ratio, ratio ) * ScaleTranslation( transform, ratio );
+		}
+		const auto index = transforms.Add( n.parent, transform );
+		std::vector<Mesh*> curMeshPtrs;
+		for ( const auto meshIdx : n.meshes )
+		{
+			curMeshPtrs.push_back( meshPtrs.at( meshIdx ).get() );
+			drawOrder.emplace_back( curMeshPtrs.back(), index );
+		}
+		auto pNode = std::make_unique<Node>( int( nodes.size() ), n.name, std::move( curMeshPtrs ), transforms, index );
+		nodes.push_back( pNode.get() );
+		if ( n.parent < 0 )
+			pRoot = std::move( pNode );
+		else
+			nodes[n.parent]->AddChild( std::move( pNode ) );
+	}
 }
 
 void Model::Submit( size_t channels ) const noexcept(!IS_DEBUG)
 {
-	pRoot->Submit(channels, DirectX::XMMatrixIdentity());
+	PROFILE_SCOPE( "Model::Submit" );
+	transforms.Update();
+	for ( const auto& [pm, index] : drawOrder )
+		pm->Submit( channels, &transforms.GetWorld( index ) );
+}
+
+void Model::Submit( size_t channels, Rgph::ParallelSubmitter& submitter ) const
+{
+	// world matrices are read by the runs, so they are updated before any run starts
+	transforms.Update();
+
+	// contiguous runs of the meshes are added in order, so the merged jobs match a sequential submit
+	const auto nRuns = std::min( drawOrder.size(), submitter.GetSplitCount() );
+	for ( size_t r = 0; r < nRuns; r++ )
+	{
+		const auto begin = drawOrder.size() * r / nRuns;
+		const auto end = drawOrder.size() * ( r + 1 ) / nRuns;
+		submitter.Add( [this, channels, begin, end]
+		{
+			PROFILE_SCOPE( "Model::Submit" );
+			for ( auto i = begin; i < end; i++ )
+				drawOrder[i].first->Submit( channels, &transforms.GetWorld( drawOrder[i].second ) );
+		} );
+	}
 }
 
 void Model::SetRootTransform(DirectX::FXMMATRIX tf) noexcept
 {
+	// a streamed model has no root until it is ready
+	if ( !pRoot )
+	{
+		pendingRootTransform.emplace();
+		DirectX::XMStoreFloat4x4( &*pendingRootTransform, tf );
+		return;
+	}
 	pRoot->SetAppliedTransform(tf);
 }
 
+const TransformHierarchy& Model::GetTransforms() const noexcept
+{
+	return transforms;
+}
+
+const Model::LoadStatistics& Model::GetLoadStatistics() const noexcept
+{
+	return loadStats;
+}
+
 void Model::Accept( ModelProbe& probe )
 {
-	pRoot->Accept( probe );
+	if ( pRoot )
+	{
+		pRoot->Accept( probe );
+	}
 }
 
-std::unique_ptr<Node> Model::ParseNode( int& nextID, const aiNode& node, float scale ) noexcept
+std::unique_ptr<Node> Model::ParseNode( int& nextID, const aiNode& node, float scale, int parent ) noexcept
 {
-	const auto transform = ScaleTranslation( DirectX::XMMatrixTranspose(
-		DirectX::XMLoadFloat4x4(
-			reinterpret_cast<const DirectX::XMFLOAT4X4*>(&node.mTransformation)
-		)
-	), scale );
+	const auto transform = MakeNodeTransform( node, scale );
 
 	std::vector<Mesh*> curMeshPtrs;
 	curMeshPtrs.reserve(node.mNumMeshes);
+	// nodes are added before their children, as the hierarchy requires
+	const auto index = transforms.Add(parent, transform);
 	for (size_t i = 0; i < node.mNumMeshes; i++)
 	{
 		const auto meshIdx = node.mMeshes[i];
 		curMeshPtrs.push_back(meshPtrs.at(meshIdx).get());
+		drawOrder.emplace_back(curMeshPtrs.back(), index);
 	}
 
-	auto pNode = std::make_unique<Node>(nextID++, node.mName.C_Str(), std::move(curMeshPtrs), transform);
+	auto pNode = std::make_unique<Node>(nextID++, node.mName.C_Str(), std::move(curMeshPtrs), transforms, index);
 	for (size_t i = 0; i < node.mNumChildren; i++)
-		pNode->AddChild( ParseNode( nextID, *node.mChildren[i], scale ) );
+		pNode->AddChild( ParseNode( nextID, *node.mChildren[i], scale, int( index ) ) );
 
 	return pNode;
 }
 
 void Model::LinkTechniques( Rgph::RenderGraph& rg )
 {
+	// a streamed model links its meshes to the last graph given once they exist
+	pLinkedGraph = &rg;
 	for ( auto& pMesh : meshPtrs )
 	{
 		pMesh->LinkTechniques( rg );
 	}
 }
 
-Model::~Model() noexcept { }
\ No newline at end of file
+Model::~Model() noexcept
+{
+	// a streamed load still running writes into this model
+	if ( pStaging )
+	{
+		try
+		{
+			pStaging->pPool->Wait( pStaging->group );
+		}
+		catch ( ... )
+		{
+		}
+	}
+}
\ No newline at end of file
@@ -1,32 +1,91 @@
 #pragma once
 #include "Graphics.h"
+#include "TransformHierarchy.h"
 #include <filesystem>
+#include <optional>
+#include <utility>
 #include <string>
 #include <memory>
 
 class Node;
 class Mesh;
+class Material;
+class ThreadPool;
 struct aiMesh;
 struct aiMaterial;
 struct aiNode;
+struct aiScene;
+
+namespace Assimp
+{
+	class Importer;
+}
 
 namespace Rgph
 {
 	class RenderGraph;
+	class ParallelSubmitter;
 }
 
 class Model
 {
 public:
-	Model(Graphics& gfx, const std::string& pathString, float scale = 1.0f);
+	// seconds spent in each stage of the load
+	struct LoadStatistics
+	{
+		float parse = 0.0f;
+		float decode = 0.0f;
+		float materials = 0.0f;
+		float extract = 0.0f;
+		float upload = 0.0f;
+		size_t textures = 0u;
+		size_t meshes = 0u;
+	};
+public:
+	// image decoding and vertex extraction run on the pool if one is given - everything touching the gpu stays on the calling thread
+	// files made by ModelBaker are loaded from the mapped file without assimp, rescaled from the scale they were baked at
+	Model(Graphics& gfx, const std::string& pathString, float scale = 1.0f, ThreadPool* pPool = nullptr);
+	// returns at once with an empty model - parsing, decoding and extraction run on the pool, and Poll() creates the gpu
+	// resources on the calling thread once they are done; until then the model submits nothing and links nothing
+	// the pool should be one the frame does not wait on, or a frame waiting on its own work may block behind a load
+	static std::unique_ptr<Model> LoadAsync( const std::string& pathString, float scale, ThreadPool& pool );
+	// finishes a streamed load whose cpu stages are over, rethrowing anything they threw - returns whether the model is ready
+	bool Poll( Graphics& gfx );
+	bool IsReady() const noexcept;
+	// share of the load's steps done, 1 once the model is ready
+	float GetLoadProgress() const noexcept;
+	// the scene every model is built from, imported the same way for loading and baking
+	static const aiScene& Import( Assimp::Importer& importer, const std::string& pathString );
+	static DirectX::XMMATRIX MakeNodeTransform( const aiNode& node, float scale ) noexcept;
 	void Submit( size_t channels ) const noexcept(!IS_DEBUG);
+	// splits the meshes into runs submitted on the submitter's thread pool
+	void Submit( size_t channels, Rgph::ParallelSubmitter& submitter ) const;
 	void SetRootTransform(DirectX::FXMMATRIX tf) noexcept;
+	const TransformHierarchy& GetTransforms() const noexcept;
+	const LoadStatistics& GetLoadStatistics() const noexcept;
 	void Accept( class ModelProbe& probe );
 	void LinkTechniques( Rgph::RenderGraph& );
 	~Model() noexcept;
 private:
-	std::unique_ptr<Node> ParseNode( int& nextID, const aiNode& node, float scale ) noexcept;
+	struct Staging;
+	Model();
+	// parsing, decoding and extraction - touches no gpu resources, so it runs on any thread
+	void Prepare( Staging& staging );
+	// creates the materials, buffers and nodes from what Prepare() left behind
+	void Finish( Graphics& gfx, Staging& staging );
+	void FinishBaked( Graphics& gfx, const Staging& staging, const std::vector<Material>& materials );
+	std::unique_ptr<Node> ParseNode( int& nextID, const aiNode& node, float scale, int parent ) noexcept;
 private:
+	// world matrices are brought up to date by each submit, before any mesh is submitted
+	mutable TransformHierarchy transforms;
 	std::unique_ptr<Node> pRoot;
 	std::vector<std::unique_ptr<Mesh>> meshPtrs;
+	// meshes of every node with the node's index in the hierarchy, in depth first order
+	// the order a recursive traversal would submit them in - a mesh shared by several nodes appears once per node
+	std::vector<std::pair<const Mesh*, size_t>> drawOrder;
+	LoadStatistics loadStats;
+	// only while a streamed load is under way
+	std::unique_ptr<Staging> pStaging;
+	std::optional<DirectX::XMFLOAT4X4> pendingRootTransform;
+	Rgph::RenderGraph* pLinkedGraph = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,390 @@
+#include "ModelBaker.h"
+#include "Model.h"
+#include "Material.h"
+#include "ModelException.h"
+#include "StringConverter.h"
+#include "IndexBuffer.h"
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+namespace
+{
+	constexpr uint32_t magic = 0x424D5748u; // "HWMB"
+	constexpr const char* extension = ".bake";
+	// vertex data starts on this boundary in the file, and so in the mapping
+	constexpr size_t vertexAlignment = 16u;
+
+	// textures and parameters the material constructor reads
+	constexpr aiTextureType textureTypes[] = { aiTextureType_DIFFUSE, aiTextureType_SPECULAR, aiTextureType_NORMALS };
+	enum MaterialFlags : uint32_t
+	{
+		HasDiffuseColor = 1u << 0,
+		HasSpecularColor = 1u << 1,
+		HasShininess = 1u << 2,
+	};
+
+	class Writer
+	{
+	public:
+		template<typename T>
+		void Write( const T& value )
+		{
+			static_assert( std::is_trivially_copyable_v<T>, "Only plain data is written as is!" );
+			Write( &value, sizeof( T ) );
+		}
+		void Write( const void* pSource, size_t size )
+		{
+			const auto p = static_cast<const unsigned char*>( pSource );
+			bytes.insert( bytes.end(), p, p + size );
+		}
+		// strings are length prefixed and padded so everything after them stays aligned
+		void WriteString( const std::string& s )
+		{
+			Write( uint32_t( s.size() ) );
+			Write( s.data(), s.size() );
+			Align( 4u );
+		}
+		void Align( size_t alignment )
+		{
+			bytes.resize( ( bytes.size() + alignment - 1u ) / alignment * alignment, 0u );
+		}
+		const std::vector<unsigned char>& GetBytes() const noexcept
+		{
+			return bytes;
+		}
+	private:
+		std::vector<unsigned char> bytes;
+	};
+
+	class Reader
+	{
+	public:
+		Reader( const unsigned char* pBegin, size_t size, const std::string& path ) noexcept
+			:
+			pBegin( pBegin ),
+			size( size ),
+			path( path )
+		{}
+		template<typename T>
+		T Read()
+		{
+			T value;
+			memcpy( &value, Take( sizeof( T ) ), sizeof( T ) );
+			return value;
+		}
+		std::string ReadString()
+		{
+			const auto length = Read<uint32_t>();
+			std::string s( static_cast<const char*>( Take( length ) ), length );
+			Align( 4u );
+			return s;
+		}
+		// element count of a list whose elements take at least bytesEach - checked against what is left
+		// so a corrupt count is reported as such rather than sizing a container from it
+		uint32_t ReadCount( size_t bytesEach )
+		{
+			const auto count = Read<uint32_t>();
+			if ( count > ( size - offset ) / bytesEach )
+			{
+				throw ModelException( __LINE__, __FILE__, "Baked model is truncated: " + path );
+			}
+			return count;
+		}
+		// pointer into the mapping - nothing is copied
+		const void* Take( size_t bytes )
+		{
+			if ( bytes > size - offset )
+			{
+				throw ModelException( __LINE__, __FILE__, "Baked model is truncated: " + path );
+			}
+			const auto p = pBegin + offset;
+			offset += bytes;
+			return p;
+		}
+		void Align( size_t alignment ) noexcept
+		{
+			offset = std::min( ( offset + alignment - 1u ) / alignment * alignment, size );
+		}
+	private:
+		const unsigned char* pBegin;
+		size_t size;
+		size_t offset = 0u;
+		const std::string& path;
+	};
+
+	void WriteNode( Writer& w, const aiNode& node, int parent, int& nextIndex, float scale )
+	{
+		const auto index = nextIndex++;
+		w.WriteString( node.mName.C_Str() );
+		w.Write( int32_t( parent ) );
+		DirectX::XMFLOAT4X4 transform;
+		DirectX::XMStoreFloat4x4( &transform, Model::MakeNodeTransform( node, scale ) );
+		w.Write( transform );
+		w.Write( uint32_t( node.mNumMeshes ) );
+		w.Write( node.mMeshes, node.mNumMeshes * sizeof( unsigned int ) );
+		for ( unsigned int i = 0; i < node.mNumChildren; i++ )
+		{
+			WriteNode( w, *node.mChildren[i], index, nextIndex, scale );
+		}
+	}
+
+	size_t CountNodes( const aiNode& node ) noexcept
+	{
+		size_t count = 1u;
+		for ( unsigned int i = 0; i < node.mNumChildren; i++ )
+		{
+			count += CountNodes( *node.mChildren[i] );
+		}
+		return count;
+	}
+}
+
+void ModelBaker::Bake( const std::string& sourcePath, const std::string& bakedPath, float scale )
+{
+	Assimp::Importer importer;
+	const auto& scene = Model::Import( importer, sourcePath );
+
+	Writer w;
+	w.Write( magic );
+	w.Write( version );
+	w.Write( scale );
+	w.WriteString( sourcePath );
+
+	w.Write( uint32_t( scene.mNumMaterials ) );
+	for ( unsigned int i = 0; i < scene.mNumMaterials; i++ )
+	{
+		const auto& material = *scene.mMaterials[i];
+		aiString name;
+		material.Get( AI_MATKEY_NAME, name );
+		w.WriteString( name.C_Str() );
+		for ( const auto type : textureTypes )
+		{
+			aiString texFileName;
+			w.WriteString( material.GetTexture( type, 0, &texFileName ) == aiReturn_SUCCESS ? texFileName.C_Str() : "" );
+		}
+		aiColor3D diffuse = { 0.0f, 0.0f, 0.0f };
+		aiColor3D specular = { 0.0f, 0.0f, 0.0f };
+		float shininess = 0.0f;
+		uint32_t flags = 0u;
+		flags |= material.Get( AI_MATKEY_COLOR_DIFFUSE, diffuse ) == aiReturn_SUCCESS ? HasDiffuseColor : 0u;
+		flags |= material.Get( AI_MATKEY_COLOR_SPECULAR, specular ) == aiReturn_SUCCESS ? HasSpecularColor : 0u;
+		flags |= material.Get( AI_MATKEY_SHININESS, shininess ) == aiReturn_SUCCESS ? HasShininess : 0u;
+		w.Write( flags );
+		w.Write( diffuse );
+		w.Write( specular );
+		w.Write( shininess );
+	}
+
+	w.Write( uint32_t( scene.mNumMeshes ) );
+	for ( unsigned int i = 0; i < scene.mNumMeshes; i++ )
+	{
+		const auto& mesh = *scene.mMeshes[i];
+		// the same extraction the material does on import
+		const auto layout = Material::MakeLayout( *scene.mMaterials[mesh.mMaterialIndex] );
+		const auto geometry = Material::ExtractGeometry( layout, mesh, scale, {} );
+		w.WriteString( mesh.mName.C_Str() );
+		w.Write( uint32_t( mesh.mMaterialIndex ) );
+		w.WriteString( layout.GetCode() );
+		w.Write( uint32_t( geometry.vertices.SizeBytes() ) );
+		w.Write( uint32_t( geometry.indices.size() ) );
+		// stored in the width the index buffer would pick, so loads upload them as they are
+		const auto& indices = geometry.indices;
+		const bool wide = !Bind::IndexBuffer::FitsShort( indices.data(), indices.size() );
+		w.Write( uint32_t( wide ? sizeof( unsigned int ) : sizeof( unsigned short ) ) );
+		w.Align( vertexAlignment );
+		w.Write( geometry.vertices.GetData(), geometry.vertices.SizeBytes() );
+		w.Align( 4u );
+		if ( wide )
+		{
+			w.Write( indices.data(), indices.size() * sizeof( unsigned int ) );
+		}
+		else
+		{
+			for ( const auto i : indices )
+				w.Write( (unsigned short)i );
+		}
+		w.Align( 4u );
+	}
+
+	w.Write( uint32_t( CountNodes( *scene.mRootNode ) ) );
+	int nextIndex = 0;
+	WriteNode( w, *scene.mRootNode, -1, nextIndex, scale );
+
+	const std::filesystem::path path{ bakedPath };
+	if ( path.has_parent_path() )
+	{
+		std::filesystem::create_directories( path.parent_path() );
+	}
+	std::ofstream file( path, std::ios::binary );
+	const auto& bytes = w.GetBytes();
+	file.write( reinterpret_cast<const char*>( bytes.data() ), std::streamsize( bytes.size() ) );
+	if ( !file )
+	{
+		throw ModelException( __LINE__, __FILE__, "Unable to write baked model: " + bakedPath );
+	}
+}
+
+bool ModelBaker::IsBaked( const std::string& path )
+{
+	return std::filesystem::path{ path }.extension() == extension;
+}
+
+std::string ModelBaker::MakeBakedPath( const std::string& sourcePath )
+{
+	return std::filesystem::path{ sourcePath }.replace_extension( extension ).string();
+}
+
+ModelBaker::File::File( const std::string& path )
+{
+	const auto hFile = CreateFileW( ToWide( path ).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+	if ( hFile == INVALID_HANDLE_VALUE )
+	{
+		throw ModelException( __LINE__, __FILE__, "Unable to open baked model: " + path );
+	}
+	pFile.reset( hFile );
+	LARGE_INTEGER fileSize;
+	if ( !GetFileSizeEx( hFile, &fileSize ) || fileSize.QuadPart == 0 )
+	{
+		throw ModelException( __LINE__, __FILE__, "Baked model is empty: " + path );
+	}
+	pMapping.reset( CreateFileMappingW( hFile, nullptr, PAGE_READONLY, 0u, 0u, nullptr ) );
+	if ( pMapping )
+	{
+		pView.reset( static_cast<const unsigned char*>( MapViewOfFile( pMapping.get(), FILE_MAP_READ, 0u, 0u, 0u ) ) );
+	}
+	if ( !pView )
+	{
+		throw ModelException( __LINE__, __FILE__, "Unable to map baked model: " + path );
+	}
+
+	Reader r{ pView.get(), size_t( fileSize.QuadPart ), path };
+	if ( r.Read<uint32_t>() != magic )
+	{
+		throw ModelException( __LINE__, __FILE__, "Not a baked model: " + path );
+	}
+	if ( r.Read<uint32_t>() != version )
+	{
+		throw ModelException( __LINE__, __FILE__, "Baked model is from another version of the baker - rebake " + path );
+	}
+	scale = r.Read<float>();
+	sourcePath = r.ReadString();
+
+	// name and texture strings are at least their length, then flags, two colors and shininess
+	materials.resize( r.ReadCount( ( 1u + std::size( textureTypes ) ) * sizeof( uint32_t ) + sizeof( uint32_t ) + 2u * sizeof( aiColor3D ) + sizeof( float ) ) );
+	for ( auto& pMaterial : materials )
+	{
+		pMaterial = std::make_unique<aiMaterial>();
+		const aiString name{ r.ReadString() };
+		pMaterial->AddProperty( &name, AI_MATKEY_NAME );
+		for ( const auto type : textureTypes )
+		{
+			const aiString texFileName{ r.ReadString() };
+			if ( texFileName.length > 0u )
+			{
+				pMaterial->AddProperty( &texFileName, AI_MATKEY_TEXTURE( type, 0 ) );
+			}
+		}
+		const auto flags = r.Read<uint32_t>();
+		auto diffuse = r.Read<aiColor3D>();
+		auto specular = r.Read<aiColor3D>();
+		auto shininess = r.Read<float>();
+		if ( flags & HasDiffuseColor )
+			pMaterial->AddProperty( &diffuse, 1, AI_MATKEY_COLOR_DIFFUSE );
+		if ( flags & HasSpecularColor )
+			pMaterial->AddProperty( &specular, 1, AI_MATKEY_COLOR_SPECULAR );
+		if ( flags & HasShininess )
+			pMaterial->AddProperty( &shininess, 1, AI_MATKEY_SHININESS );
+	}
+
+	// name and layout lengths, material, vertex bytes, index count and index width
+	meshes.resize( r.ReadCount( 6u * sizeof( uint32_t ) ) );
+	for ( auto& m : meshes )
+	{
+		m.name = r.ReadString();
+		m.material = r.Read<uint32_t>();
+		m.layoutCode = r.ReadString();
+		m.vertexBytes = r.Read<uint32_t>();
+		m.indexCount = r.Read<uint32_t>();
+		const auto indexSize = r.Read<uint32_t>();
+		if ( indexSize != sizeof( unsigned short ) && indexSize != sizeof( unsigned int ) )
+		{
+			throw ModelException( __LINE__, __FILE__, "Baked model has an unknown index width: " + path );
+		}
+		m.wideIndices = indexSize == sizeof( unsigned int );
+		r.Align( vertexAlignment );
+		m.pVertices = r.Take( m.vertexBytes );
+		r.Align( 4u );
+		m.pIndices = r.Take( m.indexCount * indexSize );
+		r.Align( 4u );
+	}
+
+	// name length, parent, transform and mesh count
+	nodes.resize( r.ReadCount( sizeof( uint32_t ) + sizeof( int32_t ) + sizeof( DirectX::XMFLOAT4X4 ) + sizeof( uint32_t ) ) );
+	if ( nodes.empty() )
+	{
+		throw ModelException( __LINE__, __FILE__, "Baked model has no nodes: " + path );
+	}
+	for ( size_t i = 0; i < nodes.size(); i++ )
+	{
+		auto& n = nodes[i];
+		n.name = r.ReadString();
+		n.parent = r.Read<int32_t>();
+		n.transform = r.Read<DirectX::XMFLOAT4X4>();
+		n.meshes.resize( r.ReadCount( sizeof( uint32_t ) ) );
+		for ( auto& mesh : n.meshes )
+		{
+			mesh = r.Read<uint32_t>();
+			if ( mesh >= meshes.size() )
+			{
+				throw ModelException( __LINE__, __FILE__, "Baked model references a missing mesh: " + path );
+			}
+		}
+		// the root comes first and every other node after its parent
+		if ( ( i == 0u ) != ( n.parent < 0 ) || n.parent >= int( i ) )
+		{
+			throw ModelException( __LINE__, __FILE__, "Baked model has a malformed hierarchy: " + path );
+		}
+	}
+}
+
+ModelBaker::File::~File() {}
+
+void ModelBaker::File::HandleCloser::operator()( HANDLE handle ) const noexcept
+{
+	CloseHandle( handle );
+}
+
+void ModelBaker::File::ViewUnmapper::operator()( const unsigned char* pView ) const noexcept
+{
+	UnmapViewOfFile( pView );
+}
+
+const std::string& ModelBaker::File::GetSourcePath() const noexcept
+{
+	return sourcePath;
+}
+
+float ModelBaker::File::GetScale() const noexcept
+{
+	return scale;
+}
+
+const std::vector<std::unique_ptr<aiMaterial>>& ModelBaker::File::GetMaterials() const noexcept
+{
+	return materials;
+}
+
+const std::vector<ModelBaker::Mesh>& ModelBaker::File::GetMeshes() const noexcept
+{
+	return meshes;
+}
+
+const std::vector<ModelBaker::Node>& ModelBaker::File::GetNodes() const noexcept
+{
+	return nodes;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+#include "WindowsInclude.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct aiMaterial;
+
+// offline conversion of a model into a binary file that loads without assimp
+// the file holds the material parameters, each mesh's vertices already in the layout of its material, the indices
+// and the node hierarchy in depth first order, with geometry aligned so buffers are created straight from the mapped file
+// textures are not baked - they are still decoded from the files next to the model the bake was made from
+class ModelBaker
+{
+public:
+	// bumped whenever the format or the way vertices are extracted changes - older files are rejected
+	static constexpr uint32_t version = 3u;
+	struct Mesh
+	{
+		std::string name;
+		uint32_t material;
+		// code of the vertex layout the mesh was baked in
+		std::string layoutCode;
+		const void* pVertices;
+		size_t vertexBytes;
+		// 16 bit indices unless the mesh needs 32
+		const void* pIndices;
+		size_t indexCount;
+		bool wideIndices;
+	};
+	struct Node
+	{
+		std::string name;
+		// index of the parent node, -1 for the root
+		int parent;
+		DirectX::XMFLOAT4X4 transform;
+		std::vector<uint32_t> meshes;
+	};
+	// a baked file mapped into memory - mesh data points into the mapping and lives as long as the file does
+	class File
+	{
+	public:
+		File( const std::string& path );
+		File( const File& ) = delete;
+		File& operator=( const File& ) = delete;
+		~File();
+		const std::string& GetSourcePath() const noexcept;
+		float GetScale() const noexcept;
+		// rebuilt as assimp would have described them, so materials are built the same way as for an import
+		const std::vector<std::unique_ptr<aiMaterial>>& GetMaterials() const noexcept;
+		const std::vector<Mesh>& GetMeshes() const noexcept;
+		const std::vector<Node>& GetNodes() const noexcept;
+	private:
+		struct HandleCloser
+		{
+			void operator()( HANDLE handle ) const noexcept;
+		};
+		struct ViewUnmapper
+		{
+			void operator()( const unsigned char* pView ) const noexcept;
+		};
+	private:
+		// released in reverse - view, mapping, then file
+		std::unique_ptr<void, HandleCloser> pFile;
+		std::unique_ptr<void, HandleCloser> pMapping;
+		std::unique_ptr<const unsigned char, ViewUnmapper> pView;
+		std::string sourcePath;
+		float scale = 1.0f;
+		std::vector<std::unique_ptr<aiMaterial>> materials;
+		std::vector<Mesh> meshes;
+		std::vector<Node> nodes;
+	};
+public:
+	// imports the model at the given scale and writes its baked file
+	static void Bake( const std::string& sourcePath, const std::string& bakedPath, float scale );
+	// baked files are told apart from models assimp imports by extension
+	static bool IsBaked( const std::string& path );
+	// next to the source model, with the baked extension
+	static std::string MakeBakedPath( const std::string& sourcePath );
+};
\ No newline at end of file
@@ -3,35 +3,18 @@
 #include "ModelProbe.h"
 #include "imgui/imgui.h"
 
-Node::Node(int id, const std::string& name, std::vector<Mesh*> meshPtrs, const DirectX::XMMATRIX& transform) noexcept(!IS_DEBUG)
-	: meshPtrs(std::move(meshPtrs)), name(name), id(id)
-{
-	DirectX::XMStoreFloat4x4(&baseTransform, transform);
-	DirectX::XMStoreFloat4x4(&appliedTransform, DirectX::XMMatrixIdentity());
-}
-
-void Node::Submit(size_t channels, DirectX::FXMMATRIX accumulatedTransform) const noexcept(!IS_DEBUG)
-{
-	const auto built =
-		DirectX::XMLoadFloat4x4(&baseTransform) *
-		DirectX::XMLoadFloat4x4(&appliedTransform) *
-		accumulatedTransform;
-
-	for (const auto pm : meshPtrs)
-		pm->Submit(channels, built);
-
-	for (const auto& pc : childPtrs)
-		pc->Submit(channels, built);
-}
+Node::Node(int id, const std::string& name, std::vector<Mesh*> meshPtrs, TransformHierarchy& transforms, size_t index) noexcept(!IS_DEBUG)
+	: meshPtrs(std::move(meshPtrs)), name(name), id(id), transforms(transforms), index(index)
+{ }
 
 void Node::SetAppliedTransform(DirectX::FXMMATRIX transform) noexcept
 {
-	DirectX::XMStoreFloat4x4(&appliedTransform, transform);
+	transforms.SetApplied(index, transform);
 }
 
 const DirectX::XMFLOAT4X4& Node::GetAppliedTransform() const noexcept
 {
-	return appliedTransform;
+	return transforms.GetApplied(index);
 }
 
 void Node::AddChild(std::unique_ptr<Node> pChild) noexcept(!IS_DEBUG)
@@ -1,5 +1,6 @@
 #pragma once
 #include "Graphics.h"
+#include "TransformHierarchy.h"
 
 class Model;
 class Mesh;
@@ -11,8 +12,8 @@ class Node
 {
 	friend Model;
 public:
-	Node(int id, const std::string& name, std::vector<Mesh*> meshPtrs, const DirectX::XMMATRIX& transform_in) noexcept(!IS_DEBUG);
-	void Submit(size_t channels, DirectX::FXMMATRIX accumulatedTransform) const noexcept(!IS_DEBUG);
+	// the node's transforms live in the model's hierarchy at the given index
+	Node(int id, const std::string& name, std::vector<Mesh*> meshPtrs, TransformHierarchy& transforms, size_t index) noexcept(!IS_DEBUG);
 	void SetAppliedTransform(DirectX::FXMMATRIX transform) noexcept;
 	const DirectX::XMFLOAT4X4& GetAppliedTransform() const noexcept;
 	int GetID() const noexcept;
@@ -33,6 +34,6 @@ private:
 	std::string name;
 	std::vector<Mesh*> meshPtrs;
 	std::vector<std::unique_ptr<Node>> childPtrs;
-	DirectX::XMFLOAT4X4 baseTransform;
-	DirectX::XMFLOAT4X4 appliedTransform;
+	TransformHierarchy& transforms;
+	size_t index;
 };
\ No newline at end of file
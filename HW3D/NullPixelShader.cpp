@@ -10,7 +10,7 @@ namespace Bind
 	void NullPixelShader::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER_NOHR( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->PSSetShader( nullptr, nullptr, 0u ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).PSSetShader( nullptr ) );
 	}
 
 	std::shared_ptr<NullPixelShader> NullPixelShader::Resolve( Graphics& gfx )
@@ -18,13 +18,13 @@ namespace Bind
 		return Codex::Resolve<NullPixelShader>( gfx );
 	}
 
-	std::string NullPixelShader::GenerateUID()
+	BindKey NullPixelShader::GenerateKey()
 	{
-		return typeid(NullPixelShader).name();
+		return BindKey::Make<NullPixelShader>();
 	}
 
-	std::string NullPixelShader::GetUID() const noexcept
+	BindKey NullPixelShader::GetKey() const noexcept(!IS_DEBUG)
 	{
-		return GenerateUID();
+		return GenerateKey();
 	}
 }
\ No newline at end of file
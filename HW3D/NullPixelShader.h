@@ -9,7 +9,7 @@ namespace Bind
 		NullPixelShader( Graphics& gfx );
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		static std::shared_ptr<NullPixelShader> Resolve( Graphics& gfx );
-		static std::string GenerateUID();
-		std::string GetUID() const noexcept override;
+		static BindKey GenerateKey();
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
 	};
 }
\ No newline at end of file
@@ -15,7 +15,7 @@ namespace Rgph
 	{
 	public:
 		OutlineDrawPass(Graphics& gfx, std::string name) :
-			RenderQueuePass(std::move(name))
+			RenderQueuePass(std::move(name), {}, SortPolicy::State)
 		{
 			RegisterSink(DirectBufferSink<Bind::RenderTarget>::Make("renderTarget", renderTarget));
 			RegisterSink(DirectBufferSink<Bind::DepthStencil>::Make("depthStencil", depthStencil));
@@ -15,7 +15,7 @@ namespace Rgph
 	{
 	public:
 		OutlineMaskPass(Graphics& gfx, std::string name) :
-			RenderQueuePass(std::move(name))
+			RenderQueuePass(std::move(name), {}, SortPolicy::State)
 		{
 			RegisterSink(DirectBufferSink<Bind::DepthStencil>::Make("depthStencil", depthStencil));
 			RegisterSource(DirectBufferSource<Bind::DepthStencil>::Make("depthStencil", depthStencil));
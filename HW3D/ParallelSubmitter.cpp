@@ -0,0 +1,73 @@
+#include "ParallelSubmitter.h"
+#include "RenderQueuePass.h"
+
+namespace Rgph
+{
+	ParallelSubmitter::ParallelSubmitter( ThreadPool& pool ) noexcept
+		:
+		pool( pool )
+	{}
+
+	void ParallelSubmitter::Add( std::function<void()> traversal )
+	{
+		if ( !Enabled() )
+		{
+			traversal();
+			return;
+		}
+
+		if ( nLists == lists.size() )
+		{
+			lists.emplace_back();
+		}
+		auto& list = lists[nLists++];
+		list.clear();
+		pool.Run( group, [&list, traversal = std::move( traversal )]
+		{
+			pActiveList = &list;
+			try
+			{
+				traversal();
+			}
+			catch ( ... )
+			{
+				pActiveList = nullptr;
+				throw;
+			}
+			pActiveList = nullptr;
+		} );
+	}
+
+	void ParallelSubmitter::Flush()
+	{
+		const auto n = nLists;
+		nLists = 0u;
+		pool.Wait( group );
+
+		for ( size_t i = 0; i < n; i++ )
+		{
+			for ( const auto& e : lists[i] )
+			{
+				e.pPass->Accept( e.job );
+			}
+		}
+	}
+
+	size_t ParallelSubmitter::GetSplitCount() const noexcept
+	{
+		// a few per thread lets stealing even out subtrees of different sizes
+		return ( pool.GetWorkerCount() + 1u ) * 4u;
+	}
+
+	bool ParallelSubmitter::Collect( RenderQueuePass& pass, const Job& job )
+	{
+		if ( pActiveList == nullptr )
+		{
+			return false;
+		}
+		pActiveList->push_back( { &pass, job } );
+		return true;
+	}
+
+	thread_local std::vector<ParallelSubmitter::Entry>* ParallelSubmitter::pActiveList = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include "Job.h"
+#include "ThreadPool.h"
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace Rgph
+{
+	class RenderQueuePass;
+
+	// runs scene traversals on the thread pool and hands their jobs to the render queues in a fixed order
+	// each traversal collects into its own list, and Flush() accepts the lists in the order the traversals
+	// were added - so queues receive exactly what a sequential submit in that order would have produced
+	class ParallelSubmitter
+	{
+	public:
+		ParallelSubmitter( ThreadPool& pool ) noexcept;
+		// traversals run concurrently, so no two may submit the same drawable
+		// submit every channel of a drawable in one traversal instead of one traversal per channel
+		void Add( std::function<void()> traversal );
+		// waits for all traversals, then accepts their jobs - must be called before the graph executes
+		void Flush();
+		// traversals worth splitting a single large hierarchy into
+		size_t GetSplitCount() const noexcept;
+		// collects the job if the calling thread is running a traversal - false means accept it directly
+		static bool Collect( RenderQueuePass& pass, const Job& job );
+		// when disabled, Add() runs traversals inline on the calling thread
+		static bool& Enabled() noexcept
+		{
+			static bool enabled = true;
+			return enabled;
+		}
+	private:
+		struct Entry
+		{
+			RenderQueuePass* pPass;
+			Job job;
+		};
+	private:
+		ThreadPool& pool;
+		ThreadPool::TaskGroup group;
+		// a deque so that adding lists never moves the ones running traversals are writing to
+		// lists are kept between frames so their capacity is reused
+		std::deque<std::vector<Entry>> lists;
+		size_t nLists = 0u;
+		// list of the traversal running on this thread
+		static thread_local std::vector<Entry>* pActiveList;
+	};
+}
\ No newline at end of file
@@ -35,11 +35,35 @@ namespace Rgph
 		}
 	}
 
+	const std::vector<Pass::TransientRequest>& Pass::GetTransientRequests() const noexcept
+	{
+		return transientRequests;
+	}
+
+	void Pass::RequestTransient( std::shared_ptr<Bind::RenderTarget>& target, unsigned int width, unsigned int height, unsigned int slot, std::string sourceName )
+	{
+		TransientRequest request{ { TransientDesc::Type::RenderTarget, width, height, slot }, std::move( sourceName ) };
+		request.pRenderTarget = &target;
+		transientRequests.push_back( std::move( request ) );
+	}
+
+	void Pass::RequestTransient( std::shared_ptr<Bind::DepthStencil>& target, unsigned int width, unsigned int height, std::string sourceName )
+	{
+		TransientRequest request{ { TransientDesc::Type::DepthStencil, width, height }, std::move( sourceName ) };
+		request.pDepthStencil = &target;
+		transientRequests.push_back( std::move( request ) );
+	}
+
 	const std::vector<std::unique_ptr<Sink>>& Pass::GetSinks() const
 	{
 		return sinks;
 	}
 
+	const std::vector<std::unique_ptr<Source>>& Pass::GetSources() const
+	{
+		return sources;
+	}
+
 	Source& Pass::GetSource(const std::string& name) const
 	{
 		for (auto& src : sources)
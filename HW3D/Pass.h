@@ -3,6 +3,7 @@
 #include <string>
 #include <array>
 #include <memory>
+#include "TransientPlanner.h"
 
 class Graphics;
 
@@ -19,23 +20,40 @@ namespace Rgph
 
 	class Pass
 	{
+	public:
+		// target the render graph allocates on finalize - possibly sharing memory with other transients
+		struct TransientRequest
+		{
+			TransientDesc desc;
+			// source the target is exposed through - empty when only this pass uses it
+			std::string sourceName;
+			std::shared_ptr<Bind::RenderTarget>* pRenderTarget = nullptr;
+			std::shared_ptr<Bind::DepthStencil>* pDepthStencil = nullptr;
+		};
 	public:
 		Pass(std::string name) noexcept;
 		virtual void Execute(Graphics& gfx) const noexcept(!IS_DEBUG) = 0;
 		virtual void Reset() noexcept(!IS_DEBUG);
 		const std::string& GetName() const noexcept;
 		const std::vector<std::unique_ptr<Sink>>& GetSinks() const;
+		const std::vector<std::unique_ptr<Source>>& GetSources() const;
 		Source& GetSource(const std::string& registeredName) const;
 		Sink& GetSink(const std::string& registeredName) const;
 		void SetSinkLinkage(const std::string& registeredName, const std::string& target);
 		virtual void Finalize();
+		const std::vector<TransientRequest>& GetTransientRequests() const noexcept;
 		virtual ~Pass();
 	protected:
 		void RegisterSink(std::unique_ptr<Sink> sink);
 		void RegisterSource(std::unique_ptr<Source> source);
+		// contents of a transient are undefined when the pass starts, so it must be cleared or fully overwritten
+		// passes linking to the source may expose it again through a source of their own, which keeps it alive for their readers
+		void RequestTransient( std::shared_ptr<Bind::RenderTarget>& target, unsigned int width, unsigned int height, unsigned int slot, std::string sourceName );
+		void RequestTransient( std::shared_ptr<Bind::DepthStencil>& target, unsigned int width, unsigned int height, std::string sourceName = {} );
 	private:
 		std::vector<std::unique_ptr<Sink>> sinks;
 		std::vector<std::unique_ptr<Source>> sources;
+		std::vector<TransientRequest> transientRequests;
 		std::string name;
 	};
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "BindableCodex.h"
 #include "StringConverter.h"
 #include "GraphicsThrowMacros.h"
+#include "FrameCapture.h"
 #include <d3dcompiler.h>
 
 namespace Bind
@@ -17,12 +18,13 @@ namespace Bind
 			nullptr,
 			&pPixelShader
 		) );
+		FrameCapture::AttachCreationData( pPixelShader.Get(), pBytecodeBlob.Get() );
 	}
 
 	void PixelShader::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->PSSetShader( pPixelShader.Get(), nullptr, 0u ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).PSSetShader( pPixelShader.Get() ) );
 	}
 
 	ID3DBlob* PixelShader::GetByteCode() const noexcept
@@ -35,14 +37,13 @@ namespace Bind
 		return Codex::Resolve<PixelShader>( gfx, "res\\shaders\\cso\\" + path );
 	}
 
-	std::string PixelShader::GenerateUID( const std::string& path )
+	BindKey PixelShader::GenerateKey( const std::string& path )
 	{
-		using namespace std::string_literals;
-		return typeid(PixelShader).name() + "#"s + path;
+		return BindKey::Make<PixelShader>( path );
 	}
 
-	std::string PixelShader::GetUID() const noexcept
+	BindKey PixelShader::GetKey() const noexcept(!IS_DEBUG)
 	{
-		return GenerateUID( path );
+		return GenerateKey( path );
 	}
 }
\ No newline at end of file
@@ -10,8 +10,8 @@ namespace Bind
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		ID3DBlob* GetByteCode() const noexcept;
 		static std::shared_ptr<PixelShader> Resolve( Graphics& gfx, const std::string& path );
-		static std::string GenerateUID( const std::string& path );
-		std::string GetUID() const noexcept override;
+		static BindKey GenerateKey( const std::string& path );
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
 	protected:
 		std::string path;
 		Microsoft::WRL::ComPtr<ID3DBlob> pBytecodeBlob;
@@ -0,0 +1,235 @@
+#include "Profiler.h"
+#include "Timer.h"
+#include "imgui/imgui.h"
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+	struct Event
+	{
+		const char* name;
+		uint64_t begin;
+		uint64_t end;
+		// scopes open on the thread when this one began
+		uint32_t depth;
+	};
+
+	// scopes of one thread - written by that thread, read by EndFrame() and exports
+	struct ThreadBuffer
+	{
+		static constexpr size_t capacity = 8192u;
+		// only ever contended while the buffer is being read
+		std::mutex mutex;
+		std::array<Event, capacity> events;
+		uint64_t written = 0u;
+		uint64_t folded = 0u;
+		uint32_t depth = 0u;
+		uint32_t thread = 0u;
+	};
+
+	// rolling averages of one scope, by its path of enclosing scope names
+	struct ScopeStats
+	{
+		static constexpr size_t window = 120u;
+		const char* name;
+		uint32_t depth;
+		uint64_t frameNanoseconds = 0u;
+		uint32_t frameCalls = 0u;
+		std::array<float, window> milliseconds{};
+		std::array<uint32_t, window> calls{};
+	};
+
+	struct State
+	{
+		std::mutex mutex;
+		// threads never unregister - pool workers live as long as the app
+		std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+		std::map<std::string, ScopeStats> scopes;
+		size_t frame = 0u;
+	};
+
+	State& GetState()
+	{
+		static State state;
+		return state;
+	}
+
+	ThreadBuffer& GetBuffer()
+	{
+		thread_local ThreadBuffer* pBuffer = []
+		{
+			auto& state = GetState();
+			std::lock_guard lock( state.mutex );
+			state.buffers.push_back( std::make_unique<ThreadBuffer>() );
+			state.buffers.back()->thread = uint32_t( state.buffers.size() - 1u );
+			return state.buffers.back().get();
+		}();
+		return *pBuffer;
+	}
+
+	// events of the buffer from the given count on that have not been overwritten yet, oldest first
+	std::vector<Event> Read( ThreadBuffer& buffer, uint64_t from )
+	{
+		std::vector<Event> events;
+		const auto first = std::max( from, buffer.written > ThreadBuffer::capacity ? buffer.written - ThreadBuffer::capacity : 0u );
+		events.reserve( size_t( buffer.written - first ) );
+		for ( auto i = first; i < buffer.written; i++ )
+		{
+			events.push_back( buffer.events[i % ThreadBuffer::capacity] );
+		}
+		// scopes are written as they close, so parents follow their children
+		std::sort( events.begin(), events.end(), []( const Event& a, const Event& b )
+		{
+			return a.begin != b.begin ? a.begin < b.begin : a.depth < b.depth;
+		} );
+		return events;
+	}
+}
+
+Profiler::Scope::Scope( const char* name ) noexcept
+	:
+	name( name ),
+	begin( Timer::Now() )
+{
+	GetBuffer().depth++;
+}
+
+Profiler::Scope::~Scope()
+{
+	const auto end = Timer::Now();
+	auto& buffer = GetBuffer();
+	buffer.depth--;
+	std::lock_guard lock( buffer.mutex );
+	buffer.events[buffer.written % ThreadBuffer::capacity] = { name, begin, end, buffer.depth };
+	buffer.written++;
+}
+
+void Profiler::EndFrame()
+{
+	auto& state = GetState();
+	std::lock_guard lock( state.mutex );
+	for ( auto& pBuffer : state.buffers )
+	{
+		std::vector<Event> events;
+		{
+			std::lock_guard bufferLock( pBuffer->mutex );
+			events = Read( *pBuffer, pBuffer->folded );
+			pBuffer->folded = pBuffer->written;
+		}
+		// path of each open scope - separators sort below any name so children list right after their parent
+		std::vector<std::pair<const Event*, std::string>> open;
+		for ( const auto& e : events )
+		{
+			while ( !open.empty() && ( open.back().first->depth >= e.depth || open.back().first->end <= e.begin ) )
+			{
+				open.pop_back();
+			}
+			auto path = open.empty() ? std::string{} : open.back().second + '\x01';
+			path += e.name;
+			auto& stats = state.scopes.try_emplace( path, ScopeStats{ e.name, uint32_t( open.size() ) } ).first->second;
+			stats.frameNanoseconds += e.end - e.begin;
+			stats.frameCalls++;
+			open.emplace_back( &e, std::move( path ) );
+		}
+	}
+
+	const auto slot = state.frame++ % ScopeStats::window;
+	for ( auto& [path, stats] : state.scopes )
+	{
+		stats.milliseconds[slot] = float( stats.frameNanoseconds ) / 1000000.0f;
+		stats.calls[slot] = stats.frameCalls;
+		stats.frameNanoseconds = 0u;
+		stats.frameCalls = 0u;
+	}
+}
+
+void Profiler::ShowWindow()
+{
+	if ( ImGui::Begin( "Profiler" ) )
+	{
+#if PROFILING_ENABLED
+		// exporting takes the lock itself
+		if ( ImGui::Button( "Export Trace" ) )
+		{
+			ExportTrace( "res\\traces\\trace.json" );
+		}
+		auto& state = GetState();
+		std::lock_guard lock( state.mutex );
+		const auto frames = std::max( std::min( state.frame, ScopeStats::window ), size_t( 1u ) );
+		ImGui::Text( "Rolling over the last %zu frames, %zu threads", frames, state.buffers.size() );
+		ImGui::Columns( 4, nullptr, true );
+		ImGui::Text( "Scope" ); ImGui::NextColumn();
+		ImGui::Text( "Avg (ms)" ); ImGui::NextColumn();
+		ImGui::Text( "Max (ms)" ); ImGui::NextColumn();
+		ImGui::Text( "Calls" ); ImGui::NextColumn();
+		ImGui::Separator();
+		for ( const auto& [path, stats] : state.scopes )
+		{
+			float total = 0.0f;
+			float peak = 0.0f;
+			uint32_t calls = 0u;
+			for ( size_t i = 0; i < frames; i++ )
+			{
+				total += stats.milliseconds[i];
+				peak = std::max( peak, stats.milliseconds[i] );
+				calls += stats.calls[i];
+			}
+			ImGui::Text( "%*s%s", int( stats.depth * 2u ), "", stats.name ); ImGui::NextColumn();
+			ImGui::Text( "%.3f", total / float( frames ) ); ImGui::NextColumn();
+			ImGui::Text( "%.3f", peak ); ImGui::NextColumn();
+			ImGui::Text( "%.1f", float( calls ) / float( frames ) ); ImGui::NextColumn();
+		}
+		ImGui::Columns( 1 );
+#else
+		ImGui::Text( "Profiling is compiled out - build with PROFILING_ENABLED" );
+#endif
+	}
+	ImGui::End();
+}
+
+void Profiler::ExportTrace( const std::string& path )
+{
+	std::vector<std::pair<uint32_t, std::vector<Event>>> threads;
+	{
+		auto& state = GetState();
+		std::lock_guard lock( state.mutex );
+		for ( auto& pBuffer : state.buffers )
+		{
+			std::lock_guard bufferLock( pBuffer->mutex );
+			threads.emplace_back( pBuffer->thread, Read( *pBuffer, 0u ) );
+		}
+	}
+
+	const std::filesystem::path filePath{ path };
+	if ( filePath.has_parent_path() )
+	{
+		std::filesystem::create_directories( filePath.parent_path() );
+	}
+	std::ofstream file( filePath );
+	// complete events in microseconds - names are engine identifiers and need no escaping
+	file << std::fixed << std::setprecision( 3 ) << "{\"traceEvents\":[";
+	bool first = true;
+	for ( const auto& [thread, events] : threads )
+	{
+		file << ( first ? "" : "," ) << std::endl
+			<< "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread
+			<< ",\"args\":{\"name\":\"" << "Thread " << thread << "\"}}";
+		first = false;
+		for ( const auto& e : events )
+		{
+			file << ( first ? "" : "," ) << std::endl
+				<< "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread
+				<< ",\"ts\":" << double( e.begin ) / 1000.0 << ",\"dur\":" << double( e.end - e.begin ) / 1000.0 << "}";
+			first = false;
+		}
+	}
+	file << std::endl << "]}" << std::endl;
+}
\ No newline at end of file
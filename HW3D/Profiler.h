@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// set to 0 to compile every profile scope out
+#ifndef PROFILING_ENABLED
+#define PROFILING_ENABLED 1
+#endif
+
+// hierarchical cpu scope profiler
+// each thread writes the scopes it closes into a ring buffer of its own, so threads never wait on each other
+// EndFrame() folds the scopes closed since the previous frame into rolling per-scope averages for the panel
+// the buffers keep the most recent scopes of every thread, which can be exported as a chrome trace
+class Profiler
+{
+public:
+	// times the enclosing block and nests under the scope that was open on this thread when it began
+	// the name is kept as a pointer - use string literals or names of objects that outlive the profiler
+	class Scope
+	{
+	public:
+		Scope( const char* name ) noexcept;
+		Scope( const Scope& ) = delete;
+		Scope& operator=( const Scope& ) = delete;
+		~Scope();
+	private:
+		const char* name;
+		uint64_t begin;
+	};
+public:
+	// once per frame on the main thread
+	static void EndFrame();
+	static void ShowWindow();
+	// scopes still held in the buffers as trace event json - open with chrome://tracing or perfetto
+	static void ExportTrace( const std::string& path );
+};
+
+#if PROFILING_ENABLED
+#define PROFILE_CONCAT_( a, b ) a##b
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_( a, b )
+#define PROFILE_SCOPE( name ) Profiler::Scope PROFILE_CONCAT( profileScope, __LINE__ ){ ( name ) }
+#else
+#define PROFILE_SCOPE( name )
+#endif
\ No newline at end of file
@@ -16,7 +16,7 @@ namespace Bind
 
 	void Rasterizer::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->RSSetState( pRasterizer.Get() ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).RSSetState( pRasterizer.Get() ) );
 	}
 
 	std::shared_ptr<Rasterizer> Rasterizer::Resolve( Graphics& gfx, bool twoSided )
@@ -24,14 +24,13 @@ namespace Bind
 		return Codex::Resolve<Rasterizer>( gfx, twoSided );
 	}
 
-	std::string Rasterizer::GenerateUID(bool twoSided)
+	BindKey Rasterizer::GenerateKey( bool twoSided )
 	{
-		using namespace std::string_literals;
-		return typeid( Rasterizer ).name() + "#"s + ( twoSided ? "2s" : "1s" );
+		return BindKey::Make<Rasterizer>( twoSided );
 	}
 
-	std::string Rasterizer::GetUID() const noexcept
+	BindKey Rasterizer::GetKey() const noexcept(!IS_DEBUG)
 	{
-		return GenerateUID( twoSided );
+		return GenerateKey( twoSided );
 	}
 }
\ No newline at end of file
@@ -10,8 +10,8 @@ namespace Bind
 		Rasterizer( Graphics& gfx, bool twoSided );
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		static std::shared_ptr<Rasterizer> Resolve( Graphics& gfx, bool twoSided );
-		static std::string GenerateUID( bool twoSided );
-		std::string GetUID() const noexcept override;
+		static BindKey GenerateKey( bool twoSided );
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
 	private:
 		Microsoft::WRL::ComPtr<ID3D11RasterizerState> pRasterizer;
 		bool twoSided;
@@ -7,7 +7,11 @@
 #include "RenderQueuePass.h"
 #include "Sink.h"
 #include "Source.h"
+#include "Profiler.h"
 #include <sstream>
+#include <algorithm>
+#include <functional>
+#include <queue>
 
 namespace Rgph
 {
@@ -55,13 +59,47 @@ namespace Rgph
 
 	void RenderGraph::Execute(Graphics& gfx) noexcept(!IS_DEBUG)
 	{
+		PROFILE_SCOPE("RenderGraph::Execute");
 		assert(finalized);
-		for (auto& p : passes)
+		for (auto p : executionOrder)
 		{
+			PROFILE_SCOPE(p->GetName().c_str());
 			p->Execute(gfx);
 		}
 	}
 
+	void RenderGraph::Execute(Graphics& gfx, ThreadPool& pool)
+	{
+		assert(finalized);
+		if (!RecordingEnabled())
+		{
+			Execute(gfx);
+			return;
+		}
+		PROFILE_SCOPE("RenderGraph::Execute");
+
+		while (commandLists.size() < executionOrder.size())
+		{
+			commandLists.push_back(gfx.CreateCommandList());
+		}
+		for (size_t i = 0; i < executionOrder.size(); i++)
+		{
+			pool.Run(recording, [&gfx, &pass = *executionOrder[i], &list = *commandLists[i]]
+			{
+				PROFILE_SCOPE(pass.GetName().c_str());
+				list.Record(gfx, [&gfx, &pass] { pass.Execute(gfx); });
+			});
+		}
+		pool.Wait(recording);
+
+		// lists are replayed in execution order, so every pass still sees the results of the passes it depends on
+		PROFILE_SCOPE("Replay");
+		for (size_t i = 0; i < executionOrder.size(); i++)
+		{
+			commandLists[i]->Execute(gfx);
+		}
+	}
+
 	void RenderGraph::Reset() noexcept
 	{
 		assert(finalized);
@@ -69,6 +107,8 @@ namespace Rgph
 		{
 			p->Reset();
 		}
+		// every queue has dropped its jobs, so nothing points into the arena any more
+		arena.Reset();
 	}
 
 	void RenderGraph::AppendPass(std::unique_ptr<Pass> pass)
@@ -83,9 +123,7 @@ namespace Rgph
 			}
 		}
 
-		// link outputs from passes (and global outputs) to pass inputs
-		LinkSinks(*pass);
-
+		// sinks are linked in Finalize once the pass order is known
 		// add to container of passes
 		passes.push_back(std::move(pass));
 	}
@@ -137,23 +175,9 @@ namespace Rgph
 			}
 			else // find source from within existing passes
 			{
-				bool bound = false;
-				for (auto& existingPass : passes)
-				{
-					if (existingPass->GetName() == inputSourcePassName)
-					{
-						auto& source = existingPass->GetSource(si->GetOutputName());
-						si->Bind(source);
-						bound = true;
-						break;
-					}
-					/*if ( !bound )
-					{
-						std::ostringstream oss;
-						oss << "Pass [" << inputSourcePassName << "] not found!";
-						throw RGC_EXCEPTION( oss.str() );
-					}*/
-				}
+				// existence of the pass was checked when sorting
+				auto& source = passes[FindPassIndex(inputSourcePassName)]->GetSource(si->GetOutputName());
+				si->Bind(source);
 			}
 		}
 	}
@@ -175,17 +199,299 @@ namespace Rgph
 		}
 	}
 
-	void RenderGraph::Finalize()
+	void RenderGraph::Finalize( Graphics& gfx )
 	{
 		assert(!finalized);
-		for (const auto& p : passes)
+		const auto order = SortPasses();
+		const auto live = FindLivePasses();
+		// transients have to exist before linking hands them to the sinks of later passes
+		const auto transientReport = AllocateTransients(gfx, order, live);
+
+		// sources hand over whatever their pass received through its sinks, so passes must be linked in dependency order
+		std::ostringstream report;
+		report << "Execution order:" << std::endl;
+		for (const auto i : order)
+		{
+			if (live[i])
+			{
+				LinkSinks(*passes[i]);
+				executionOrder.push_back(passes[i].get());
+				report << "  " << passes[i]->GetName() << std::endl;
+			}
+		}
+		report << "Culled passes:" << std::endl;
+		for (size_t i = 0; i < passes.size(); i++)
+		{
+			if (!live[i])
+			{
+				culledPasses.push_back(passes[i].get());
+				report << "  " << passes[i]->GetName() << std::endl;
+			}
+		}
+		if (culledPasses.empty())
+		{
+			report << "  (none)" << std::endl;
+		}
+		report << transientReport;
+		finalizeReport = report.str();
+
+		// culled passes are never linked, so they would fail validation
+		for (const auto p : executionOrder)
 		{
 			p->Finalize();
 		}
+		// culled queues still accept jobs, so they need storage as well
+		for (const auto& p : passes)
+		{
+			if (auto pQueue = dynamic_cast<RenderQueuePass*>(p.get()))
+			{
+				pQueue->SetArena(arena);
+			}
+		}
 		LinkGlobalSinks();
 		finalized = true;
 	}
 
+	std::vector<size_t> RenderGraph::SortPasses() const
+	{
+		// edge from each pass to every pass that has a sink linked to one of its sources
+		std::vector<std::vector<size_t>> dependents(passes.size());
+		std::vector<size_t> dependencyCount(passes.size(), 0u);
+		for (size_t i = 0; i < passes.size(); i++)
+		{
+			for (const auto& si : passes[i]->GetSinks())
+			{
+				const auto& sourcePassName = si->GetPassName();
+				if (sourcePassName.empty())
+				{
+					std::ostringstream oss;
+					oss << "In pass name [" << passes[i]->GetName() << "] sink named [" << si->GetRegisteredName() << "] has no target source set!";
+					throw RGC_EXCEPTION(oss.str());
+				}
+				if (sourcePassName == "$")
+				{
+					continue;
+				}
+				const auto source = FindPassIndex(sourcePassName);
+				if (source == passes.size())
+				{
+					std::ostringstream oss;
+					oss << "Pass [" << sourcePassName << "] linked by [" << passes[i]->GetName() << "." << si->GetRegisteredName() << "] not found!";
+					throw RGC_EXCEPTION(oss.str());
+				}
+				dependents[source].push_back(i);
+				dependencyCount[i]++;
+			}
+		}
+
+		// always take the earliest appended ready pass so independent passes keep their append order
+		std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+		for (size_t i = 0; i < passes.size(); i++)
+		{
+			if (dependencyCount[i] == 0u)
+			{
+				ready.push(i);
+			}
+		}
+		std::vector<size_t> order;
+		order.reserve(passes.size());
+		while (!ready.empty())
+		{
+			const auto i = ready.top();
+			ready.pop();
+			order.push_back(i);
+			for (const auto d : dependents[i])
+			{
+				if (--dependencyCount[d] == 0u)
+				{
+					ready.push(d);
+				}
+			}
+		}
+
+		if (order.size() != passes.size())
+		{
+			std::ostringstream oss;
+			oss << "Render graph has a cycle between passes:";
+			for (size_t i = 0; i < passes.size(); i++)
+			{
+				if (dependencyCount[i] != 0u)
+				{
+					oss << " [" << passes[i]->GetName() << "]";
+				}
+			}
+			throw RGC_EXCEPTION(oss.str());
+		}
+		return order;
+	}
+
+	std::vector<bool> RenderGraph::FindLivePasses() const
+	{
+		// walk back from the passes feeding global sinks along sink linkages
+		std::vector<bool> live(passes.size(), false);
+		std::vector<size_t> stack;
+		for (const auto& sink : globalSinks)
+		{
+			const auto i = FindPassIndex(sink->GetPassName());
+			if (i == passes.size())
+			{
+				throw RGC_EXCEPTION("Global sink [" + sink->GetRegisteredName() + "] targets unknown pass: " + sink->GetPassName());
+			}
+			stack.push_back(i);
+		}
+		while (!stack.empty())
+		{
+			const auto i = stack.back();
+			stack.pop_back();
+			if (live[i])
+			{
+				continue;
+			}
+			live[i] = true;
+			for (const auto& si : passes[i]->GetSinks())
+			{
+				if (si->GetPassName() != "$")
+				{
+					stack.push_back(FindPassIndex(si->GetPassName()));
+				}
+			}
+		}
+		return live;
+	}
+
+	size_t RenderGraph::FindLastUse( size_t pass, const std::string& sourceName, const std::vector<size_t>& position, const std::vector<bool>& live ) const
+	{
+		for (const auto& sink : globalSinks)
+		{
+			if (sink->GetPassName() == passes[pass]->GetName() && sink->GetOutputName() == sourceName)
+			{
+				// read after every pass has run
+				return size_t(std::count(live.begin(), live.end(), true)) - 1u;
+			}
+		}
+		auto lastUse = position[pass];
+		for (size_t j = 0; j < passes.size(); j++)
+		{
+			if (!live[j])
+			{
+				continue;
+			}
+			for (const auto& si : passes[j]->GetSinks())
+			{
+				if (si->GetPassName() != passes[pass]->GetName() || si->GetOutputName() != sourceName)
+				{
+					continue;
+				}
+				lastUse = std::max(lastUse, position[j]);
+				// the graph is acyclic, so following what the reader hands on ends
+				const auto pMember = si->GetMemberAddress();
+				for (const auto& so : passes[j]->GetSources())
+				{
+					if (pMember != nullptr && so->GetMemberAddress() == pMember)
+					{
+						lastUse = std::max(lastUse, FindLastUse(j, so->GetName(), position, live));
+					}
+				}
+			}
+		}
+		return lastUse;
+	}
+
+	std::string RenderGraph::AllocateTransients( Graphics& gfx, const std::vector<size_t>& order, const std::vector<bool>& live )
+	{
+		// position of each live pass in the execution order
+		std::vector<size_t> position(passes.size(), 0u);
+		size_t nextPosition = 0u;
+		for (const auto i : order)
+		{
+			if (live[i])
+			{
+				position[i] = nextPosition++;
+			}
+		}
+
+		// a transient lives from its own pass up to the last live pass that reads it, directly or handed on
+		std::vector<TransientPlanner::Request> requests;
+		std::vector<const Pass::TransientRequest*> owners;
+		for (size_t i = 0; i < passes.size(); i++)
+		{
+			if (!live[i])
+			{
+				continue;
+			}
+			for (const auto& tr : passes[i]->GetTransientRequests())
+			{
+				const auto lastUse = tr.sourceName.empty() ? position[i] : FindLastUse(i, tr.sourceName, position, live);
+				requests.push_back({ tr.desc, position[i], lastUse });
+				owners.push_back(&tr);
+			}
+		}
+
+		const auto plan = TransientPlanner::Build(requests);
+		std::vector<std::shared_ptr<Bind::RenderTarget>> renderTargets(plan.resources.size());
+		std::vector<std::shared_ptr<Bind::DepthStencil>> depthStencils(plan.resources.size());
+		for (size_t r = 0; r < plan.resources.size(); r++)
+		{
+			const auto& desc = plan.resources[r];
+			if (desc.type == TransientDesc::Type::RenderTarget)
+			{
+				renderTargets[r] = std::make_shared<Bind::ShaderInputRenderTarget>(gfx, desc.width, desc.height, desc.slot);
+				transientPool.push_back(renderTargets[r]);
+			}
+			else
+			{
+				depthStencils[r] = std::make_shared<Bind::OutputOnlyDepthStencil>(gfx, desc.width, desc.height);
+				transientPool.push_back(depthStencils[r]);
+			}
+		}
+		for (size_t t = 0; t < owners.size(); t++)
+		{
+			if (owners[t]->pRenderTarget)
+			{
+				*owners[t]->pRenderTarget = renderTargets[plan.assignment[t]];
+			}
+			else
+			{
+				*owners[t]->pDepthStencil = depthStencils[plan.assignment[t]];
+			}
+		}
+
+		std::ostringstream report;
+		report << "Transients: " << requests.size() << " requested, " << plan.resources.size() << " allocated" << std::endl
+			<< "  peak memory: " << plan.bytesUnaliased / 1024u << " KB unaliased, " << plan.bytesAliased / 1024u << " KB aliased" << std::endl;
+		return report.str();
+	}
+
+	size_t RenderGraph::FindPassIndex( const std::string& name ) const
+	{
+		const auto i = std::find_if( passes.begin(), passes.end(), [&name]( const auto& p ){
+			return p->GetName() == name;
+		} );
+		return size_t( i - passes.begin() );
+	}
+
+	const std::string& RenderGraph::GetFinalizeReport() const noexcept
+	{
+		return finalizeReport;
+	}
+
+	std::string RenderGraph::GetArenaReport() const
+	{
+		const auto stats = arena.GetStatistics();
+		std::ostringstream report;
+		report << "Frame arena: " << stats.bytesUsed / 1024u << " / " << stats.capacity / 1024u << " KB"
+			<< " (peak " << stats.bytesPeak / 1024u << " KB, " << stats.overflowBlocks << " overflow blocks)" << std::endl;
+		for (const auto& p : passes)
+		{
+			if (const auto pQueue = dynamic_cast<const RenderQueuePass*>(p.get()))
+			{
+				report << "  " << p->GetName() << ": " << pQueue->GetJobCount() << " jobs, "
+					<< pQueue->GetArenaBytes() << " bytes" << std::endl;
+			}
+		}
+		return report.str();
+	}
+
 	RenderQueuePass& RenderGraph::GetRenderQueue(const std::string& passName)
 	{
 		try
@@ -2,6 +2,9 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include "FrameArena.h"
+#include "CommandList.h"
+#include "ThreadPool.h"
 
 class Graphics;
 
@@ -9,6 +12,7 @@ namespace Bind
 {
 	class RenderTarget;
 	class DepthStencil;
+	class BufferResource;
 }
 
 namespace Rgph
@@ -24,21 +28,56 @@ namespace Rgph
 		RenderGraph(Graphics& gfx);
 		~RenderGraph();
 		void Execute(Graphics& gfx) noexcept(!IS_DEBUG);
+		// records every live pass into a command list of its own on the pool, then replays the lists in execution order
+		// each pass starts from the view set on gfx, so passes must not rely on view changes made by earlier passes
+		void Execute(Graphics& gfx, ThreadPool& pool);
 		void Reset() noexcept;
 		RenderQueuePass& GetRenderQueue(const std::string& passName);
 		void StoreDepth( Graphics& gfx, const std::string& path );
+		// execution order and culled passes decided by Finalize
+		const std::string& GetFinalizeReport() const noexcept;
+		// frame arena usage and the jobs and bytes of every render queue this frame
+		std::string GetArenaReport() const;
+		// when disabled, Execute runs every pass on the immediate context even if given a pool
+		// off in debug builds, whose dxgi info manager cannot be shared between threads
+		static bool& RecordingEnabled() noexcept
+		{
+			static bool enabled = !IS_DEBUG;
+			return enabled;
+		}
 	protected:
 		void SetSinkTarget(const std::string& sinkName, const std::string& target);
 		void AddGlobalSource(std::unique_ptr<Source>);
 		void AddGlobalSink(std::unique_ptr<Sink>);
-		void Finalize();
+		void Finalize( Graphics& gfx );
 		void AppendPass(std::unique_ptr<Pass> pass);
 		Pass& FindPassByName( const std::string& name );
 	private:
 		void LinkSinks(Pass& pass);
 		void LinkGlobalSinks();
+		// order passes so that every pass runs after the passes its sinks read from
+		std::vector<size_t> SortPasses() const;
+		// flag passes whose outputs reach a global sink
+		std::vector<bool> FindLivePasses() const;
+		size_t FindPassIndex( const std::string& name ) const;
+		// position of the last live pass reading what a pass exposes through a source, including passes reading it
+		// after another pass handed it on through a source of its own, and the end of the frame for global sinks
+		size_t FindLastUse( size_t pass, const std::string& sourceName, const std::vector<size_t>& position, const std::vector<bool>& live ) const;
+		// plan lifetimes of the transients requested by live passes and create the shared resources
+		std::string AllocateTransients( Graphics& gfx, const std::vector<size_t>& order, const std::vector<bool>& live );
 	private:
+		// in order of appending - culled passes are kept so that steps can still link to them
 		std::vector<std::unique_ptr<Pass>> passes;
+		// live passes in dependency order
+		std::vector<Pass*> executionOrder;
+		std::vector<Pass*> culledPasses;
+		std::vector<std::shared_ptr<Bind::BufferResource>> transientPool;
+		std::string finalizeReport;
+		// job storage of all render queues - rewound on reset
+		FrameArena arena;
+		// one per live pass, in execution order - created on first recorded execute
+		std::vector<std::unique_ptr<CommandList>> commandLists;
+		ThreadPool::TaskGroup recording;
 		std::vector<std::unique_ptr<Source>> globalSources;
 		std::vector<std::unique_ptr<Sink>> globalSinks;
 		std::shared_ptr<Bind::RenderTarget> backBufferTarget;
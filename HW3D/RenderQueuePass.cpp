@@ -1,25 +1,301 @@
 #include "RenderQueuePass.h"
+#include "Drawable.h"
+#include "Step.h"
+#include "VertexShader.h"
+#include "TransformCbuf.h"
+#include "InstanceBuffer.h"
+#include "FrameArena.h"
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
 
 namespace Rgph
 {
+	// shared by every queue recorded on the same thread - each instanced draw discards the previous contents
+	static thread_local std::unique_ptr<Bind::InstanceBuffer<Bind::TransformCbuf::Transforms>> pInstances;
+
+	RenderQueuePass::RenderQueuePass( std::string name, std::vector<std::shared_ptr<Bind::Bindable>> binds, SortPolicy policy )
+		:
+		BindingPass( std::move( name ), std::move( binds ) ),
+		policy( policy )
+	{}
+
 	void RenderQueuePass::Accept(Job job) noexcept
 	{
-		jobs.push_back(job);
+		assert( pArena != nullptr );
+		if ( jobs.size() == jobCapacity )
+		{
+			GrowJobs();
+		}
+		jobs = { jobs.data(), jobs.size() + 1u };
+		jobs.back() = job;
+	}
+
+	void RenderQueuePass::GrowJobs()
+	{
+		// queues usually receive as many jobs as in the previous frame, so this rarely runs more than once a frame
+		const auto capacity = std::max( { jobCapacity * 2u, expectedJobs, size_t( 16u ) } );
+		const auto pJobs = pArena->Allocate<Job>( capacity );
+		std::copy( jobs.begin(), jobs.end(), pJobs );
+		jobs = { pJobs, jobs.size() };
+		jobCapacity = capacity;
+		arenaBytes += sizeof( Job ) * capacity;
 	}
 
 	void RenderQueuePass::Execute(Graphics& gfx) const noexcept(!IS_DEBUG)
 	{
+		if ( !sorted )
+		{
+			SortJobs( gfx );
+			sorted = true;
+		}
+
 		BindAll(gfx);
 
+		Statistics stats;
+		const Step* pPrev = nullptr;
 		for (const auto& j : jobs)
 		{
-			j.Execute(gfx);
+			const auto& binds = j.GetStep().GetBindables();
+			stats.jobs++;
+			stats.stepBinds += binds.size();
+			if ( pPrev )
+			{
+				const auto& prevBinds = pPrev->GetBindables();
+				for ( size_t i = 0; i < binds.size() && i < prevBinds.size(); i++ )
+				{
+					if ( binds[i] == prevBinds[i] )
+						stats.redundantBinds++;
+				}
+			}
+			pPrev = &j.GetStep();
+		}
+
+		for ( size_t i = 0; i < jobs.size(); )
+		{
+			const auto count = CountInstances( i );
+			if ( count > 1u )
+			{
+				auto pVs = FindVertexShader( jobs[i] );
+				auto pInstancedVs = pVs ? pVs->GetInstancedVariant( gfx ) : nullptr;
+				if ( pInstancedVs )
+				{
+					ExecuteInstanced( gfx, i, count, *pVs, *pInstancedVs, stats );
+					i += count;
+					continue;
+				}
+			}
+			// no instanced shader to run with, so the jobs are drawn one by one
+			for ( const auto end = i + count; i < end; i++ )
+			{
+				jobs[i].Execute( gfx );
+				stats.draws++;
+			}
+		}
+		AddStatistics( stats );
+	}
+
+	size_t RenderQueuePass::CountInstances( size_t first ) const noexcept
+	{
+		const auto& leader = jobs[first];
+		const auto& binds = leader.GetStep().GetBindables();
+		if ( !InstancingEnabled() ||
+			std::none_of( binds.begin(), binds.end(), []( const auto& b ) { return IsInstanceTransform( *b ); } ) )
+		{
+			return 1u;
+		}
+
+		size_t count = 1u;
+		for ( ; first + count < jobs.size() && count < maxInstances; count++ )
+		{
+			const auto& job = jobs[first + count];
+			const auto& otherBinds = job.GetStep().GetBindables();
+			if ( !job.GetDrawable().SharesGeometry( leader.GetDrawable() ) || otherBinds.size() != binds.size() )
+			{
+				break;
+			}
+			// everything but the transforms must leave the pipeline in the same state
+			for ( size_t b = 0; b < binds.size(); b++ )
+			{
+				const bool compatible = IsInstanceTransform( *binds[b] ) ?
+					IsInstanceTransform( *otherBinds[b] ) :
+					binds[b]->BindsSameStateAs( *otherBinds[b] );
+				if ( !compatible )
+				{
+					return count;
+				}
+			}
+		}
+		return count;
+	}
+
+	Bind::VertexShader* RenderQueuePass::FindVertexShader( const Job& job ) const noexcept
+	{
+		const auto find = []( const std::vector<std::shared_ptr<Bind::Bindable>>& binds ) -> Bind::VertexShader*
+		{
+			// the last one bound wins
+			for ( auto it = binds.rbegin(); it != binds.rend(); ++it )
+			{
+				if ( auto pVs = dynamic_cast<Bind::VertexShader*>( it->get() ) )
+					return pVs;
+			}
+			return nullptr;
+		};
+		if ( auto pVs = find( job.GetStep().GetBindables() ) )
+		{
+			return pVs;
+		}
+		return find( GetBinds() );
+	}
+
+	void RenderQueuePass::ExecuteInstanced( Graphics& gfx, size_t first, size_t count, Bind::VertexShader& vs, Bind::VertexShader& instancedVs, Statistics& stats ) const noexcept(!IS_DEBUG)
+	{
+		assert( count <= maxInstances );
+		if ( !pInstances )
+		{
+			pInstances = std::make_unique<Bind::InstanceBuffer<Bind::TransformCbuf::Transforms>>( gfx, UINT( maxInstances ) );
+		}
+
+		static thread_local std::vector<Bind::TransformCbuf::Transforms> transforms;
+		transforms.clear();
+		for ( size_t i = first; i < first + count; i++ )
+		{
+			transforms.push_back( Bind::TransformCbuf::GetTransforms( gfx, jobs[i].GetTransformXM() ) );
 		}
+
+		// the first job stands in for the whole batch
+		const auto& leader = jobs[first];
+		leader.GetDrawable().Bind( gfx );
+		for ( const auto& b : leader.GetStep().GetBindables() )
+		{
+			if ( !IsInstanceTransform( *b ) )
+				b->Bind( gfx );
+		}
+		instancedVs.Bind( gfx );
+		pInstances->Update( gfx, transforms.data(), UINT( count ) );
+		pInstances->Bind( gfx );
+		gfx.DrawIndexedInstanced( leader.GetDrawable().GetIndexCount(), UINT( count ) );
+
+		// later jobs may rely on the pass having bound the regular shader
+		vs.Bind( gfx );
+
+		stats.draws++;
+		stats.instancedDraws++;
+		stats.instances += count;
+	}
+
+	void RenderQueuePass::AddStatistics( const Statistics& counted ) noexcept
+	{
+		static std::mutex mutex;
+		std::lock_guard lock( mutex );
+		auto& stats = GetStatistics();
+		stats.jobs += counted.jobs;
+		stats.stepBinds += counted.stepBinds;
+		stats.redundantBinds += counted.redundantBinds;
+		stats.draws += counted.draws;
+		stats.instances += counted.instances;
+		stats.instancedDraws += counted.instancedDraws;
+	}
+
+	bool RenderQueuePass::IsInstanceTransform( const Bind::Bindable& bind ) noexcept
+	{
+		// derived transform cbufs alter the transforms, so only the plain one can be replaced by the instance buffer
+		return typeid( bind ) == typeid( Bind::TransformCbuf );
 	}
 
 	void RenderQueuePass::Reset() noexcept(!IS_DEBUG)
 	{
-		jobs.clear();
+		// the storage itself is reclaimed when the graph rewinds its arena
+		expectedJobs = jobs.size();
+		jobs = {};
+		scratch = {};
+		jobCapacity = 0u;
+		arenaBytes = 0u;
+		sorted = false;
+	}
+
+	void RenderQueuePass::SetArena( FrameArena& arena ) noexcept
+	{
+		assert( jobs.empty() );
+		pArena = &arena;
+	}
+
+	size_t RenderQueuePass::GetJobCount() const noexcept
+	{
+		return jobs.size();
 	}
 
+	size_t RenderQueuePass::GetArenaBytes() const noexcept
+	{
+		return arenaBytes;
+	}
+
+	void RenderQueuePass::SortJobs( Graphics& gfx ) const noexcept(!IS_DEBUG)
+	{
+		if ( policy == SortPolicy::None || !SortingEnabled() || jobs.size() < 2u )
+		{
+			return;
+		}
+
+		// build keys - depth is the view space distance of the drawable's origin
+		const auto view = gfx.GetCamera();
+		for ( auto& j : jobs )
+		{
+			const auto world = j.GetTransformXM();
+			const auto depth = QuantizeDepth( DirectX::XMVectorGetZ( DirectX::XMVector3Transform( world.r[3], view ) ) );
+			const uint64_t shader = j.GetStep().GetShaderKey();
+			const uint64_t material = j.GetStep().GetMaterialKey();
+			switch ( policy )
+			{
+			case SortPolicy::State:
+				j.sortKey = shader << 48 | material << 24 | depth;
+				break;
+			case SortPolicy::FrontToBack:
+				j.sortKey = uint64_t( depth ) << 40 | shader << 24 | material;
+				break;
+			case SortPolicy::BackToFront:
+				j.sortKey = uint64_t( ~depth & 0xFFFFFFu ) << 40 | shader << 24 | material;
+				break;
+			}
+		}
+
+		// lsd radix sort on 8-bit digits - stable, so equal keys keep submission order
+		scratch = { pArena->Allocate<Job>( jobs.size() ), jobs.size() };
+		arenaBytes += sizeof( Job ) * jobs.size();
+		for ( unsigned int shift = 0u; shift < 64u; shift += 8u )
+		{
+			std::array<size_t, 257> offsets{};
+			for ( const auto& j : jobs )
+			{
+				offsets[( ( j.sortKey >> shift ) & 0xFFu ) + 1u]++;
+			}
+			// every key has the same digit here so this pass would not move anything
+			if ( std::find( offsets.begin() + 1, offsets.end(), jobs.size() ) != offsets.end() )
+			{
+				continue;
+			}
+			for ( size_t d = 1; d < offsets.size(); d++ )
+			{
+				offsets[d] += offsets[d - 1];
+			}
+			for ( const auto& j : jobs )
+			{
+				scratch[offsets[( j.sortKey >> shift ) & 0xFFu]++] = j;
+			}
+			std::swap( jobs, scratch );
+		}
+		// jobs may now live in the exactly sized scratch storage
+		jobCapacity = jobs.size();
+	}
+
+	uint32_t RenderQueuePass::QuantizeDepth( float depth ) noexcept
+	{
+		// bit patterns of non-negative floats order the same as their values
+		// dropping the sign and the low mantissa bits leaves a monotonic 24-bit bucket
+		depth = depth > 0.0f ? depth : 0.0f;
+		uint32_t bits;
+		std::memcpy( &bits, &depth, sizeof( bits ) );
+		return bits >> 7u;
+	}
 }
\ No newline at end of file
@@ -2,17 +2,99 @@
 #include "BindingPass.h"
 #include "Job.h"
 #include <vector>
+#include <span>
+
+namespace Bind
+{
+	class VertexShader;
+}
 
 namespace Rgph
 {
+	class FrameArena;
+
 	class RenderQueuePass : public BindingPass
 	{
 	public:
-		using BindingPass::BindingPass;
+		// jobs are sorted on a 64-bit key once per frame before they are executed
+		// the queue belongs to a single pass, so the pass itself needs no bits in the key
+		enum class SortPolicy
+		{
+			// submission order
+			None,
+			// shader, then textures and fixed function state, then front to back
+			State,
+			// front to back first - best for early depth rejection of opaque geometry
+			FrontToBack,
+			// back to front first - required for blended geometry
+			BackToFront
+		};
+		struct Statistics
+		{
+			size_t jobs = 0u;
+			size_t stepBinds = 0u;
+			// step bindables identical to the one at the same position in the previous job's step
+			size_t redundantBinds = 0u;
+			size_t draws = 0u;
+			// jobs merged into instanced draws and the draws they were merged into
+			size_t instances = 0u;
+			size_t instancedDraws = 0u;
+		};
+	public:
+		RenderQueuePass( std::string name, std::vector<std::shared_ptr<Bind::Bindable>> binds = {}, SortPolicy policy = SortPolicy::None );
 		void Accept(Job job) noexcept;
 		void Execute(Graphics& gfx) const noexcept(!IS_DEBUG) override;
 		void Reset() noexcept(!IS_DEBUG) override;
+		// jobs are stored in the graph's frame arena - must be set before the first job is accepted
+		void SetArena( FrameArena& arena ) noexcept;
+		size_t GetJobCount() const noexcept;
+		// bytes taken from the arena this frame, including storage left behind when the queue grew
+		size_t GetArenaBytes() const noexcept;
+		static Statistics& GetStatistics() noexcept
+		{
+			static Statistics stats;
+			return stats;
+		}
+		static void ResetStatistics() noexcept
+		{
+			GetStatistics() = {};
+		}
+		// global switch so the effect of sorting can be compared at runtime
+		static bool& SortingEnabled() noexcept
+		{
+			static bool enabled = true;
+			return enabled;
+		}
+		// global switch for merging jobs into instanced draws
+		static bool& InstancingEnabled() noexcept
+		{
+			static bool enabled = true;
+			return enabled;
+		}
+		// most jobs merged into a single instanced draw
+		static constexpr size_t maxInstances = 256u;
+	private:
+		// number of jobs starting at first that only differ in their transforms and can share one draw
+		size_t CountInstances( size_t first ) const noexcept;
+		// vertex shader the job will run with - bound by its step or else by the pass
+		Bind::VertexShader* FindVertexShader( const Job& job ) const noexcept;
+		void ExecuteInstanced( Graphics& gfx, size_t first, size_t count, Bind::VertexShader& vs, Bind::VertexShader& instancedVs, Statistics& stats ) const noexcept(!IS_DEBUG);
+		// queues recorded on different threads count into statistics of their own and add them up at the end
+		static void AddStatistics( const Statistics& counted ) noexcept;
+		static bool IsInstanceTransform( const Bind::Bindable& bind ) noexcept;
+		void SortJobs( Graphics& gfx ) const noexcept(!IS_DEBUG);
+		static uint32_t QuantizeDepth( float depth ) noexcept;
+		void GrowJobs();
 	private:
-		std::vector<Job> jobs;
+		SortPolicy policy;
+		FrameArena* pArena = nullptr;
+		// sorting happens on the first execute of a frame - passes may execute their queue more than once
+		mutable std::span<Job> jobs;
+		mutable std::span<Job> scratch;
+		mutable size_t jobCapacity = 0u;
+		mutable size_t arenaBytes = 0u;
+		mutable bool sorted = false;
+		// jobs accepted last frame - the first allocation of a frame is sized to hold that many
+		size_t expectedJobs = 0u;
 	};
 }
\ No newline at end of file
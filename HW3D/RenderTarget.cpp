@@ -85,7 +85,7 @@ namespace Bind
 	void RenderTarget::BindAsBuffer(Graphics& gfx, ID3D11DepthStencilView* pDepthStencilView) noexcept
 	{
 		INFOMANAGER_NOHR( gfx );
-		GFX_THROW_INFO_ONLY( GetContext(gfx)->OMSetRenderTargets( 1, pTargetView.GetAddressOf(), pDepthStencilView ) );
+		GFX_THROW_INFO_ONLY( GetStateCache(gfx).OMSetRenderTargets( 1, pTargetView.GetAddressOf(), pDepthStencilView ) );
 
 		// configure viewport
 		D3D11_VIEWPORT vp;
@@ -95,13 +95,15 @@ namespace Bind
 		vp.MaxDepth = 1.0f;
 		vp.TopLeftX = 0.0f;
 		vp.TopLeftY = 0.0f;
-		GFX_THROW_INFO_ONLY( GetContext(gfx)->RSSetViewports(1u, &vp) );
+		GFX_THROW_INFO_ONLY( GetStateCache(gfx).RSSetViewport(vp) );
 	}
 
 	void RenderTarget::Clear(Graphics& gfx, const std::array<float, 4>& color) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER_NOHR( gfx );
 		GFX_THROW_INFO_ONLY( GetContext(gfx)->ClearRenderTargetView(pTargetView.Get(), color.data()) );
+		if ( const auto pLog = gfx.GetLog() )
+			pLog->Add( CommandLog::Type::Clear, "ClearRenderTargetView", 0u, 0u, pTargetView.Get(), color.data(), sizeof( color ) );
 	}
 
 	void RenderTarget::Clear(Graphics& gfx) noexcept(!IS_DEBUG)
@@ -143,7 +145,7 @@ namespace Bind
 	void ShaderInputRenderTarget::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER_NOHR( gfx );
-		GFX_THROW_INFO_ONLY( GetContext(gfx)->PSSetShaderResources(slot, 1, pShaderResourceView.GetAddressOf()) );
+		GFX_THROW_INFO_ONLY( GetStateCache(gfx).PSSetShaderResource(slot, pShaderResourceView.Get()) );
 	}
 
 	void OutputOnlyRenderTarget::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
@@ -27,7 +27,7 @@ namespace Bind
 
 	void Sampler::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->PSSetSamplers( slot, 1u, pSampler.GetAddressOf() ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).PSSetSampler( slot, pSampler.Get() ) );
 	}
 
 	std::shared_ptr<Sampler> Sampler::Resolve( Graphics& gfx, Type type, bool reflect, UINT slot )
@@ -35,14 +35,13 @@ namespace Bind
 		return Codex::Resolve<Sampler>( gfx, type, reflect, slot );
 	}
 
-	std::string Sampler::GenerateUID( Type type, bool reflect, UINT slot )
+	BindKey Sampler::GenerateKey( Type type, bool reflect, UINT slot )
 	{
-		using namespace std::string_literals;
-		return typeid( Sampler ).name() + "#"s + std::to_string( (int)type ) + ( reflect ? "R"s : "W"s ) + "@"s + std::to_string( slot );
+		return BindKey::Make<Sampler>( type, reflect, slot );
 	}
 
-	std::string Sampler::GetUID() const noexcept
+	BindKey Sampler::GetKey() const noexcept(!IS_DEBUG)
 	{
-		return GenerateUID( type, reflect, slot );
+		return GenerateKey( type, reflect, slot );
 	}
 }
\ No newline at end of file
@@ -15,8 +15,8 @@ namespace Bind
 		Sampler( Graphics& gfx, Type type, bool reflect, UINT slot );
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		static std::shared_ptr<Sampler> Resolve( Graphics& gfx, Type type = Type::Anisotropic, bool reflect = false, UINT slot = 0u );
-		static std::string GenerateUID( Type type, bool reflect, UINT slot );
-		std::string GetUID() const noexcept override;
+		static BindKey GenerateKey( Type type, bool reflect, UINT slot );
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
 	protected:
 		Microsoft::WRL::ComPtr<ID3D11SamplerState> pSampler;
 		Type type;
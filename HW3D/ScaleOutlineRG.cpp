@@ -37,6 +37,6 @@ namespace Rgph
 			AppendPass(std::move(pass));
 		}
 		SetSinkTarget("backbuffer", "outlineDraw.renderTarget");
-		Finalize();
+		Finalize(gfx);
 	}
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "ScriptCommander.h"
 #include "TexturePreprocessor.h"
+#include "Benchmark.h"
+#include "ModelBaker.h"
+#include "MeshOptimizer.h"
 #include "json/json.hpp"
 #include <sstream>
 #include <fstream>
@@ -25,6 +28,7 @@ ScriptCommander::ScriptCommander( const std::vector<std::string>& args )
 		if( top.at( "enabled" ) )
 		{
 			bool abort = false;
+			std::ostringstream report;
 			for( const auto& j : top.at( "commands" ) )
 			{
 				const auto commandName = j.at( "command" ).get<std::string>();
@@ -45,6 +49,108 @@ ScriptCommander::ScriptCommander( const std::vector<std::string>& args )
 					TexturePreprocessor::ValidateNormalMap( params.at( "source" ),params.at( "min" ),params.at( "max" ) );
 					abort = true;
 				}
+				else if( commandName == "bench-dcb" )
+				{
+					report << std::endl << Benchmark::DynamicConstantAccess( params.value( "iterations",100000u ) );
+					abort = true;
+				}
+				else if( commandName == "stress-layout-codex" )
+				{
+					report << std::endl << Benchmark::LayoutCodexStress( params.value( "threads",8u ),params.value( "layouts",4096u ) );
+					abort = true;
+				}
+				else if( commandName == "bench-headless" )
+				{
+					report << std::endl << Benchmark::HeadlessFrames( params.value( "frames",100u ),
+						params.value( "model","res\\models\\sponza\\sponza.obj"s ),params.value( "scale",1.0f / 20.0f ) );
+					abort = true;
+				}
+				else if( commandName == "bench-sort" )
+				{
+					report << std::endl << Benchmark::JobSorting( params.value( "frames",10u ),
+						params.value( "model","res\\models\\sponza\\sponza.obj"s ),params.value( "scale",1.0f / 20.0f ) );
+					abort = true;
+				}
+				else if( commandName == "check-uploads" )
+				{
+					report << std::endl << Benchmark::CleanUploads( params.value( "frames",10u ),
+						params.value( "model","res\\models\\sponza\\sponza.obj"s ),params.value( "scale",1.0f / 20.0f ) );
+					abort = true;
+				}
+				else if( commandName == "bench-transforms" )
+				{
+					report << std::endl << Benchmark::TransformUpdate( params.value( "iterations",1000u ),
+						params.value( "model","res\\models\\sponza\\sponza.obj"s ),params.value( "scale",1.0f / 20.0f ) );
+					abort = true;
+				}
+				else if( commandName == "bench-load" )
+				{
+					// sponza and the three characters the app loads at startup unless models are given
+					std::vector<std::pair<std::string,float>> models = {
+						{ "res\\models\\sponza\\sponza.obj"s,1.0f / 20.0f },
+						{ "res\\models\\nanosuit\\nanosuit.obj"s,2.0f },
+						{ "res\\models\\goblin\\GoblinX.obj"s,4.0f },
+						{ "res\\models\\backpack\\backpack.obj"s,4.0f },
+					};
+					if( params.contains( "models" ) )
+					{
+						models.clear();
+						for( const auto& m : params.at( "models" ) )
+						{
+							models.emplace_back( m.at( "path" ).get<std::string>(),m.value( "scale",1.0f ) );
+						}
+					}
+					report << std::endl << Benchmark::ModelLoad( params.value( "runs",3u ),models );
+					abort = true;
+				}
+				else if( commandName == "bake-model" )
+				{
+					const auto source = params.at( "source" ).get<std::string>();
+					const auto dest = params.value( "dest",ModelBaker::MakeBakedPath( source ) );
+					// baked meshes keep the order they were baked in, so overdraw ordering can be chosen per bake
+					MeshOptimizer::OverdrawEnabled() = params.value( "overdraw",MeshOptimizer::OverdrawEnabled() );
+					ModelBaker::Bake( source,dest,params.value( "scale",1.0f ) );
+					report << std::endl << "[Bake] " << source << " -> " << dest << std::endl;
+					abort = true;
+				}
+				else if( commandName == "bench-baked" )
+				{
+					report << std::endl << Benchmark::BakedLoad( params.value( "runs",3u ),
+						params.value( "model","res\\models\\sponza\\sponza.obj"s ),params.value( "scale",1.0f / 20.0f ) );
+					abort = true;
+				}
+				else if( commandName == "check-index-width" )
+				{
+					report << std::endl << Benchmark::IndexWidth( params.value( "vertices",std::vector<size_t>{ 3u,65535u,65536u,65537u,200000u } ) );
+					abort = true;
+				}
+				else if( commandName == "bench-mesh-opt" )
+				{
+					report << std::endl << Benchmark::MeshOptimization( params.value( "model","res\\models\\sponza\\sponza.obj"s ),params.value( "cache",16u ) );
+					abort = true;
+				}
+				else if( commandName == "check-command-order" )
+				{
+					report << std::endl << Benchmark::CommandOrder( params.value( "frames",3u ),
+						params.value( "model","res\\models\\sponza\\sponza.obj"s ),params.value( "scale",1.0f / 20.0f ) );
+					abort = true;
+				}
+				else if( commandName == "check-graph-order" )
+				{
+					report << std::endl << Benchmark::GraphOrder();
+					abort = true;
+				}
+				else if( commandName == "check-transients" )
+				{
+					report << std::endl << Benchmark::TransientAliasing( params.value( "trials",1000u ) );
+					abort = true;
+				}
+				else if( commandName == "replay-capture" )
+				{
+					report << std::endl << Benchmark::ReplayCapture( params.value( "frames",100u ),
+						params.value( "capture","res\\captures\\frame.capture"s ) );
+					abort = true;
+				}
 				else if( commandName == "publish" )
 				{
 					Publish( params.at( "dest" ) );
@@ -57,7 +163,7 @@ ScriptCommander::ScriptCommander( const std::vector<std::string>& args )
 			}
 			if( abort )
 			{
-				throw Completion( "Command(s) completed successfully" );
+				throw Completion( "Command(s) completed successfully"s + report.str() );
 			}
 		}
 	}
@@ -23,9 +23,9 @@ namespace Rgph
 	{
 	public:
 		ShadowMappingPass( Graphics& gfx, std::string name ) :
-			RenderQueuePass( std::move( name ) )
+			RenderQueuePass( std::move( name ), {}, SortPolicy::State )
 		{
-			depthStencil = std::make_shared<Bind::OutputOnlyDepthStencil>( gfx, size, size );
+			RequestTransient( depthStencil, size, size );
 			pDepthCube = std::make_shared<Bind::CubeTargetTexture>( gfx, size, size, 3, DXGI_FORMAT_R32_FLOAT );
 			AddBind( Bind::VertexShader::Resolve( gfx, "ShadowCubeVS.cso" ) );
 			AddBind( Bind::PixelShader::Resolve( gfx, "ShadowCubePS.cso" ) );
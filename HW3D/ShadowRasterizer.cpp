@@ -28,7 +28,7 @@ namespace Bind
 	void ShadowRasterizer::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER_NOHR( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->RSSetState( pRasterizer.Get() ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).RSSetState( pRasterizer.Get() ) );
 	}
 
 	int ShadowRasterizer::GetDepthBias() const
@@ -43,7 +43,7 @@ namespace Bind
 	void ShadowSampler::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER_NOHR( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->PSSetSamplers( GetCurrentSlot(), 1u, samplers[currentSampler].GetAddressOf() ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).PSSetSampler( GetCurrentSlot(), samplers[currentSampler].Get() ) );
 	}
 
 	void ShadowSampler::SetBilinear( bool bilin )
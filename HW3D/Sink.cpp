@@ -25,6 +25,11 @@ namespace Rgph
 		return registeredName;
 	}
 
+	const void* Sink::GetMemberAddress() const noexcept
+	{
+		return nullptr;
+	}
+
 	const std::string& Sink::GetPassName() const noexcept
 	{
 		return passName;
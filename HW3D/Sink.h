@@ -30,6 +30,8 @@ namespace Rgph
 		const std::string& GetOutputName() const noexcept;
 		void SetTarget(std::string passName, std::string outputName);
 		virtual void Bind(Source& source) = 0;
+		// pass member the linked resource is stored into - a source of the same pass exposing that member hands it on
+		virtual const void* GetMemberAddress() const noexcept;
 		virtual void PostLinkValidate() const = 0;
 		virtual ~Sink() = default;
 	protected:
@@ -69,6 +71,10 @@ namespace Rgph
 			target = std::move(p);
 			linked = true;
 		}
+		const void* GetMemberAddress() const noexcept override
+		{
+			return &target;
+		}
 		DirectBufferSink(std::string registeredName, std::shared_ptr<T>& bind)
 			:
 			Sink(std::move(registeredName)),
@@ -145,6 +151,10 @@ namespace Rgph
 			target = std::move(p);
 			linked = true;
 		}
+		const void* GetMemberAddress() const noexcept override
+		{
+			return &target;
+		}
 		DirectBindableSink(std::string registeredName, std::shared_ptr<T>& target)
 			:
 			Sink(std::move(registeredName)),
@@ -31,6 +31,11 @@ namespace Rgph
 		throw RGC_EXCEPTION("Output cannot be accessed as buffer");
 	}
 
+	const void* Source::GetMemberAddress() const noexcept
+	{
+		return nullptr;
+	}
+
 	const std::string& Source::GetName() const noexcept
 	{
 		return name;
@@ -18,6 +18,8 @@ namespace Rgph
 		virtual void PostLinkValidate() const = 0;
 		virtual std::shared_ptr<Bind::Bindable> YieldBindable();
 		virtual std::shared_ptr<Bind::BufferResource> YieldBuffer();
+		// pass member the source exposes - null when it is not a member of the pass
+		virtual const void* GetMemberAddress() const noexcept;
 		virtual ~Source() = default;
 	protected:
 		Source(std::string name);
@@ -49,6 +51,10 @@ namespace Rgph
 			linked = true;
 			return buffer;
 		}
+		const void* GetMemberAddress() const noexcept override
+		{
+			return &buffer;
+		}
 	private:
 		std::shared_ptr<T>& buffer;
 		bool linked = false;
@@ -73,6 +79,10 @@ namespace Rgph
 		{
 			return bind;
 		}
+		const void* GetMemberAddress() const noexcept override
+		{
+			return &bind;
+		}
 	private:
 		std::shared_ptr<T>& bind;
 	};
@@ -36,25 +36,25 @@ public:
 		}
 
 		// add cap vertices
-		const auto iNorthPole = (unsigned short)vb.Size();
+		const auto iNorthPole = (unsigned int)vb.Size();
 		{
 			DirectX::XMFLOAT3 northPos;
 			DirectX::XMStoreFloat3( &northPos, base );
 			vb.EmplaceBack( northPos );
 		}
-		const auto iSouthPole = (unsigned short)vb.Size();
+		const auto iSouthPole = (unsigned int)vb.Size();
 		{
 			DirectX::XMFLOAT3 southPos;
 			DirectX::XMStoreFloat3( &southPos, DirectX::XMVectorNegate( base ) );
 			vb.EmplaceBack( southPos );
 		}
 
-		const auto calcIdx = [latDiv, longDiv](unsigned short iLat, unsigned short iLong)
-		{ return iLat * longDiv + iLong; };
-		std::vector<unsigned short> indices;
-		for (unsigned short iLat = 0; iLat < latDiv - 2; iLat++)
+		const auto calcIdx = [latDiv, longDiv](unsigned int iLat, unsigned int iLong)
+		{ return iLat * (unsigned int)longDiv + iLong; };
+		std::vector<unsigned int> indices;
+		for (unsigned int iLat = 0; iLat < (unsigned int)latDiv - 2u; iLat++)
 		{
-			for (unsigned short iLong = 0; iLong < longDiv - 1; iLong++)
+			for (unsigned int iLong = 0; iLong < (unsigned int)longDiv - 1u; iLong++)
 			{
 				indices.push_back(calcIdx(iLat, iLong));
 				indices.push_back(calcIdx(iLat + 1, iLong));
@@ -73,7 +73,7 @@ public:
 		}
 
 		// cap fans
-		for (unsigned short iLong = 0; iLong < longDiv - 1; iLong++)
+		for (unsigned int iLong = 0; iLong < (unsigned int)longDiv - 1u; iLong++)
 		{
 			// north
 			indices.push_back(iNorthPole);
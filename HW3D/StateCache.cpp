@@ -0,0 +1,223 @@
+#include "StateCache.h"
+#include <cassert>
+#include <algorithm>
+
+StateCache::StateCache( ID3D11DeviceContext* pContext ) noexcept : pContext( pContext ) { }
+
+void StateCache::VSSetShader( ID3D11VertexShader* pShader ) noexcept
+{
+	if ( Update( vertexShader, pShader ) )
+	{
+		pContext->VSSetShader( pShader, nullptr, 0u );
+		Log( "VSSetShader", 0u, pShader );
+	}
+}
+
+void StateCache::PSSetShader( ID3D11PixelShader* pShader ) noexcept
+{
+	if ( Update( pixelShader, pShader ) )
+	{
+		pContext->PSSetShader( pShader, nullptr, 0u );
+		Log( "PSSetShader", 0u, pShader );
+	}
+}
+
+void StateCache::IASetInputLayout( ID3D11InputLayout* pLayout ) noexcept
+{
+	if ( Update( inputLayout, pLayout ) )
+	{
+		pContext->IASetInputLayout( pLayout );
+		Log( "IASetInputLayout", 0u, pLayout );
+	}
+}
+
+void StateCache::IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY type ) noexcept
+{
+	if ( Update( topology, type ) )
+	{
+		pContext->IASetPrimitiveTopology( type );
+		Log( "IASetPrimitiveTopology", UINT( type ), nullptr );
+	}
+}
+
+void StateCache::IASetIndexBuffer( ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset ) noexcept
+{
+	if ( Update( indexBuffer, { pBuffer, format, offset } ) )
+	{
+		pContext->IASetIndexBuffer( pBuffer, format, offset );
+		const UINT args[] = { UINT( format ), offset };
+		Log( "IASetIndexBuffer", 0u, pBuffer, args, sizeof( args ) );
+	}
+}
+
+void StateCache::IASetVertexBuffer( UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset ) noexcept
+{
+	assert( slot < vertexBuffers.size() );
+	if ( Update( vertexBuffers[slot], { pBuffer, stride, offset } ) )
+	{
+		pContext->IASetVertexBuffers( slot, 1u, &pBuffer, &stride, &offset );
+		const UINT args[] = { stride, offset };
+		Log( "IASetVertexBuffers", slot, pBuffer, args, sizeof( args ) );
+	}
+}
+
+void StateCache::VSSetConstantBuffer( UINT slot, ID3D11Buffer* pBuffer ) noexcept
+{
+	assert( slot < vsConstantBuffers.size() );
+	// contents renamed by a map with discard stay bound, so the same buffer never needs rebinding
+	if ( Update( vsConstantBuffers[slot], pBuffer ) )
+	{
+		pContext->VSSetConstantBuffers( slot, 1u, &pBuffer );
+		Log( "VSSetConstantBuffers", slot, pBuffer );
+	}
+}
+
+void StateCache::PSSetConstantBuffer( UINT slot, ID3D11Buffer* pBuffer ) noexcept
+{
+	assert( slot < psConstantBuffers.size() );
+	if ( Update( psConstantBuffers[slot], pBuffer ) )
+	{
+		pContext->PSSetConstantBuffers( slot, 1u, &pBuffer );
+		Log( "PSSetConstantBuffers", slot, pBuffer );
+	}
+}
+
+void StateCache::VSSetShaderResource( UINT slot, ID3D11ShaderResourceView* pView ) noexcept
+{
+	assert( slot < vsShaderResources.size() );
+	if ( Update( vsShaderResources[slot], pView ) )
+	{
+		pContext->VSSetShaderResources( slot, 1u, &pView );
+		Log( "VSSetShaderResources", slot, pView );
+	}
+}
+
+void StateCache::PSSetShaderResource( UINT slot, ID3D11ShaderResourceView* pView ) noexcept
+{
+	assert( slot < psShaderResources.size() );
+	if ( Update( psShaderResources[slot], pView ) )
+	{
+		pContext->PSSetShaderResources( slot, 1u, &pView );
+		Log( "PSSetShaderResources", slot, pView );
+	}
+}
+
+void StateCache::PSSetSampler( UINT slot, ID3D11SamplerState* pSampler ) noexcept
+{
+	assert( slot < psSamplers.size() );
+	if ( Update( psSamplers[slot], pSampler ) )
+	{
+		pContext->PSSetSamplers( slot, 1u, &pSampler );
+		Log( "PSSetSamplers", slot, pSampler );
+	}
+}
+
+void StateCache::OMSetBlendState( ID3D11BlendState* pState ) noexcept
+{
+	if ( Update( blendState, pState ) )
+	{
+		pContext->OMSetBlendState( pState, nullptr, 0xFFFFFFFFu );
+		Log( "OMSetBlendState", 0u, pState );
+	}
+}
+
+void StateCache::OMSetDepthStencilState( ID3D11DepthStencilState* pState, UINT stencilRef ) noexcept
+{
+	if ( Update( depthStencilState, { pState, stencilRef } ) )
+	{
+		pContext->OMSetDepthStencilState( pState, stencilRef );
+		Log( "OMSetDepthStencilState", stencilRef, pState );
+	}
+}
+
+void StateCache::RSSetState( ID3D11RasterizerState* pState ) noexcept
+{
+	if ( Update( rasterizerState, pState ) )
+	{
+		pContext->RSSetState( pState );
+		Log( "RSSetState", 0u, pState );
+	}
+}
+
+void StateCache::OMSetRenderTargets( UINT nViews, ID3D11RenderTargetView* const* ppViews, ID3D11DepthStencilView* pDepthView ) noexcept
+{
+	// targets change a handful of times per frame, so they are always issued
+	pContext->OMSetRenderTargets( nViews, ppViews, pDepthView );
+	stats.issued++;
+	if ( pLog )
+	{
+		// the views, then the depth view
+		std::array<const void*, D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT + 1u> views{};
+		std::copy( ppViews, ppViews + nViews, views.begin() );
+		views[nViews] = pDepthView;
+		Log( "OMSetRenderTargets", nViews, nViews > 0u ? ppViews[0] : nullptr, views.data(), ( nViews + 1u ) * sizeof( const void* ) );
+	}
+	// the runtime may have nulled any of the cached views, and it does not say which
+	InvalidateShaderResources();
+}
+
+void StateCache::RSSetViewport( const D3D11_VIEWPORT& viewport ) noexcept
+{
+	// set once per pass at most, so never cached either
+	pContext->RSSetViewports( 1u, &viewport );
+	stats.issued++;
+	Log( "RSSetViewports", 0u, nullptr, &viewport, sizeof( viewport ) );
+}
+
+void StateCache::InvalidateShaderResources() noexcept
+{
+	vsShaderResources.fill( {} );
+	psShaderResources.fill( {} );
+}
+
+void StateCache::Invalidate() noexcept
+{
+	vertexShader = {};
+	pixelShader = {};
+	inputLayout = {};
+	topology = {};
+	indexBuffer = {};
+	vertexBuffers.fill( {} );
+	vsConstantBuffers.fill( {} );
+	psConstantBuffers.fill( {} );
+	vsShaderResources.fill( {} );
+	psShaderResources.fill( {} );
+	psSamplers.fill( {} );
+	blendState = {};
+	depthStencilState = {};
+	rasterizerState = {};
+}
+
+const StateCache::Statistics& StateCache::GetStatistics() const noexcept
+{
+	return stats;
+}
+
+void StateCache::ResetStatistics() noexcept
+{
+	stats = {};
+}
+
+void StateCache::AddStatistics( const Statistics& other ) noexcept
+{
+	stats.issued += other.issued;
+	stats.skipped += other.skipped;
+}
+
+void StateCache::SetLog( CommandLog* pLog_in ) noexcept
+{
+	pLog = pLog_in;
+}
+
+CommandLog* StateCache::GetLog() const noexcept
+{
+	return pLog;
+}
+
+void StateCache::Log( const char* call, UINT slot, const void* pObject, const void* pData, size_t dataSize ) noexcept
+{
+	if ( pLog )
+	{
+		pLog->Add( CommandLog::Type::Bind, call, slot, 0u, pObject, pData, dataSize );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+#include "CommandLog.h"
+#include <d3d11.h>
+#include <array>
+
+// shadow copy of the pipeline state bound through one context - the immediate one or a pass's deferred one
+// bindables route their binds through here so that rebinding what is already bound never reaches the driver
+// only valid while every state change goes through the cache - call Invalidate() after touching the context directly
+class StateCache
+{
+public:
+	// binds forwarded to the context vs binds dropped as redundant - reset once per frame
+	struct Statistics
+	{
+		size_t issued = 0u;
+		size_t skipped = 0u;
+	};
+public:
+	StateCache( ID3D11DeviceContext* pContext ) noexcept;
+	StateCache( const StateCache& ) = delete;
+	StateCache& operator=( const StateCache& ) = delete;
+	// shaders
+	void VSSetShader( ID3D11VertexShader* pShader ) noexcept;
+	void PSSetShader( ID3D11PixelShader* pShader ) noexcept;
+	// input assembler
+	void IASetInputLayout( ID3D11InputLayout* pLayout ) noexcept;
+	void IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY topology ) noexcept;
+	void IASetIndexBuffer( ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset ) noexcept;
+	void IASetVertexBuffer( UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset ) noexcept;
+	// shader resources
+	void VSSetConstantBuffer( UINT slot, ID3D11Buffer* pBuffer ) noexcept;
+	void PSSetConstantBuffer( UINT slot, ID3D11Buffer* pBuffer ) noexcept;
+	void VSSetShaderResource( UINT slot, ID3D11ShaderResourceView* pView ) noexcept;
+	void PSSetShaderResource( UINT slot, ID3D11ShaderResourceView* pView ) noexcept;
+	void PSSetSampler( UINT slot, ID3D11SamplerState* pSampler ) noexcept;
+	// fixed function state
+	void OMSetBlendState( ID3D11BlendState* pState ) noexcept;
+	void OMSetDepthStencilState( ID3D11DepthStencilState* pState, UINT stencilRef ) noexcept;
+	void RSSetState( ID3D11RasterizerState* pState ) noexcept;
+	// binding outputs silently unbinds any shader resource views of the same resources
+	void OMSetRenderTargets( UINT nViews, ID3D11RenderTargetView* const* ppViews, ID3D11DepthStencilView* pDepthView ) noexcept;
+	void RSSetViewport( const D3D11_VIEWPORT& viewport ) noexcept;
+	void InvalidateShaderResources() noexcept;
+	void Invalidate() noexcept;
+	const Statistics& GetStatistics() const noexcept;
+	void ResetStatistics() noexcept;
+	// folds in the counts of a cache that shadowed another context, e.g. one a pass was recorded on
+	void AddStatistics( const Statistics& other ) noexcept;
+	// every bind that reaches the context is also added to the log - null for none
+	void SetLog( CommandLog* pLog ) noexcept;
+	CommandLog* GetLog() const noexcept;
+private:
+	// cached value of a single pipeline slot - unknown until first bound after an invalidate
+	template<typename T>
+	struct Slot
+	{
+		T value{};
+		bool known = false;
+	};
+	struct VertexBufferState
+	{
+		ID3D11Buffer* pBuffer;
+		UINT stride;
+		UINT offset;
+		bool operator==( const VertexBufferState& ) const noexcept = default;
+	};
+	struct IndexBufferState
+	{
+		ID3D11Buffer* pBuffer;
+		DXGI_FORMAT format;
+		UINT offset;
+		bool operator==( const IndexBufferState& ) const noexcept = default;
+	};
+	struct DepthStencilState
+	{
+		ID3D11DepthStencilState* pState;
+		UINT stencilRef;
+		bool operator==( const DepthStencilState& ) const noexcept = default;
+	};
+	void Log( const char* call, UINT slot, const void* pObject, const void* pData = nullptr, size_t dataSize = 0u ) noexcept;
+	// records the new value and returns true if the bind has to be issued
+	template<typename T>
+	bool Update( Slot<T>& slot, const T& value ) noexcept
+	{
+		if ( slot.known && slot.value == value )
+		{
+			stats.skipped++;
+			return false;
+		}
+		slot.value = value;
+		slot.known = true;
+		stats.issued++;
+		return true;
+	}
+private:
+	ID3D11DeviceContext* pContext;
+	CommandLog* pLog = nullptr;
+	Statistics stats;
+	Slot<ID3D11VertexShader*> vertexShader;
+	Slot<ID3D11PixelShader*> pixelShader;
+	Slot<ID3D11InputLayout*> inputLayout;
+	Slot<D3D11_PRIMITIVE_TOPOLOGY> topology;
+	Slot<IndexBufferState> indexBuffer;
+	std::array<Slot<VertexBufferState>, D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT> vertexBuffers;
+	std::array<Slot<ID3D11Buffer*>, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT> vsConstantBuffers;
+	std::array<Slot<ID3D11Buffer*>, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT> psConstantBuffers;
+	std::array<Slot<ID3D11ShaderResourceView*>, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT> vsShaderResources;
+	std::array<Slot<ID3D11ShaderResourceView*>, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT> psShaderResources;
+	std::array<Slot<ID3D11SamplerState*>, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT> psSamplers;
+	Slot<ID3D11BlendState*> blendState;
+	Slot<DepthStencilState> depthStencilState;
+	Slot<ID3D11RasterizerState*> rasterizerState;
+};
\ No newline at end of file
@@ -0,0 +1,230 @@
+#pragma once
+#include "DynamicConstant.h"
+#include "LayoutCodex.h"
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <type_traits>
+
+namespace Dcb
+{
+	// string literal that can be passed as a template argument - used to name static layout fields
+	template<size_t N>
+	struct FieldName
+	{
+		constexpr FieldName( const char( &str )[N] ) noexcept
+		{
+			std::copy_n( str, N, chars );
+		}
+		constexpr std::string_view View() const noexcept
+		{
+			return { chars, N - 1u };
+		}
+		char chars[N] = {};
+	};
+
+	// leaf member of a static layout
+	template<Type type_in, FieldName name_in>
+	struct Field
+	{
+		static_assert( Map<type_in>::valid, "Static layout fields must be leaf types!" );
+		static constexpr Type type = type_in;
+		static constexpr std::string_view name = name_in.View();
+		// zero marks a non-array field
+		static constexpr size_t count = 0u;
+	};
+
+	// array of leaf elements in a static layout
+	template<Type type_in, size_t count_in, FieldName name_in>
+	struct ArrayField
+	{
+		static_assert( Map<type_in>::valid, "Static layout arrays must have leaf element types!" );
+		static_assert( count_in != 0u, "Static layout arrays must have at least one element!" );
+		static constexpr Type type = type_in;
+		static constexpr std::string_view name = name_in.View();
+		static constexpr size_t count = count_in;
+	};
+
+	// compile time application of the LayoutElement packing rules
+	struct StaticPacking
+	{
+		// offset a field is placed at when the previous field ended at offsetIn
+		template<class F>
+		static constexpr size_t Place( size_t offsetIn ) noexcept
+		{
+			if constexpr ( F::count == 0u )
+				return LayoutElement::AdvanceIfCrossesBoundary( offsetIn, Map<F::type>::hlslSize );
+			else
+				return LayoutElement::AdvanceToBoundary( offsetIn );
+		}
+		// distance between array elements
+		template<class F>
+		static constexpr size_t Stride() noexcept
+		{
+			return LayoutElement::AdvanceToBoundary( Map<F::type>::hlslSize );
+		}
+		// bytes occupied by a field starting from its placed offset
+		template<class F>
+		static constexpr size_t Extent() noexcept
+		{
+			if constexpr ( F::count == 0u )
+				return Map<F::type>::hlslSize;
+			else
+				return Stride<F>() * F::count;
+		}
+		template<class...Fields>
+		static constexpr std::array<size_t, sizeof...( Fields )> Offsets() noexcept
+		{
+			std::array<size_t, sizeof...( Fields )> offsets{};
+			size_t offset = 0u;
+			size_t i = 0u;
+			( ( offsets[i] = Place<Fields>( offset ), offset = offsets[i] + Extent<Fields>(), i++ ), ... );
+			return offsets;
+		}
+		template<class...Fields>
+		static constexpr size_t Size() noexcept
+		{
+			size_t offset = 0u;
+			( ( offset = Place<Fields>( offset ) + Extent<Fields>() ), ... );
+			// root struct is padded out to a whole register
+			return LayoutElement::AdvanceToBoundary( offset );
+		}
+		// writes the same signature that LayoutElement::GetSignature produces and returns its length
+		// pass nullptr to only measure the length
+		template<class...Fields>
+		static constexpr size_t WriteSignature( char* out ) noexcept
+		{
+			size_t n = 0u;
+			const auto put = [&]( std::string_view str )
+			{
+				for ( const auto c : str )
+				{
+					if ( out != nullptr )
+						out[n] = c;
+					n++;
+				}
+			};
+			put( "St{" );
+			( WriteFieldSignature<Fields>( put ), ... );
+			put( "}" );
+			return n;
+		}
+		template<class F, typename P>
+		static constexpr void WriteFieldSignature( P& put ) noexcept
+		{
+			put( F::name );
+			put( ":" );
+			if constexpr ( F::count == 0u )
+			{
+				put( Map<F::type>::code );
+			}
+			else
+			{
+				// decimal digits of the element count
+				char digits[20] = {};
+				size_t nDigits = 0u;
+				for ( auto c = F::count; c != 0u; c /= 10u )
+					digits[nDigits++] = char( '0' + c % 10u );
+				std::reverse( digits, digits + nDigits );
+
+				put( "Ar:" );
+				put( std::string_view{ digits, nDigits } );
+				put( "{" );
+				put( Map<F::type>::code );
+				put( "}" );
+			}
+			put( ";" );
+		}
+	};
+
+	// layout whose packing is computed entirely at compile time
+	// registers with LayoutCodex under the same signature as the equivalent RawLayout, so buffers
+	// built from static and dynamic descriptions of a layout share one CompleteLayout
+	// e.g. using Kernel = StaticLayout<Field<Integer, "nTaps">, ArrayField<Float, 15, "coefficients">>;
+	template<typename...Fields>
+	class StaticLayout
+	{
+	public:
+		static constexpr size_t nFields = sizeof...( Fields );
+		static constexpr std::array<std::string_view, nFields> names = { Fields::name... };
+		static constexpr std::array<Type, nFields> types = { Fields::type... };
+		static constexpr std::array<size_t, nFields> offsets = StaticPacking::Offsets<Fields...>();
+		static constexpr size_t sizeInBytes = StaticPacking::Size<Fields...>();
+		static constexpr size_t signatureLength = StaticPacking::WriteSignature<Fields...>( nullptr );
+	private:
+		static constexpr std::array<char, signatureLength> MakeSignature() noexcept
+		{
+			std::array<char, signatureLength> sig{};
+			StaticPacking::WriteSignature<Fields...>( sig.data() );
+			return sig;
+		}
+		static constexpr std::array<char, signatureLength> signatureChars = MakeSignature();
+		static constexpr std::array<bool, nFields> arrays = { ( Fields::count != 0u )... };
+		static constexpr std::array<size_t, nFields> counts = { Fields::count... };
+		static constexpr std::array<size_t, nFields> strides = { StaticPacking::Stride<Fields>()... };
+	public:
+		static constexpr std::string_view signature{ signatureChars.data(), signatureLength };
+
+		template<FieldName name>
+		static constexpr size_t IndexOf() noexcept
+		{
+			constexpr auto i = size_t( std::find( names.begin(), names.end(), name.View() ) - names.begin() );
+			static_assert( i < nFields, "Field name not found in static layout!" );
+			return i;
+		}
+		template<FieldName name>
+		using TypeOf = typename Map<types[IndexOf<name>()]>::DynamicType;
+
+		// layout registered with the codex - resolved once per layout type
+		static const CompleteLayout& Get() noexcept(!IS_DEBUG)
+		{
+			static const CompleteLayout layout = Register();
+			return layout;
+		}
+		// handle with the offset baked in - no lookup at all when resolving
+		template<FieldName name>
+		static FieldHandle<TypeOf<name>> Handle() noexcept(!IS_DEBUG)
+		{
+			constexpr auto i = IndexOf<name>();
+			if constexpr ( arrays[i] )
+			{
+				return { *Get().ShareRoot(), offsets[i], strides[i], counts[i] };
+			}
+			else
+			{
+				return { *Get().ShareRoot(), offsets[i], 0u, 0u };
+			}
+		}
+	private:
+		static CompleteLayout Register() noexcept(!IS_DEBUG)
+		{
+			RawLayout raw;
+			( AddField<Fields>( raw ), ... );
+			auto layout = LayoutCodex::Resolve( std::move( raw ) );
+
+			// the compile time packing must agree with the runtime finalization
+			assert( layout.GetSignature() == signature );
+			assert( layout.GetSizeInBytes() == sizeInBytes );
+#ifndef NDEBUG
+			for ( size_t i = 0; i < nFields; i++ )
+			{
+				assert( layout[std::string{ names[i] }].GetOffsetBegin() == offsets[i] );
+			}
+#endif
+			return layout;
+		}
+		template<class F>
+		static void AddField( RawLayout& raw ) noexcept(!IS_DEBUG)
+		{
+			if constexpr ( F::count == 0u )
+			{
+				raw.Add<F::type>( std::string{ F::name } );
+			}
+			else
+			{
+				raw.Add<Array>( std::string{ F::name } );
+				raw[std::string{ F::name }].Set<F::type>( F::count );
+			}
+		}
+	};
+}
\ No newline at end of file
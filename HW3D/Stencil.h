@@ -60,38 +60,19 @@ namespace Bind
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override
 		{
 			INFOMANAGER_NOHR( gfx );
-			GFX_THROW_INFO_ONLY( GetContext( gfx )->OMSetDepthStencilState( pStencil.Get(), 0xFF ) );
+			GFX_THROW_INFO_ONLY( GetStateCache( gfx ).OMSetDepthStencilState( pStencil.Get(), 0xFF ) );
 		}
 		static std::shared_ptr<Stencil> Resolve( Graphics& gfx, Mode mode )
 		{
 			return Codex::Resolve<Stencil>( gfx, mode );
 		}
-		static std::string GenerateUID( Mode mode )
+		static BindKey GenerateKey( Mode mode )
 		{
-			using namespace std::string_literals;
-			const auto modeName = [mode]() {
-				switch ( mode )
-				{
-				case Mode::Off:
-					return "off"s;
-				case Mode::Mask:
-					return "mask"s;
-				case Mode::Write:
-					return "write"s;
-				case Mode::DepthOff:
-					return "depth-off"s;
-				case Mode::DepthSkyBox:
-					return "depth-skybox"s;
-				case Mode::DepthReversed:
-					return "depth-reversed"s;
-				}
-				return "ERROR"s;
-			};
-			return typeid( Stencil ).name() + "#"s + modeName();
+			return BindKey::Make<Stencil>( mode );
 		}
-		std::string GetUID() const noexcept override
+		BindKey GetKey() const noexcept(!IS_DEBUG) override
 		{
-			return GenerateUID( mode );
+			return GenerateKey( mode );
 		}
 	private:
 		Mode mode;
@@ -3,6 +3,8 @@
 #include "RenderGraph.h"
 #include "TechniqueProbe.h"
 #include "RenderQueuePass.h"
+#include "ParallelSubmitter.h"
+#include "BindableCommon.h"
 
 Step::Step( std::string targetPassName ) :
 	targetPassName{ std::move( targetPassName ) }
@@ -21,9 +23,12 @@ Step::Step( const Step& src ) noexcept :
 	}
 }
 
-void Step::Submit( const Drawable& drawable ) const
+void Step::Submit( const Drawable& drawable, const DirectX::XMFLOAT4X4* pTransform ) const
 {
-	pTargetPass->Accept( Rgph::Job{ this, &drawable } );
+	const Rgph::Job job{ this, &drawable, pTransform };
+	// parallel traversals collect their jobs and hand them over in order later
+	if ( !Rgph::ParallelSubmitter::Collect( *pTargetPass, job ) )
+		pTargetPass->Accept( job );
 }
 
 void Step::InitializeParentReferences( const Drawable& parent ) noexcept
@@ -56,4 +61,38 @@ void Step::Link( Rgph::RenderGraph& rg )
 {
 	assert( pTargetPass == nullptr );
 	pTargetPass = &rg.GetRenderQueue( targetPassName );
+
+	// per-object bindables (transforms, material constants) are left out so that meshes sharing state group together
+	// hashed by codex key rather than address, so jobs sort the same way on every run
+	uint64_t shaderHash = 0u;
+	uint64_t materialHash = 0u;
+	const auto mix = []( uint64_t hash, const Bind::Bindable& b ) {
+		return ( hash ^ b.GetKey().GetHash() ) * 0x100000001b3ull;
+	};
+	for ( const auto& b : bindables )
+	{
+		const auto p = b.get();
+		if ( dynamic_cast<Bind::VertexShader*>( p ) || dynamic_cast<Bind::PixelShader*>( p ) || dynamic_cast<Bind::InputLayout*>( p ) )
+			shaderHash = mix( shaderHash, *p );
+		else if ( dynamic_cast<Bind::Texture*>( p ) || dynamic_cast<Bind::Sampler*>( p ) ||
+			dynamic_cast<Bind::Rasterizer*>( p ) || dynamic_cast<Bind::Blender*>( p ) )
+			materialHash = mix( materialHash, *p );
+	}
+	shaderKey = uint16_t( shaderHash ^ ( shaderHash >> 16 ) ^ ( shaderHash >> 32 ) ^ ( shaderHash >> 48 ) );
+	materialKey = uint32_t( ( materialHash ^ ( materialHash >> 24 ) ^ ( materialHash >> 48 ) ) & 0xFFFFFFu );
+}
+
+const std::vector<std::shared_ptr<Bind::Bindable>>& Step::GetBindables() const noexcept
+{
+	return bindables;
+}
+
+uint16_t Step::GetShaderKey() const noexcept
+{
+	return shaderKey;
+}
+
+uint32_t Step::GetMaterialKey() const noexcept
+{
+	return materialKey;
 }
\ No newline at end of file
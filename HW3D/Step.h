@@ -22,13 +22,20 @@ public:
 	Step& operator=( const Step& ) = delete;
 	Step& operator=( Step&& ) = delete;
 	void AddBindable( std::shared_ptr<Bind::Bindable> bind_in ) noexcept;
-	void Submit( const class Drawable& drawable ) const;
+	void Submit( const class Drawable& drawable, const DirectX::XMFLOAT4X4* pTransform = nullptr ) const;
 	void Bind( Graphics& gfx ) const noexcept(!IS_DEBUG);
 	void InitializeParentReferences( const class Drawable& parent ) noexcept;
 	void Accept( TechniqueProbe& probe );
 	void Link( Rgph::RenderGraph& rg );
+	const std::vector<std::shared_ptr<Bind::Bindable>>& GetBindables() const noexcept;
+	// 16-bit hash of the shaders and input layout and 24-bit hash of the textures and fixed function state
+	// computed on link - used to group jobs that share pipeline state
+	uint16_t GetShaderKey() const noexcept;
+	uint32_t GetMaterialKey() const noexcept;
 private:
 	std::string targetPassName;
 	Rgph::RenderQueuePass* pTargetPass = nullptr;
 	std::vector<std::shared_ptr<Bind::Bindable>> bindables;
+	uint16_t shaderKey = 0u;
+	uint32_t materialKey = 0u;
 };
\ No newline at end of file
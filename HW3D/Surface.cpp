@@ -1,10 +1,33 @@
 #include "Surface.h"
 #include "Window.h"
 #include "StringConverter.h"
+#include "Profiler.h"
 #include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <filesystem>
+#include <objbase.h>
+
+namespace
+{
+	// wic decoding needs com on the calling thread, and models decode their images on pool workers
+	class ComScope
+	{
+	public:
+		ComScope() noexcept
+			:
+			hr( CoInitializeEx( nullptr, COINIT_MULTITHREADED ) )
+		{}
+		~ComScope()
+		{
+			// a thread already initialized in another apartment keeps it
+			if ( SUCCEEDED( hr ) )
+				CoUninitialize();
+		}
+	private:
+		HRESULT hr;
+	};
+}
 
 Surface::Surface( unsigned int width, unsigned int height )
 {
@@ -77,6 +100,8 @@ const Surface::Color* Surface::GetBufferPtrConst() const noexcept
 
 Surface Surface::FromFile( const std::string& name )
 {
+	PROFILE_SCOPE( "Surface::FromFile" );
+	thread_local const ComScope com;
 	DirectX::ScratchImage scratch;
 	HRESULT hr = DirectX::LoadFromWICFile( ToWide( name ).c_str(), DirectX::WIC_FLAGS_IGNORE_SRGB, nullptr, scratch );
 
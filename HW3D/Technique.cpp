@@ -10,12 +10,12 @@ Technique::Technique( std::string name, size_t channels, bool startActive ) noex
 	name( name ), channels( channels ), active( startActive )
 { }
 
-void Technique::Submit( const Drawable& drawable, size_t channelFilter ) const noexcept
+void Technique::Submit( const Drawable& drawable, size_t channelFilter, const DirectX::XMFLOAT4X4* pTransform ) const noexcept
 {
 	if ( active && ( ( channels & channelFilter ) != 0 ) )
 	{
 		for ( const auto& step : steps )
-			step.Submit( drawable );
+			step.Submit( drawable, pTransform );
 	}
 }
 
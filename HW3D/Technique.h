@@ -15,7 +15,7 @@ class Technique
 public:
 	Technique( size_t channels );
 	Technique( std::string name, size_t channels, bool startActive = true ) noexcept;
-	void Submit( const Drawable& drawable, size_t channelFilter ) const noexcept;
+	void Submit( const Drawable& drawable, size_t channelFilter, const DirectX::XMFLOAT4X4* pTransform = nullptr ) const noexcept;
 	void AddStep( Step step ) noexcept;
 	bool IsActive() const noexcept;
 	void SetActiveState( bool active_in ) noexcept;
@@ -2,16 +2,29 @@
 #include "Surface.h"
 #include "BindableCodex.h"
 #include "GraphicsThrowMacros.h"
+#include "Profiler.h"
 
 namespace Bind
 {
 	Texture::Texture( Graphics& gfx, const std::string& path, UINT slot ) : slot( slot ), path( path )
+	{
+		PROFILE_SCOPE( "Texture::Texture" );
+		Create( gfx, Surface::FromFile( path ) );
+	}
+
+	Texture::Texture( Graphics& gfx, const std::string& path, UINT slot, const Surface& surface ) : slot( slot ), path( path )
+	{
+		PROFILE_SCOPE( "Texture::Texture" );
+		Create( gfx, surface );
+	}
+
+	void Texture::Create( Graphics& gfx, const Surface& s )
 	{
 		INFOMANAGER( gfx );
 
-		// load surface
-		const auto s = Surface::FromFile( path );
 		hasAlpha = s.AlphaLoaded();
+		// full mip chain adds roughly a third on top of the top level
+		sizeInBytes = size_t( s.GetWidth() ) * s.GetHeight() * sizeof( Surface::Color ) * 4u / 3u;
 
 		// create texture resource
 		D3D11_TEXTURE2D_DESC textureDesc = { 0 };
@@ -50,7 +63,7 @@ namespace Bind
 	void Texture::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER_NOHR( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->PSSetShaderResources( slot, 1u, pTextureView.GetAddressOf() ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).PSSetShaderResource( slot, pTextureView.Get() ) );
 	}
 
 	std::shared_ptr<Texture> Texture::Resolve( Graphics& gfx, const std::string& path, UINT slot )
@@ -58,19 +71,34 @@ namespace Bind
 		return Codex::Resolve<Texture>( gfx, path, slot );
 	}
 
-	std::string Texture::GenerateUID( const std::string& path, UINT slot )
+	std::shared_ptr<Texture> Texture::Resolve( Graphics& gfx, const std::string& path, UINT slot, const Surface& surface )
 	{
-		using namespace std::string_literals;
-		return typeid( Texture ).name() + "#"s + path + "#" + std::to_string( slot );
+		return Codex::Resolve<Texture>( gfx, path, slot, surface );
 	}
 
-	std::string Texture::GetUID() const noexcept
+	BindKey Texture::GenerateKey( const std::string& path, UINT slot )
 	{
-		return GenerateUID( path, slot );
+		return BindKey::Make<Texture>( path, slot );
+	}
+
+	BindKey Texture::GenerateKey( const std::string& path, UINT slot, const Surface& )
+	{
+		// same texture as one decoded by the texture itself
+		return GenerateKey( path, slot );
+	}
+
+	BindKey Texture::GetKey() const noexcept(!IS_DEBUG)
+	{
+		return GenerateKey( path, slot );
 	}
 
 	bool Texture::HasAlpha() const noexcept
 	{
 		return hasAlpha;
 	}
+
+	size_t Texture::GetSizeInBytes() const noexcept
+	{
+		return sizeInBytes;
+	}
 }
\ No newline at end of file
@@ -8,15 +8,23 @@ namespace Bind
 	{
 	public:
 		Texture( Graphics& gfx, const std::string& path, UINT slot = 0 );
+		// from an image already decoded from path - decoding is the slow part and can happen on any thread
+		Texture( Graphics& gfx, const std::string& path, UINT slot, const Surface& surface );
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		static std::shared_ptr<Texture> Resolve( Graphics& gfx, const std::string& path, UINT slot = 0 );
-		static std::string GenerateUID( const std::string& path, UINT slot = 0 );
-		std::string GetUID() const noexcept override;
+		static std::shared_ptr<Texture> Resolve( Graphics& gfx, const std::string& path, UINT slot, const Surface& surface );
+		static BindKey GenerateKey( const std::string& path, UINT slot = 0 );
+		static BindKey GenerateKey( const std::string& path, UINT slot, const Surface& surface );
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
 		bool HasAlpha() const noexcept;
+		size_t GetSizeInBytes() const noexcept override;
+	private:
+		void Create( Graphics& gfx, const Surface& s );
 	private:
 		unsigned int slot;
 	protected:
 		bool hasAlpha = false;
+		size_t sizeInBytes = 0u;
 		std::string path;
 		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pTextureView;
 	};
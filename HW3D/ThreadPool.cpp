@@ -0,0 +1,166 @@
+#include "ThreadPool.h"
+#include <cassert>
+#include <iterator>
+
+namespace
+{
+	// lets Run() and TryTake() find the deque of the worker they are called from
+	thread_local const ThreadPool* pWorkerPool = nullptr;
+	thread_local size_t workerIndex = 0u;
+}
+
+ThreadPool::ThreadPool( size_t nWorkers )
+{
+	nWorkers = std::max( nWorkers, size_t( 1u ) );
+	for ( size_t i = 0; i < nWorkers; i++ )
+	{
+		queues.push_back( std::make_unique<Queue>() );
+	}
+	for ( size_t i = 0; i < nWorkers; i++ )
+	{
+		workers.emplace_back( &ThreadPool::WorkerLoop, this, i );
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock( sleepMutex );
+		stopping = true;
+	}
+	wake.notify_all();
+	for ( auto& w : workers )
+	{
+		w.join();
+	}
+}
+
+void ThreadPool::Run( TaskGroup& group, std::function<void()> task )
+{
+	group.pending++;
+	const auto index = pWorkerPool == this ? workerIndex : nextQueue++ % queues.size();
+	{
+		std::lock_guard lock( queues[index]->mutex );
+		queues[index]->tasks.push_back( { std::move( task ), &group } );
+	}
+	queued++;
+	// taking the lock orders this with a worker that is about to sleep, so the wake up cannot be missed
+	{
+		std::lock_guard lock( sleepMutex );
+	}
+	wake.notify_one();
+}
+
+void ThreadPool::Wait( TaskGroup& group )
+{
+	const auto index = pWorkerPool == this ? workerIndex : queues.size();
+	while ( group.pending > 0u )
+	{
+		Task task;
+		if ( TryTake( index, task, &group ) )
+		{
+			Execute( task );
+		}
+		else
+		{
+			// everything left of the group is already running on the workers
+			std::unique_lock lock( group.mutex );
+			group.done.wait( lock, [&group] { return group.pending == 0u; } );
+		}
+	}
+
+	std::exception_ptr pError;
+	{
+		std::lock_guard lock( group.mutex );
+		std::swap( pError, group.pError );
+	}
+	if ( pError )
+	{
+		std::rethrow_exception( pError );
+	}
+}
+
+size_t ThreadPool::GetWorkerCount() const noexcept
+{
+	return workers.size();
+}
+
+void ThreadPool::WorkerLoop( size_t index )
+{
+	pWorkerPool = this;
+	workerIndex = index;
+	while ( true )
+	{
+		Task task;
+		if ( TryTake( index, task ) )
+		{
+			Execute( task );
+			continue;
+		}
+		std::unique_lock lock( sleepMutex );
+		wake.wait( lock, [this] { return stopping || queued > 0u; } );
+		if ( stopping && queued == 0u )
+		{
+			return;
+		}
+	}
+}
+
+bool ThreadPool::TryTake( size_t index, Task& task, const TaskGroup* pGroup )
+{
+	if ( queued == 0u )
+	{
+		return false;
+	}
+	const auto matches = [pGroup]( const Task& t ) { return !pGroup || t.pGroup == pGroup; };
+	if ( index < queues.size() )
+	{
+		auto& own = *queues[index];
+		std::lock_guard lock( own.mutex );
+		const auto it = std::find_if( own.tasks.rbegin(), own.tasks.rend(), matches );
+		if ( it != own.tasks.rend() )
+		{
+			task = std::move( *it );
+			own.tasks.erase( std::next( it ).base() );
+			queued--;
+			return true;
+		}
+	}
+	for ( size_t i = 1; i <= queues.size(); i++ )
+	{
+		auto& victim = *queues[( index + i ) % queues.size()];
+		std::lock_guard lock( victim.mutex );
+		const auto it = std::find_if( victim.tasks.begin(), victim.tasks.end(), matches );
+		if ( it != victim.tasks.end() )
+		{
+			task = std::move( *it );
+			victim.tasks.erase( it );
+			queued--;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::Execute( Task& task ) noexcept
+{
+	auto& group = *task.pGroup;
+	try
+	{
+		task.function();
+	}
+	catch ( ... )
+	{
+		std::lock_guard lock( group.mutex );
+		if ( !group.pError )
+		{
+			group.pError = std::current_exception();
+		}
+	}
+	// the waiter may destroy the group as soon as pending reaches zero, so signal under its lock
+	std::lock_guard lock( group.mutex );
+	if ( --group.pending == 0u )
+	{
+		group.done.notify_all();
+	}
+}
\ No newline at end of file
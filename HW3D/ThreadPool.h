@@ -0,0 +1,74 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fixed set of worker threads with one task deque each
+// workers take from the back of their own deque and steal from the front of the others when it runs dry
+class ThreadPool
+{
+public:
+	// tasks that are waited on together - Wait() rethrows the first exception thrown by any of them
+	class TaskGroup
+	{
+		friend ThreadPool;
+	public:
+		TaskGroup() = default;
+		TaskGroup( const TaskGroup& ) = delete;
+		TaskGroup& operator=( const TaskGroup& ) = delete;
+		// every task has finished - Wait() still has to be called to rethrow errors and before the group is destroyed
+		bool IsDone() const noexcept
+		{
+			return pending == 0u;
+		}
+	private:
+		std::atomic<size_t> pending = 0u;
+		std::mutex mutex;
+		std::condition_variable done;
+		std::exception_ptr pError;
+	};
+public:
+	// one thread is left for the caller, which helps out while it waits
+	ThreadPool( size_t nWorkers = std::max( std::thread::hardware_concurrency(), 2u ) - 1u );
+	ThreadPool( const ThreadPool& ) = delete;
+	ThreadPool& operator=( const ThreadPool& ) = delete;
+	~ThreadPool();
+	// tasks run from a worker go to that worker's own deque, others are spread round robin
+	void Run( TaskGroup& group, std::function<void()> task );
+	// runs queued tasks of the group on the calling thread until every task of the group has finished
+	// tasks of other groups are left to the workers, so a wait never picks up unrelated work
+	void Wait( TaskGroup& group );
+	size_t GetWorkerCount() const noexcept;
+private:
+	struct Task
+	{
+		std::function<void()> function;
+		TaskGroup* pGroup = nullptr;
+	};
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+	void WorkerLoop( size_t index );
+	// own deque first (if any) then steal - index is the caller's queue or queues.size() for outside threads
+	// only tasks of the given group are taken when there is one
+	bool TryTake( size_t index, Task& task, const TaskGroup* pGroup = nullptr );
+	void Execute( Task& task ) noexcept;
+private:
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> workers;
+	// tasks pushed but not yet taken - workers sleep while it is zero
+	std::atomic<size_t> queued = 0u;
+	std::atomic<size_t> nextQueue = 0u;
+	std::mutex sleepMutex;
+	std::condition_variable wake;
+	bool stopping = false;
+};
\ No newline at end of file
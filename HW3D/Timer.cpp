@@ -16,4 +16,9 @@ float Timer::Mark()
 float Timer::Peek() const
 {
 	return std::chrono::duration<float>( std::chrono::steady_clock::now() - last ).count();
+}
+
+uint64_t Timer::Now() noexcept
+{
+	return uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
 
 class Timer
 {
@@ -7,6 +8,8 @@ public:
 	Timer();
 	float Mark();
 	float Peek() const;
+	// nanoseconds on the steady clock the timers run on - timestamps of the profiler
+	static uint64_t Now() noexcept;
 private:
 	std::chrono::steady_clock::time_point last;
 };
\ No newline at end of file
@@ -10,7 +10,7 @@ namespace Bind
 	{
 		INFOMANAGER( gfx );
 
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->IASetPrimitiveTopology( type ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).IASetPrimitiveTopology( type ) );
 	}
 
 	std::shared_ptr<Topology> Topology::Resolve( Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY type )
@@ -18,14 +18,13 @@ namespace Bind
 		return Codex::Resolve<Topology>( gfx, type );
 	}
 
-	std::string Topology::GenerateUID( D3D11_PRIMITIVE_TOPOLOGY type )
+	BindKey Topology::GenerateKey( D3D11_PRIMITIVE_TOPOLOGY type )
 	{
-		using namespace std::string_literals;
-		return typeid( Topology ).name() + "#"s + std::to_string( type );
+		return BindKey::Make<Topology>( type );
 	}
 
-	std::string Topology::GetUID() const noexcept
+	BindKey Topology::GetKey() const noexcept(!IS_DEBUG)
 	{
-		return GenerateUID( type );
+		return GenerateKey( type );
 	}
 }
\ No newline at end of file
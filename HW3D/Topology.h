@@ -9,8 +9,8 @@ namespace Bind
 		Topology( Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY type );
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		static std::shared_ptr<Topology> Resolve( Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY type = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
-		static std::string GenerateUID( D3D11_PRIMITIVE_TOPOLOGY type );
-		std::string GetUID() const noexcept override;
+		static BindKey GenerateKey( D3D11_PRIMITIVE_TOPOLOGY type );
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
 	protected:
 		D3D11_PRIMITIVE_TOPOLOGY type;
 	};
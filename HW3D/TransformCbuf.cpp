@@ -1,4 +1,5 @@
 #include "TransformCbuf.h"
+#include "Job.h"
 
 namespace Bind
 {
@@ -33,7 +34,15 @@ namespace Bind
 	TransformCbuf::Transforms TransformCbuf::GetTransforms( Graphics& gfx ) noexcept
 	{
 		assert( pParent != nullptr );
-		const auto model = pParent->GetTransformXM();
+		// the executing job carries the world matrix when its drawable is shared by several nodes
+		const auto pJob = Rgph::Job::GetExecuting();
+		if ( pJob && &pJob->GetDrawable() == pParent )
+			return GetTransforms( gfx, pJob->GetTransformXM() );
+		return GetTransforms( gfx, pParent->GetTransformXM() );
+	}
+
+	TransformCbuf::Transforms TransformCbuf::GetTransforms( Graphics& gfx, DirectX::FXMMATRIX model ) noexcept
+	{
 		const auto modelView = model * gfx.GetCamera();
 		return
 		{
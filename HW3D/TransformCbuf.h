@@ -11,13 +11,15 @@ namespace Bind
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		void InitializeParentReference( const Drawable& parent ) noexcept override;
 		std::unique_ptr<CloningBindable> Clone() const noexcept override;
-	protected:
 		struct Transforms
 		{
 			DirectX::XMMATRIX model;
 			DirectX::XMMATRIX modelView;
 			DirectX::XMMATRIX modelViewProj;
 		};
+		// transposed for hlsl - shared with the instance buffers of instanced draws
+		static Transforms GetTransforms( Graphics& gfx, DirectX::FXMMATRIX model ) noexcept;
+	protected:
 		void UpdateBind( Graphics& gfx, const Transforms& tf ) noexcept;
 		Transforms GetTransforms( Graphics& gfx ) noexcept;
 	private:
@@ -4,9 +4,9 @@
 namespace Bind
 {
 	TransformCbufScaling::TransformCbufScaling( Graphics& gfx, float scale ) :
-		TransformCbuf( gfx ), buffer( MakeLayout() )
+		TransformCbuf( gfx ), buffer( Layout::Get() ), scaleHandle( Layout::Handle<"scale">() )
 	{
-		buffer["scale"] = scale;
+		buffer[scaleHandle] = scale;
 	}
 
 	void TransformCbufScaling::Accept( TechniqueProbe& probe )
@@ -16,7 +16,7 @@ namespace Bind
 
 	void TransformCbufScaling::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
-		const float scale = buffer["scale"];
+		const float scale = buffer[scaleHandle];
 		const auto scaleMatrix = DirectX::XMMatrixScaling( scale,scale,scale );
 		auto xf = GetTransforms( gfx );
 		xf.modelView = xf.modelView * scaleMatrix;
@@ -28,11 +28,4 @@ namespace Bind
 	{
 		return std::make_unique<TransformCbufScaling>( *this );
 	}
-
-	Dcb::RawLayout TransformCbufScaling::MakeLayout()
-	{
-		Dcb::RawLayout layout;
-		layout.Add<Dcb::Float>( "scale" );
-		return layout;
-	}
 }
\ No newline at end of file
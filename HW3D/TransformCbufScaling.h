@@ -1,6 +1,6 @@
 #pragma once
 #include "TransformCbuf.h"
-#include "DynamicConstant.h"
+#include "StaticLayout.h"
 
 namespace Bind
 {
@@ -12,7 +12,8 @@ namespace Bind
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		std::unique_ptr<CloningBindable> Clone() const noexcept override;
 	private:
+		using Layout = Dcb::StaticLayout<Dcb::Field<Dcb::Float, "scale">>;
 		Dcb::Buffer buffer;
-		static Dcb::RawLayout MakeLayout();
+		Dcb::FieldHandle<float> scaleHandle;
 	};
 }
\ No newline at end of file
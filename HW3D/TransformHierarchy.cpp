@@ -0,0 +1,102 @@
+#include "TransformHierarchy.h"
+#include <algorithm>
+#include <cassert>
+
+namespace dx = DirectX;
+
+size_t TransformHierarchy::Add( int parent, dx::FXMMATRIX base )
+{
+	const auto index = parents.size();
+	assert( parent < int( index ) );
+	parents.push_back( parent );
+	subtreeEnds.push_back( index + 1u );
+	// the new node extends the subtree of each of its ancestors
+	for ( auto p = parent; p >= 0; p = parents[p] )
+	{
+		subtreeEnds[p] = index + 1u;
+	}
+	bases.emplace_back();
+	dx::XMStoreFloat4x4( &bases.back(), base );
+	applieds.emplace_back();
+	dx::XMStoreFloat4x4( &applieds.back(), dx::XMMatrixIdentity() );
+	locals.push_back( bases.back() );
+	worlds.emplace_back();
+	dirty.push_back( 1u );
+	anyDirty = true;
+	stats.nodes = parents.size();
+	return index;
+}
+
+void TransformHierarchy::SetApplied( size_t index, dx::FXMMATRIX applied ) noexcept
+{
+	dx::XMStoreFloat4x4( &applieds[index], applied );
+	dx::XMStoreFloat4x4( &locals[index], dx::XMLoadFloat4x4( &bases[index] ) * applied );
+	dirty[index] = 1u;
+	anyDirty = true;
+}
+
+const dx::XMFLOAT4X4& TransformHierarchy::GetApplied( size_t index ) const noexcept
+{
+	return applieds[index];
+}
+
+const dx::XMFLOAT4X4& TransformHierarchy::GetWorld( size_t index ) const noexcept
+{
+	return worlds[index];
+}
+
+int TransformHierarchy::GetParent( size_t index ) const noexcept
+{
+	return parents[index];
+}
+
+const dx::XMFLOAT4X4& TransformHierarchy::GetBase( size_t index ) const noexcept
+{
+	return bases[index];
+}
+
+size_t TransformHierarchy::GetCount() const noexcept
+{
+	return parents.size();
+}
+
+void TransformHierarchy::Update() noexcept
+{
+	stats.updated = 0u;
+	if ( !anyDirty )
+	{
+		return;
+	}
+	const auto count = parents.size();
+	for ( size_t i = 0; i < count; )
+	{
+		if ( !dirty[i] )
+		{
+			i++;
+			continue;
+		}
+		// every node of a flagged subtree follows its parent, whose world matrix is already current
+		const auto end = subtreeEnds[i];
+		for ( auto j = i; j < end; j++ )
+		{
+			const auto local = dx::XMLoadFloat4x4( &locals[j] );
+			const auto parent = parents[j];
+			dx::XMStoreFloat4x4( &worlds[j], parent < 0 ? local : local * dx::XMLoadFloat4x4( &worlds[parent] ) );
+			dirty[j] = 0u;
+		}
+		stats.updated += end - i;
+		i = end;
+	}
+	anyDirty = false;
+}
+
+void TransformHierarchy::Invalidate() noexcept
+{
+	std::fill( dirty.begin(), dirty.end(), uint8_t( 1u ) );
+	anyDirty = true;
+}
+
+const TransformHierarchy::Statistics& TransformHierarchy::GetStatistics() const noexcept
+{
+	return stats;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+// node transforms of a model flattened into arrays, with every parent stored before its children
+// so that each subtree is a contiguous range of indices
+// changing a node's applied transform only flags it - Update() recomputes the world matrices of flagged
+// subtrees in a single forward pass and leaves everything else untouched
+class TransformHierarchy
+{
+public:
+	struct Statistics
+	{
+		// world matrices recomputed by the last update
+		size_t updated = 0u;
+		size_t nodes = 0u;
+	};
+public:
+	// nodes have to be added in depth first order, each after its parent - returns the new node's index
+	size_t Add( int parent, DirectX::FXMMATRIX base );
+	void SetApplied( size_t index, DirectX::FXMMATRIX applied ) noexcept;
+	const DirectX::XMFLOAT4X4& GetApplied( size_t index ) const noexcept;
+	// valid as of the last Update()
+	const DirectX::XMFLOAT4X4& GetWorld( size_t index ) const noexcept;
+	int GetParent( size_t index ) const noexcept;
+	const DirectX::XMFLOAT4X4& GetBase( size_t index ) const noexcept;
+	size_t GetCount() const noexcept;
+	void Update() noexcept;
+	// flags every node, so the next update recomputes the whole hierarchy
+	void Invalidate() noexcept;
+	const Statistics& GetStatistics() const noexcept;
+private:
+	std::vector<int> parents;
+	// one past the last index of the subtree rooted at each node
+	std::vector<size_t> subtreeEnds;
+	std::vector<DirectX::XMFLOAT4X4> bases;
+	std::vector<DirectX::XMFLOAT4X4> applieds;
+	// applied * base, cached so a subtree update is one multiply per node
+	std::vector<DirectX::XMFLOAT4X4> locals;
+	std::vector<DirectX::XMFLOAT4X4> worlds;
+	std::vector<uint8_t> dirty;
+	bool anyDirty = false;
+	Statistics stats;
+};
\ No newline at end of file
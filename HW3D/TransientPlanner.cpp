@@ -0,0 +1,53 @@
+#include "TransientPlanner.h"
+#include <algorithm>
+#include <numeric>
+#include <cassert>
+
+namespace Rgph
+{
+	TransientPlanner::Plan TransientPlanner::Build( const std::vector<Request>& requests ) noexcept(!IS_DEBUG)
+	{
+		Plan plan;
+		plan.assignment.resize( requests.size() );
+
+		// interval partitioning - visit requests by first use and reuse any resource that is already free
+		std::vector<size_t> byFirstUse( requests.size() );
+		std::iota( byFirstUse.begin(), byFirstUse.end(), size_t( 0u ) );
+		std::stable_sort( byFirstUse.begin(), byFirstUse.end(), [&requests]( size_t lhs, size_t rhs )
+		{
+			return requests[lhs].firstUse < requests[rhs].firstUse;
+		} );
+
+		// last pass that uses each resource
+		std::vector<size_t> busyUntil;
+		for ( const auto r : byFirstUse )
+		{
+			const auto& request = requests[r];
+			assert( request.firstUse <= request.lastUse );
+			plan.bytesUnaliased += request.desc.GetSizeInBytes();
+
+			// a pass may read one transient while writing another, so sharing needs a strictly earlier last use
+			size_t chosen = plan.resources.size();
+			for ( size_t i = 0; i < plan.resources.size(); i++ )
+			{
+				if ( plan.resources[i] == request.desc && busyUntil[i] < request.firstUse )
+				{
+					chosen = i;
+					break;
+				}
+			}
+			if ( chosen == plan.resources.size() )
+			{
+				plan.resources.push_back( request.desc );
+				busyUntil.push_back( request.lastUse );
+				plan.bytesAliased += request.desc.GetSizeInBytes();
+			}
+			else
+			{
+				busyUntil[chosen] = request.lastUse;
+			}
+			plan.assignment[r] = chosen;
+		}
+		return plan;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+namespace Rgph
+{
+	// description of a graph owned target whose contents only matter between its first and last use
+	struct TransientDesc
+	{
+		enum class Type
+		{
+			RenderTarget,
+			DepthStencil
+		};
+		Type type;
+		unsigned int width;
+		unsigned int height;
+		// shader input slot of render targets
+		unsigned int slot = 0u;
+		size_t GetSizeInBytes() const noexcept
+		{
+			// both are created as 32-bit formats
+			return size_t( width ) * height * 4u;
+		}
+		bool operator==( const TransientDesc& ) const = default;
+	};
+
+	// assigns transient requests to as few physical resources as possible
+	// requests can share a resource when their descriptions match and their lifetimes do not overlap
+	class TransientPlanner
+	{
+	public:
+		struct Request
+		{
+			TransientDesc desc;
+			// positions in the pass execution order, inclusive
+			size_t firstUse;
+			size_t lastUse;
+		};
+		struct Plan
+		{
+			// physical resource index for every request
+			std::vector<size_t> assignment;
+			std::vector<TransientDesc> resources;
+			size_t bytesUnaliased = 0u;
+			size_t bytesAliased = 0u;
+		};
+	public:
+		static Plan Build( const std::vector<Request>& requests ) noexcept(!IS_DEBUG);
+	};
+}
\ No newline at end of file
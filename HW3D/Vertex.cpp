@@ -143,16 +143,16 @@ namespace VertexMeta
 	}
 	void VertexBuffer::Resize(size_t newSize) noexcept(!IS_DEBUG)
 	{
-		const auto size = Size();
-		if (size < newSize)
-		{
-			buffer.resize(buffer.size() + layout.Size() * (newSize - size));
-		}
+		buffer.resize(layout.Size() * newSize);
 	}
 	const char* VertexBuffer::GetData() const noexcept(!IS_DEBUG)
 	{
 		return buffer.data();
 	}
+	char* VertexBuffer::GetData() noexcept(!IS_DEBUG)
+	{
+		return buffer.data();
+	}
 
 	template<VertexLayout::ElementType type>
 	struct AttributeAiMeshFill
@@ -245,6 +245,7 @@ namespace VertexMeta
 		VertexBuffer(VertexLayout layout, size_t size = 0u) noexcept(!IS_DEBUG);
 		VertexBuffer(VertexLayout layout, const aiMesh& mesh);
 		const char* GetData() const noexcept(!IS_DEBUG);
+		char* GetData() noexcept(!IS_DEBUG);
 		const VertexLayout& GetLayout() const noexcept;
 		void Resize(size_t newSize) noexcept(!IS_DEBUG);
 		size_t Size() const noexcept(!IS_DEBUG);
@@ -7,12 +7,15 @@ namespace Bind
 		: VertexBuffer( gfx, "?", vbuf ) { }
 
 	VertexBuffer::VertexBuffer( Graphics& gfx, const std::string& tag, const VertexMeta::VertexBuffer& vbuf )
-		: stride( (UINT)vbuf.GetLayout().Size() ), tag( tag ), layout( vbuf.GetLayout() )
+		: VertexBuffer( gfx, tag, vbuf.GetLayout(), vbuf.GetData(), vbuf.SizeBytes() ) { }
+
+	VertexBuffer::VertexBuffer( Graphics& gfx, const std::string& tag, const VertexMeta::VertexLayout& layout, const void* pData, size_t sizeInBytes )
+		: stride( (UINT)layout.Size() ), sizeInBytes( (UINT)sizeInBytes ), tag( tag ), layout( layout )
 	{
 		INFOMANAGER(gfx);
 
 		D3D11_BUFFER_DESC bd = { 0 };
-		bd.ByteWidth = UINT(vbuf.SizeBytes());
+		bd.ByteWidth = sizeInBytes;
 		bd.Usage = D3D11_USAGE_DEFAULT;
 		bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 		bd.CPUAccessFlags = 0u;
@@ -20,7 +23,7 @@ namespace Bind
 		bd.StructureByteStride = stride;
 
 		D3D11_SUBRESOURCE_DATA sd = { 0 };
-		sd.pSysMem = vbuf.GetData();
+		sd.pSysMem = pData;
 
 		GFX_THROW_INFO(GetDevice(gfx)->CreateBuffer(&bd, &sd, &pVertexBuffer));
 	}
@@ -29,7 +32,7 @@ namespace Bind
 	{
 		const UINT offset = 0u;
 		INFOMANAGER( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->IASetVertexBuffers( 0u, 1u, pVertexBuffer.GetAddressOf(), &stride, &offset ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).IASetVertexBuffer( 0u, pVertexBuffer.Get(), stride, offset ) );
 	}
 
 	const VertexMeta::VertexLayout& VertexBuffer::GetLayout() const noexcept
@@ -43,14 +46,24 @@ namespace Bind
 		return Codex::Resolve<VertexBuffer>( gfx, tag, vbuf );
 	}
 
-	std::string VertexBuffer::GenerateUID_( const std::string& tag )
+	std::shared_ptr<VertexBuffer> VertexBuffer::Resolve( Graphics& gfx, const std::string& tag, const VertexMeta::VertexLayout& layout, const void* pData, size_t sizeInBytes )
+	{
+		assert( tag != "?" );
+		return Codex::Resolve<VertexBuffer>( gfx, tag, layout, pData, sizeInBytes );
+	}
+
+	BindKey VertexBuffer::GenerateKey_( const std::string& tag )
+	{
+		return BindKey::Make<VertexBuffer>( tag );
+	}
+
+	BindKey VertexBuffer::GetKey() const noexcept(!IS_DEBUG)
 	{
-		using namespace std::string_literals;
-		return typeid( VertexBuffer ).name() + "#"s + tag;
+		return GenerateKey( tag );
 	}
 
-	std::string VertexBuffer::GetUID() const noexcept
+	size_t VertexBuffer::GetSizeInBytes() const noexcept
 	{
-		return GenerateUID( tag );
+		return sizeInBytes;
 	}
 }
\ No newline at end of file
@@ -10,19 +10,24 @@ namespace Bind
 	public:
 		VertexBuffer( Graphics& gfx, const std::string& tag, const VertexMeta::VertexBuffer& vbuf );
 		VertexBuffer( Graphics& gfx, const VertexMeta::VertexBuffer& vbuf );
+		// from vertices already in the layout's format, for data that is not held in a vertex buffer
+		VertexBuffer( Graphics& gfx, const std::string& tag, const VertexMeta::VertexLayout& layout, const void* pData, size_t sizeInBytes );
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		const VertexMeta::VertexLayout& GetLayout() const noexcept;
 		static std::shared_ptr<VertexBuffer> Resolve( Graphics& gfx, const std::string& tag, const VertexMeta::VertexBuffer& vbuf );
+		static std::shared_ptr<VertexBuffer> Resolve( Graphics& gfx, const std::string& tag, const VertexMeta::VertexLayout& layout, const void* pData, size_t sizeInBytes );
 		template<typename...Ignore>
-		static std::string GenerateUID( const std::string& tag, Ignore&&...ignore )
+		static BindKey GenerateKey( const std::string& tag, Ignore&&...ignore )
 		{
-			return GenerateUID_( tag );
+			return GenerateKey_( tag );
 		}
-		std::string GetUID() const noexcept override;
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
+		size_t GetSizeInBytes() const noexcept override;
 	private:
-		static std::string GenerateUID_( const std::string& tag );
+		static BindKey GenerateKey_( const std::string& tag );
 	protected:
 		UINT stride;
+		UINT sizeInBytes;
 		std::string tag;
 		VertexMeta::VertexLayout layout;
 		Microsoft::WRL::ComPtr<ID3D11Buffer> pVertexBuffer;
@@ -2,7 +2,9 @@
 #include "BindableCodex.h"
 #include "StringConverter.h"
 #include "GraphicsThrowMacros.h"
+#include "FrameCapture.h"
 #include <typeinfo>
+#include <filesystem>
 #include <d3dcompiler.h>
 
 namespace Bind
@@ -18,12 +20,13 @@ namespace Bind
 			nullptr,
 			&pVertexShader
 		) );
+		FrameCapture::AttachCreationData( pVertexShader.Get(), pBytecodeBlob.Get() );
 	}
 
 	void VertexShader::Bind( Graphics& gfx ) noexcept(!IS_DEBUG)
 	{
 		INFOMANAGER( gfx );
-		GFX_THROW_INFO_ONLY( GetContext( gfx )->VSSetShader( pVertexShader.Get(), nullptr, 0u ) );
+		GFX_THROW_INFO_ONLY( GetStateCache( gfx ).VSSetShader( pVertexShader.Get() ) );
 	}
 
 	ID3DBlob* VertexShader::GetByteCode() const noexcept
@@ -31,19 +34,34 @@ namespace Bind
 		return pBytecodeBlob.Get();
 	}
 
+	std::shared_ptr<VertexShader> VertexShader::GetInstancedVariant( Graphics& gfx ) const
+	{
+		// queues recorded on different threads can ask for the same variant at once
+		std::call_once( instancedOnce, [this, &gfx]
+		{
+			const std::string suffix = "VS.cso";
+			if ( path.size() > suffix.size() && path.ends_with( suffix ) )
+			{
+				auto variantPath = path.substr( 0u, path.size() - suffix.size() ) + "InstancedVS.cso";
+				if ( std::filesystem::exists( variantPath ) )
+					pInstanced = Codex::Resolve<VertexShader>( gfx, variantPath );
+			}
+		} );
+		return pInstanced;
+	}
+
 	std::shared_ptr<VertexShader> VertexShader::Resolve( Graphics& gfx, const std::string& path )
 	{
 		return Codex::Resolve<VertexShader>( gfx, "res\\shaders\\cso\\" + path );
 	}
 
-	std::string VertexShader::GenerateUID( const std::string& path )
+	BindKey VertexShader::GenerateKey( const std::string& path )
 	{
-		using namespace std::string_literals;
-		return typeid( VertexShader ).name() + "#"s + path;
+		return BindKey::Make<VertexShader>( path );
 	}
 
-	std::string VertexShader::GetUID() const noexcept
+	BindKey VertexShader::GetKey() const noexcept(!IS_DEBUG)
 	{
-		return GenerateUID( path );
+		return GenerateKey( path );
 	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "Bindable.h"
+#include <mutex>
 
 namespace Bind
 {
@@ -9,12 +10,17 @@ namespace Bind
 		VertexShader( Graphics& gfx, const std::string& path );
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override;
 		ID3DBlob* GetByteCode() const noexcept;
+		// variant reading its transforms from an instance buffer - null unless <name>InstancedVS.cso was built
+		std::shared_ptr<VertexShader> GetInstancedVariant( Graphics& gfx ) const;
 		static std::shared_ptr<VertexShader> Resolve( Graphics& gfx, const std::string& path );
-		static std::string GenerateUID( const std::string& path );
-		std::string GetUID() const noexcept override;
+		static BindKey GenerateKey( const std::string& path );
+		BindKey GetKey() const noexcept(!IS_DEBUG) override;
 	protected:
 		std::string path;
 		Microsoft::WRL::ComPtr<ID3DBlob> pBytecodeBlob;
 		Microsoft::WRL::ComPtr<ID3D11VertexShader> pVertexShader;
+	private:
+		mutable std::once_flag instancedOnce;
+		mutable std::shared_ptr<VertexShader> pInstanced;
 	};
 }
\ No newline at end of file
@@ -18,21 +18,11 @@ namespace Rgph
 
 		AddBindSink<Bind::RenderTarget>( "scratchIn" );
 		AddBindSink<Bind::CachingPixelConstantBufferEx>( "kernel" );
-		RegisterSink( DirectBindableSink<Bind::CachingPixelConstantBufferEx>::Make( "direction", direction ) );
+		AddBindSink<Bind::CachingPixelConstantBufferEx>( "direction" );
 		RegisterSink( DirectBufferSink<Bind::RenderTarget>::Make( "renderTarget", renderTarget ) );
 		RegisterSink( DirectBufferSink<Bind::DepthStencil>::Make( "depthStencil", depthStencil ) );
 
 		RegisterSource( DirectBufferSource<Bind::RenderTarget>::Make( "renderTarget", renderTarget ) );
 		RegisterSource( DirectBufferSource<Bind::DepthStencil>::Make( "depthStencil", depthStencil ) );
 	}
-
-	void VerticalBlurPass::Execute( Graphics& gfx ) const noexcept(!IS_DEBUG)
-	{
-		auto buffer = direction->GetBuffer();
-		buffer["isHorizontal"] = false;
-		direction->SetBuffer( buffer );
-
-		direction->Bind( gfx );
-		FullscreenPass::Execute( gfx );
-	}
 }
\ No newline at end of file
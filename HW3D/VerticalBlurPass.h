@@ -16,8 +16,5 @@ namespace Rgph
 	{
 	public:
 		VerticalBlurPass( std::string name, Graphics& gfx );
-		void Execute( Graphics& gfx ) const noexcept(!IS_DEBUG) override;
-	private:
-		std::shared_ptr<Bind::CachingPixelConstantBufferEx> direction;
 	};
 }
\ No newline at end of file
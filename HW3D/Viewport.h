@@ -23,7 +23,7 @@ namespace Bind
 		void Bind( Graphics& gfx ) noexcept(!IS_DEBUG) override
 		{
 			INFOMANAGER_NOHR( gfx );
-			GFX_THROW_INFO_ONLY( GetContext( gfx )->RSSetViewports( 1u, &vp ) );
+			GFX_THROW_INFO_ONLY( GetStateCache( gfx ).RSSetViewport( vp ) );
 		}
 	private:
 		D3D11_VIEWPORT vp = {};
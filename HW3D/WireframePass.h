@@ -14,7 +14,7 @@ namespace Rgph
 	{
 	public:
 		WireframePass( Graphics& gfx, std::string name ) :
-			RenderQueuePass( std::move( name ) )
+			RenderQueuePass( std::move( name ), {}, SortPolicy::State )
 		{
 			RegisterSink( DirectBufferSink<Bind::RenderTarget>::Make( "renderTarget", renderTarget ) );
 			RegisterSink( DirectBufferSink<Bind::DepthStencil>::Make( "depthStencil", depthStencil ) );
@@ -0,0 +1,6 @@
+#include "../hlsli/InstanceTransform.hlsli"
+
+float4 main( float3 pos : Position, uint instance : SV_InstanceID ) : SV_Position
+{
+	return mul( float4( pos, 1.0f ), instanceTransforms[instance].modelViewProj );
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+struct InstanceTransform
+{
+    matrix model;
+    matrix modelView;
+    matrix modelViewProj;
+};
+
+// per-instance replacement for TransformCBuf, indexed with SV_InstanceID
+StructuredBuffer<InstanceTransform> instanceTransforms : register(t0);
\ No newline at end of file